@@ -0,0 +1,98 @@
+/**
+ * \file            main.c
+ * \brief           stm card simulator main src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "main.h"
+
+/**
+ * \brief  holds the simulated card resources
+ */
+sim_card_t my_card;
+
+/**
+ * \brief           stop the simulator on ctrl-c or kill
+ * \param[in]       signal_num: received signal
+ */
+static void
+sim_stop_handler(int signal_num) {
+
+    (void)signal_num;
+    sim_running = 0;
+}
+
+/**
+ * \brief           stm card simulator main function.
+ *                  answers the unit testing application on the card ports until interrupted
+ * \param[in]       argc: argument count
+ * \param[in]       argv: argument vector
+ * \param[out]      return: software error massage
+ */
+int
+main(int argc, char* argv[]) {
+
+    int check;                 /* return error check */
+    struct sigaction stop_act; /* shutdown signal action */
+
+    check = sim_parse_arguments(&my_card, argc, argv);
+    if (check != SIM_OK) {
+        return check;
+    }
+
+    memset(&stop_act, 0, sizeof(stop_act));
+    stop_act.sa_handler = sim_stop_handler;
+    sigaction(SIGINT, &stop_act, NULL);
+    sigaction(SIGTERM, &stop_act, NULL);
+
+    check = sim_card_start(&my_card);
+    if (check != SIM_OK) {
+
+        sim_running = 0;
+        sim_card_join(&my_card);
+        sim_card_free(&my_card);
+        return check;
+    }
+
+    printf("simulating card %s UID %" PRIu32 "  ::  %" PRIu32 "  ::  %" PRIu32 " on %s ports %u, %u-%u\n",
+           my_card.name_and_id.board_part_number, my_card.name_and_id.id[0], my_card.name_and_id.id[1],
+           my_card.name_and_id.id[2], my_card.setting.bind_addr, (unsigned int)my_card.setting.app_init_port,
+           (unsigned int)my_card.setting.server_offset_port,
+           (unsigned int)(my_card.setting.server_offset_port + my_card.task_num - 1));
+
+    sim_card_join(&my_card);
+
+    sim_card_print_statistics(&my_card);
+
+    sim_card_free(&my_card);
+
+    printf("simulator end\n");
+
+    return SIM_OK;
+}
@@ -0,0 +1,1124 @@
+/**
+ * \file            simulator.c
+ * \brief           stm card simulator src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "simulator.h"
+
+/**
+ * \brief           simulated test list, the same list the nucleo-f746zg card sends to the testing app.
+ * \note            like on the card, the last test of each task begins with '#'
+ */
+const linux_app_test_setting_t sim_test_list_array[] = {
+
+    {.test_name = " uart1 TI rx uart2 TI tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#uart2 TI rx uart1 TI tx ",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+
+    {.test_name = " uart4 TI rx uart5 TI tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " uart5 TI rx uart4 TI tx ",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " uart4 DMA rx uart5 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " uart5 DMA rx uart4 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#uart5 DMA circular rx uart4 DMA circular tx stream",
+     .results_evaluation_criteria = STREAM_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 256},
+
+    {.test_name = " i2c1 TI rx i2c2 TI rx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " i2c2 TI rx i2c1 TI rx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " i2c1 DMA rx i2c2 TI rx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#i2c1 DMA rx i2c2 IT tx stream",
+     .results_evaluation_criteria = STREAM_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 256},
+
+    {.test_name = " spi1 TI rx spi2 TI tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi2 TI rx spi1 TI tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi1 DMA rx spi2 TI tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi2 DMA rx spi1 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi2 IT rx/tx spi1 it rx/tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#spi1 DMA circular rx spi2 IT tx stream",
+     .results_evaluation_criteria = STREAM_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 1400},
+
+    {.test_name = " dec1 to adc1 ",
+     .results_evaluation_criteria = ADC_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 64},
+    {.test_name = " dec1 to adc2 ",
+     .results_evaluation_criteria = ADC_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 64},
+    {.test_name = " dec1 to adc3 ",
+     .results_evaluation_criteria = ADC_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 64},
+    {.test_name = "#dac1 sweep adc1 adc2 adc3",
+     .results_evaluation_criteria = LINEARITY_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 776},
+
+    {.test_name = "#flash ",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 100},
+
+    {.test_name = " can1 rx can2 tx",
+     .results_evaluation_criteria = BUS_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 256},
+    {.test_name = "#can2 rx can1 tx",
+     .results_evaluation_criteria = BUS_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 256},
+
+    {.test_name = " uart7 IT rx uart8 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " uart8 IT rx uart7 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#uart8 DMA rx uart7 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+
+    {.test_name = " usart3 IT rx usart6 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " usart6 IT rx usart3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " usart3 IT rx usart6 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#usart6 DMA rx usart3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+
+    {.test_name = " spi4 IT rx spi3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi3 IT rx spi4 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi4 DMA rx spi3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi3 IT rx spi4 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi4 DMA rx spi5 poll tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi5 poll rx spi4 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#spi4 DMA circular rx spi3 IT tx stream",
+     .results_evaluation_criteria = STREAM_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 1400},
+
+    {.test_name = " i2c3 IT rx i2c4 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " i2c4 IT rx i2c3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#i2c3 DMA rx i2c4 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+
+};
+
+/**
+ * \brief           Holds number of simulated tests
+ */
+const uint16_t sim_test_list_size = sizeof(sim_test_list_array) / sizeof(linux_app_test_setting_t);
+
+/**
+ * \brief           cleared by the signal handler to stop all simulator threads
+ */
+volatile sig_atomic_t sim_running = 1;
+
+/**
+ * \brief           initialise simulator setting to the values of the real card
+ * \param[in]       setting: setting to initialise
+ */
+void
+sim_setting_init(sim_setting_t* setting) {
+
+    memset(setting, 0, sizeof(*setting));
+    strcpy(setting->bind_addr, "0.0.0.0");
+    setting->app_init_port = APP_INIT_PORT;
+    setting->server_offset_port = SERVER_OFFSET_PORT;
+    setting->latency_us = SIM_DEFAULT_LATENCY_US;
+    setting->seed = (unsigned int)time(NULL);
+    strcpy(setting->firmware_build, "simulator");
+}
+
+/**
+ * \brief           print command line usage
+ * \param[in]       name: program name
+ */
+static void
+sim_print_usage(const char* name) {
+
+    printf("usage: %s [options]\n", name);
+    printf("  -a addr      local address to answer on (default 0.0.0.0)\n");
+    printf("  -p port      app init port (default %u)\n", (unsigned int)APP_INIT_PORT);
+    printf("  -o port      first testing task port (default %u)\n", (unsigned int)SERVER_OFFSET_PORT);
+    printf("  -n name      card part number (default nucleo-f746zg)\n");
+    printf("  -u a:b:c     card uniq id words\n");
+    printf("  -l us        simulated peripheral latency (default %u)\n", (unsigned int)SIM_DEFAULT_LATENCY_US);
+    printf("  -j us        latency jitter, uniform +- us (default 0)\n");
+    printf("  -H rate      HAL_RETURN_ERROR per %u requests\n", (unsigned int)SIM_RATE_SCALE);
+    printf("  -I rate      ERROR_IT per %u requests\n", (unsigned int)SIM_RATE_SCALE);
+    printf("  -O rate      OVER_TIME per %u requests\n", (unsigned int)SIM_RATE_SCALE);
+    printf("  -L rate      requests lost without a reply per %u requests, init requests included\n",
+           (unsigned int)SIM_RATE_SCALE);
+    printf("  -B rate      replies with one random bit flipped per %u requests\n", (unsigned int)SIM_RATE_SCALE);
+    printf("  -D rate      replies shifted one bit early per %u requests\n", (unsigned int)SIM_RATE_SCALE);
+    printf("  -K mask      bit positions stuck low in every byte of every reply (default 0)\n");
+    printf("  -G o:g:n[:i] adc offset in LSB, gain error in ppm, noise +- LSB and integral non linearity in LSB\n");
+    printf("               at mid scale of the dac to adc tests\n");
+    printf("  -s seed      random seed for jitter and error injection\n");
+    printf("  -F build     firmware build sent in the hello reply (default simulator)\n");
+}
+
+/**
+ * \brief           parse a number command line argument
+ * \param[in]       text: argument text
+ * \param[in]       max: biggest value allowed
+ * \param[out]      value_out: parsed value
+ * \param[out]      return: SIM_OK or SIM_BAD_ARGUMENT
+ */
+static uint8_t
+sim_parse_number(const char* text, unsigned long max, unsigned long* value_out) {
+
+    char* end; /* end of parsed number */
+
+    errno = 0;
+    *value_out = strtoul(text, &end, 0);
+    if (errno != 0 || end == text || *end != '\0' || *value_out > max) {
+
+        return SIM_BAD_ARGUMENT;
+    }
+
+    return SIM_OK;
+}
+
+/**
+ * \brief           fill simulated card setting, part number and id from the command line
+ * \param[in]       card: simulated card to configure
+ * \param[in]       argc: argument count
+ * \param[in]       argv: argument vector
+ * \param[out]      return: SIM_OK or SIM_BAD_ARGUMENT
+ */
+uint8_t
+sim_parse_arguments(sim_card_t* card, int argc, char* argv[]) {
+
+    int option;          /* current command line option */
+    unsigned long value; /* parsed number argument */
+    uint8_t check;       /* return error check */
+
+    sim_setting_init(&card->setting);
+    memset(&card->name_and_id, 0, sizeof(card->name_and_id));
+    strcpy((char*)card->name_and_id.board_part_number, "nucleo-f746zg");
+    card->name_and_id.id[0] = 0x00410026;
+    card->name_and_id.id[1] = 0x56463506;
+    card->name_and_id.id[2] = 0x20363532;
+
+    while ((option = getopt(argc, argv, "a:p:o:n:u:l:j:H:I:O:L:B:D:K:G:s:F:h")) != -1) {
+
+        check = SIM_OK;
+
+        switch (option) {
+
+            case 'a':
+                if (strlen(optarg) >= sizeof(card->setting.bind_addr)) {
+                    check = SIM_BAD_ARGUMENT;
+                    break;
+                }
+                strcpy(card->setting.bind_addr, optarg);
+                break;
+
+            case 'p':
+                check = sim_parse_number(optarg, UINT16_MAX, &value);
+                card->setting.app_init_port = (uint16_t)value;
+                break;
+
+            case 'o':
+                check = sim_parse_number(optarg, UINT16_MAX, &value);
+                card->setting.server_offset_port = (uint16_t)value;
+                break;
+
+            case 'n':
+                if (strlen(optarg) >= sizeof(card->name_and_id.board_part_number)) {
+                    check = SIM_BAD_ARGUMENT;
+                    break;
+                }
+                strcpy((char*)card->name_and_id.board_part_number, optarg);
+                break;
+
+            case 'F':
+                if (strlen(optarg) >= sizeof(card->setting.firmware_build)) {
+                    check = SIM_BAD_ARGUMENT;
+                    break;
+                }
+                strcpy(card->setting.firmware_build, optarg);
+                break;
+
+            case 'u':
+                if (sscanf(optarg, "%" SCNu32 ":%" SCNu32 ":%" SCNu32, &card->name_and_id.id[0],
+                           &card->name_and_id.id[1], &card->name_and_id.id[2])
+                    != ID_SIZE) {
+                    check = SIM_BAD_ARGUMENT;
+                }
+                break;
+
+            case 'l':
+                check = sim_parse_number(optarg, UINT32_MAX, &value);
+                card->setting.latency_us = (uint32_t)value;
+                break;
+
+            case 'j':
+                check = sim_parse_number(optarg, UINT32_MAX, &value);
+                card->setting.jitter_us = (uint32_t)value;
+                break;
+
+            case 'H':
+                check = sim_parse_number(optarg, SIM_RATE_SCALE, &value);
+                card->setting.hal_error_rate = (uint16_t)value;
+                break;
+
+            case 'I':
+                check = sim_parse_number(optarg, SIM_RATE_SCALE, &value);
+                card->setting.it_error_rate = (uint16_t)value;
+                break;
+
+            case 'O':
+                check = sim_parse_number(optarg, SIM_RATE_SCALE, &value);
+                card->setting.over_time_rate = (uint16_t)value;
+                break;
+
+            case 'L':
+                check = sim_parse_number(optarg, SIM_RATE_SCALE, &value);
+                card->setting.loss_rate = (uint16_t)value;
+                break;
+
+            case 'B':
+                check = sim_parse_number(optarg, SIM_RATE_SCALE, &value);
+                card->setting.bit_flip_rate = (uint16_t)value;
+                break;
+
+            case 'D':
+                check = sim_parse_number(optarg, SIM_RATE_SCALE, &value);
+                card->setting.bit_shift_rate = (uint16_t)value;
+                break;
+
+            case 'K':
+                check = sim_parse_number(optarg, UINT8_MAX, &value);
+                card->setting.stuck_low = (uint8_t)value;
+                break;
+
+            case 'G':
+                check = sscanf(optarg, "%" SCNd16 ":%" SCNd32 ":%" SCNu16 ":%" SCNd16, &card->setting.adc_offset,
+                               &card->setting.adc_gain_ppm, &card->setting.adc_noise, &card->setting.adc_inl);
+                if (check == 3 || check == 4) {
+                    check = SIM_OK;
+                } else {
+                    check = SIM_BAD_ARGUMENT;
+                }
+                break;
+
+            case 's':
+                check = sim_parse_number(optarg, UINT_MAX, &value);
+                card->setting.seed = (unsigned int)value;
+                break;
+
+            default: check = SIM_BAD_ARGUMENT; break;
+        }
+
+        if (check != SIM_OK) {
+
+            sim_print_usage(argv[0]);
+            return SIM_BAD_ARGUMENT;
+        }
+    }
+
+    if ((uint32_t)card->setting.hal_error_rate + card->setting.it_error_rate + card->setting.over_time_rate
+        > SIM_RATE_SCALE) {
+
+        sim_print_usage(argv[0]);
+        return SIM_BAD_ARGUMENT;
+    }
+
+    return SIM_OK;
+}
+
+/**
+ * \brief           create a udp socket bound to the simulated card address and a port
+ * \param[in]       setting: simulated card setting, holding the bind address
+ * \param[in]       port: port to bind
+ * \param[out]      return: socket fd or -1 on error
+ */
+static int
+sim_open_socket(const sim_setting_t* setting, uint16_t port) {
+
+    int sockfd;              /* new socket */
+    struct sockaddr_in addr; /* address to bind */
+    struct timeval timeout;  /* receive timeout, so threads notice shutdown */
+
+    sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sockfd == -1) {
+
+        return -1;
+    }
+
+    memset(&addr, '\0', sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr(setting->bind_addr);
+
+    timeout.tv_sec = 0;
+    timeout.tv_usec = SIM_POLL_INTERVAL_US;
+
+    if (setsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == -1
+        || bind(sockfd, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+
+        close(sockfd);
+        return -1;
+    }
+
+    return sockfd;
+}
+
+/**
+ * \brief           simulated "app_data_init_task". answers hello, card id, test list size, test list member
+ *                  and test list chunk requests
+ * \param[in]       arg: "sim_card_t" struct pointer
+ * \param[out]      return: NULL
+ */
+static void*
+sim_app_data_init_thread(void* arg) {
+
+    sim_card_t* card = (sim_card_t*)arg; /* for casting arg to sim_card_t pointer */
+    app_data_init_commend_t commend;     /* received commend */
+    struct sockaddr_in sender;           /* app address */
+    socklen_t sender_size;               /* app address size */
+    ssize_t check;                       /* return error check */
+    list_bulk_reply_t bulk_reply;        /* test list chunk sent on LIST_BULK_REQUEST */
+    card_hello_t hello;                  /* card information and capabilities sent on HELLO_REQUEST */
+
+    while (sim_running) {
+
+        sender_size = sizeof(sender);
+        memset(&commend, 0, sizeof(commend));
+        check = recvfrom(card->init_sockfd, &commend, sizeof(commend), 0, (struct sockaddr*)&sender, &sender_size);
+        if (check == -1) {
+            continue;
+        }
+
+        /* simulate a lost request or reply */
+        if ((uint32_t)rand_r(&card->init_rand_state) % SIM_RATE_SCALE < card->setting.loss_rate) {
+            continue;
+        }
+
+        /* if the sender asking for card name and uniq id */
+        if (commend.type == ID_REQUEST) {
+
+            sendto(card->init_sockfd, &card->name_and_id, sizeof(card->name_and_id), 0, (struct sockaddr*)&sender,
+                   sender_size);
+            continue;
+        }
+
+        /* if the sender asking for card name, uniq id, list sizes and capabilities in one reply */
+        if (commend.type == HELLO_REQUEST) {
+
+            memset(&hello, 0, sizeof(hello));
+            hello.card = card->name_and_id;
+            hello.protocol_version = PROTOCOL_VERSION;
+            hello.pc_test_list_size = sim_test_list_size;
+            hello.test_list_size = card->task_num;
+            hello.min_payload_size = MIN_BUF_LEN;
+            hello.max_payload_size = MAX_BUF_LEN;
+            hello.request_queue_size = SIM_REQUEST_QUEUE_SIZE;
+            hello.features = FEATURE_LIST_BULK | FEATURE_SEQUENCE | FEATURE_REQUEST_QUEUE | FEATURE_CYCLE_COUNT;
+            hello.cycle_clock_hz = SIM_CYCLE_CLOCK_HZ;
+            memcpy(hello.firmware_build, card->setting.firmware_build, sizeof(hello.firmware_build));
+
+            sendto(card->init_sockfd, &hello, sizeof(hello), 0, (struct sockaddr*)&sender, sender_size);
+            continue;
+        }
+
+        /* check if the id sent matches the card id */
+        if (memcmp(commend.id, card->name_and_id.id, sizeof(commend.id)) != 0) {
+            continue;
+        }
+
+        switch (commend.type) {
+
+            case LIST_SIZE_REQUEST:
+
+                sendto(card->init_sockfd, &sim_test_list_size, sizeof(sim_test_list_size), 0,
+                       (struct sockaddr*)&sender, sender_size);
+                break;
+
+            case LIST_MEMBER_REQUEST:
+
+                if (commend.list_index < sim_test_list_size) {
+
+                    sendto(card->init_sockfd, &sim_test_list_array[commend.list_index],
+                           sizeof(linux_app_test_setting_t), 0, (struct sockaddr*)&sender, sender_size);
+                }
+                break;
+
+            case LIST_BULK_REQUEST:
+
+                bulk_reply.first_index = commend.list_index;
+                bulk_reply.member_num = 0;
+
+                while (bulk_reply.member_num < LIST_BULK_MAX_MEMBERS
+                       && commend.list_index + bulk_reply.member_num < sim_test_list_size) {
+
+                    bulk_reply.member_list[bulk_reply.member_num] =
+                        sim_test_list_array[commend.list_index + bulk_reply.member_num];
+                    bulk_reply.member_num++;
+                }
+
+                sendto(card->init_sockfd, &bulk_reply,
+                       offsetof(list_bulk_reply_t, member_list)
+                           + bulk_reply.member_num * sizeof(linux_app_test_setting_t),
+                       0, (struct sockaddr*)&sender, sender_size);
+                break;
+
+            default: break;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief           pick the error the simulated peripheral reports on this request
+ * \param[in]       task: simulated task, holding rand state and error rates
+ * \param[out]      return: error_report_t value
+ */
+static uint8_t
+sim_pick_error(sim_task_t* task) {
+
+    uint32_t draw = (uint32_t)rand_r(&task->rand_state) % SIM_RATE_SCALE; /* random draw in rate scale */
+
+    if (draw < task->setting->hal_error_rate) {
+        return HAL_RETURN_ERROR;
+    }
+    draw -= task->setting->hal_error_rate;
+
+    if (draw < task->setting->it_error_rate) {
+        return ERROR_IT;
+    }
+    draw -= task->setting->it_error_rate;
+
+    if (draw < task->setting->over_time_rate) {
+        return OVER_TIME;
+    }
+
+    return NO_ERROR;
+}
+
+/**
+ * \brief           corrupt the test data sent back like a bad data line would
+ * \param[in]       task: simulated task, holding rand state and corruption rates
+ * \param[in]       data: test data to corrupt
+ * \param[in]       size: size of the test data
+ */
+static void
+sim_corrupt_data(sim_task_t* task, uint8_t* data, uint16_t size) {
+
+    uint32_t bit; /* bit flipped */
+
+    if ((uint32_t)rand_r(&task->rand_state) % SIM_RATE_SCALE < task->setting->bit_shift_rate) {
+
+        for (uint16_t i = 0; i + 1 < size; i++) {
+            data[i] = (uint8_t)((data[i] << 1) | (data[i + 1] >> 7));
+        }
+        data[size - 1] = (uint8_t)(data[size - 1] << 1);
+    }
+
+    if ((uint32_t)rand_r(&task->rand_state) % SIM_RATE_SCALE < task->setting->bit_flip_rate) {
+
+        bit = (uint32_t)rand_r(&task->rand_state) % ((uint32_t)size * 8);
+        data[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+    }
+
+    if (task->setting->stuck_low != 0) {
+
+        for (uint16_t i = 0; i < size; i++) {
+            data[i] &= (uint8_t)~task->setting->stuck_low;
+        }
+    }
+}
+
+/**
+ * \brief           convert a dac code like the card dac and adc, with their errors
+ * \param[in]       task: simulated task, holding rand state and adc errors
+ * \param[in]       dac_code: dac code
+ * \param[out]      return: adc code
+ */
+static uint16_t
+sim_adc_code(sim_task_t* task, uint16_t dac_code) {
+
+    int64_t code = dac_code; /* adc code */
+
+    code = code + task->setting->adc_offset + code * task->setting->adc_gain_ppm / 1000000
+           + (int64_t)task->setting->adc_inl * 4 * dac_code * (ADC_CODE_MAX - dac_code) / (ADC_CODE_MAX * ADC_CODE_MAX);
+    if (task->setting->adc_noise > 0) {
+        code += (int64_t)((uint32_t)rand_r(&task->rand_state) % (2 * (uint32_t)task->setting->adc_noise + 1))
+                - task->setting->adc_noise;
+    }
+
+    return (uint16_t)(code < 0 ? 0 : (code > ADC_CODE_MAX ? ADC_CODE_MAX : code));
+}
+
+/**
+ * \brief           convert the dac codes of the test data like the card dac and adc, with their errors
+ * \param[in]       task: simulated task, holding rand state and adc errors
+ * \param[in]       data: ADC_SAMPLE_SIZE bytes little endian dac codes, replaced by the adc codes
+ * \param[in]       size: size of the test data
+ */
+static void
+sim_convert_adc(sim_task_t* task, uint8_t* data, uint16_t size) {
+
+    uint16_t code; /* dac code of the sample, then the adc code */
+
+    for (uint16_t offset = 0; offset + ADC_SAMPLE_SIZE <= size; offset += ADC_SAMPLE_SIZE) {
+
+        code = (uint16_t)(data[offset] | (data[offset + 1] << 8)) & ADC_CODE_MAX;
+        code = sim_adc_code(task, code);
+
+        data[offset] = (uint8_t)code;
+        data[offset + 1] = (uint8_t)(code >> 8);
+    }
+}
+
+/**
+ * \brief           run a chunk of a linearity sweep like the card, sum the adc codes of each adc at each dac code
+ * \param[in]       task: simulated task, holding rand state and adc errors
+ * \param[in]       data: a sweep_request_t, followed by room for the uint16_t sums, code after code and adc after adc
+ * \param[in]       size: size of the test data
+ * \param[out]      return: NO_ERROR, or HAL_RETURN_ERROR for a request the card can not run
+ */
+static uint8_t
+sim_sweep(sim_task_t* task, uint8_t* data, uint16_t size) {
+
+    sweep_request_t request; /* chunk of the sweep to run */
+    uint16_t sum;            /* sum of the adc codes of one adc at one dac code */
+    uint8_t* sum_ptr;        /* place of the next sum in the test data */
+
+    if (size < sizeof(request)) {
+        return HAL_RETURN_ERROR;
+    }
+    memcpy(&request, data, sizeof(request));
+
+    if (request.average == 0 || request.average > SWEEP_MAX_AVERAGE || request.step == 0
+        || request.adc_num != SIM_SWEEP_ADC_NUM
+        || sizeof(request) + (uint32_t)request.code_num * request.adc_num * sizeof(sum) > size
+        || (request.code_num > 0
+            && request.first_code + (uint32_t)(request.code_num - 1) * request.step > ADC_CODE_MAX)) {
+        return HAL_RETURN_ERROR;
+    }
+
+    sum_ptr = &data[sizeof(request)];
+
+    for (uint16_t code_index = 0; code_index < request.code_num; code_index++) {
+
+        for (uint8_t adc = 0; adc < SIM_SWEEP_ADC_NUM; adc++) {
+
+            sum = 0;
+            for (uint8_t sample = 0; sample < request.average; sample++) {
+                sum += sim_adc_code(task, (uint16_t)(request.first_code + code_index * request.step));
+            }
+
+            sum_ptr[0] = (uint8_t)sum;
+            sum_ptr[1] = (uint8_t)(sum >> 8);
+            sum_ptr += sizeof(sum);
+        }
+    }
+
+    return NO_ERROR;
+}
+
+/**
+ * \brief           simulate the bus statistics of the can frames moving the test data of a BUS_CRITERIA test
+ * \note            the frames go one after the other, each waits in a mailbox for the frames queued before it.
+ *                  the stuff bits are random, up to one every 5 bits of the part of the frame that is stuffed
+ * \param[in]       task: simulated task, holding rand state
+ * \param[out]      bus: bus statistics of the test
+ * \param[in]       size: size of the test data
+ * \param[in]       latency: simulated peripheral time in us, the bus time of a slower test
+ */
+static void
+sim_bus(sim_task_t* task, bus_stats_t* bus, uint16_t size, uint32_t latency) {
+
+    uint32_t frame_bits[SIM_BUS_MAILBOXES] = {0}; /* bits of the last frames, in the mailboxes together */
+    uint32_t frame_latency;                       /* bit times from queuing a frame to receiving it */
+    uint32_t stuffed;                             /* bits of a frame that are stuffed */
+    uint16_t frame_size;                          /* test data bytes of a frame */
+
+    memset(bus, 0, sizeof(*bus));
+    bus->bitrate = SIM_BUS_BITRATE;
+
+    for (uint16_t offset = 0; offset < size; offset += frame_size) {
+
+        frame_size = size - offset < SIM_BUS_FRAME_DATA ? size - offset : SIM_BUS_FRAME_DATA;
+        stuffed = SIM_BUS_STUFFED_BITS + frame_size * 8;
+
+        frame_bits[bus->frames % SIM_BUS_MAILBOXES] =
+            SIM_BUS_FRAME_BITS + frame_size * 8 + (uint32_t)rand_r(&task->rand_state) % (stuffed / 5 + 1);
+        bus->bus_bits += frame_bits[bus->frames % SIM_BUS_MAILBOXES];
+        bus->frames++;
+
+        frame_latency = 0;
+        for (uint8_t i = 0; i < SIM_BUS_MAILBOXES; i++) {
+            frame_latency += frame_bits[i];
+        }
+        frame_latency *= SIM_CYCLE_CLOCK_HZ / SIM_BUS_BITRATE;
+        bus->latency_sum += frame_latency;
+        if (frame_latency > bus->latency_max) {
+            bus->latency_max = frame_latency;
+        }
+    }
+
+    bus->bus_time = (uint32_t)((uint64_t)latency * SIM_BUS_BITRATE / 1000000);
+    if (bus->bus_time < bus->bus_bits) {
+        bus->bus_time = bus->bus_bits;
+    }
+}
+
+/**
+ * \brief           simulate the stream statistics of a STREAM_CRITERIA test, the card checking the data it streams
+ * \note            the stream runs SIM_STREAM_MS at SIM_STREAM_BYTES_PER_SEC. it is checked in blocks of half a
+ *                  transfer, a transfer is half the test data. each block takes a bit flip at the bit flip rate
+ * \param[in]       task: simulated task, holding rand state and corruption rates
+ * \param[out]      stream: stream statistics of the test
+ * \param[in]       size: size of the test data
+ * \param[out]      return: error_report_t, MISMATCH if a block took a bit flip
+ */
+static uint8_t
+sim_stream(sim_task_t* task, stream_stats_t* stream, uint16_t size) {
+
+    uint32_t block = size / 4 > 0 ? size / 4 : 1; /* bytes of a block checked */
+    uint32_t bytes;                               /* bytes streamed */
+
+    memset(stream, 0, sizeof(*stream));
+    bytes = (uint32_t)((uint64_t)SIM_STREAM_BYTES_PER_SEC * SIM_STREAM_MS / 1000);
+    stream->stream_cycles = (uint32_t)((uint64_t)SIM_CYCLE_CLOCK_HZ * SIM_STREAM_MS / 1000);
+
+    for (; stream->bytes + block <= bytes; stream->bytes += block) {
+
+        if ((uint32_t)rand_r(&task->rand_state) % SIM_RATE_SCALE < task->setting->bit_flip_rate) {
+            stream->bit_errors++;
+            stream->error_blocks++;
+        }
+    }
+
+    return stream->bit_errors != 0 ? MISMATCH : NO_ERROR;
+}
+
+/**
+ * \brief           compute simulated peripheral time of one request
+ * \param[in]       task: simulated task, holding rand state latency and jitter
+ * \param[out]      return: latency in us
+ */
+static uint32_t
+sim_pick_latency(sim_task_t* task) {
+
+    int64_t latency = task->setting->latency_us; /* latency with jitter applied */
+
+    if (task->setting->jitter_us > 0) {
+
+        latency += (int64_t)((uint32_t)rand_r(&task->rand_state) % (2 * (uint64_t)task->setting->jitter_us + 1))
+                   - task->setting->jitter_us;
+    }
+
+    return latency < 0 ? 0 : (uint32_t)latency;
+}
+
+/**
+ * \brief           sleep for a number of micro seconds, resuming after signals
+ * \param[in]       us: time to sleep
+ */
+static void
+sim_sleep_us(uint32_t us) {
+
+    struct timespec remaining; /* time left to sleep */
+
+    remaining.tv_sec = us / 1000000;
+    remaining.tv_nsec = (long)(us % 1000000) * 1000;
+
+    while (nanosleep(&remaining, &remaining) == -1 && errno == EINTR && sim_running) {}
+}
+
+/**
+ * \brief           stub of the card DWT cycle counter, counting SIM_CYCLE_CLOCK_HZ cycles a second and wrapping
+ * \param[out]      return: cycle counter value
+ */
+static uint32_t
+sim_cycle_counter(void) {
+
+    struct timespec now; /* current time */
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec) * (SIM_CYCLE_CLOCK_HZ / 1000000)
+                      / 1000);
+}
+
+/**
+ * \brief           simulated "testing_thread". one for each testing task port, echoing the test data
+ *                  back after the simulated peripheral time, with the injected error report
+ * \param[in]       arg: "sim_task_t" struct pointer
+ * \param[out]      return: NULL
+ */
+static void*
+sim_testing_thread(void* arg) {
+
+    sim_task_t* task = (sim_task_t*)arg; /* for casting arg to sim_task_t pointer */
+    unit_tasting_package_t pocket;       /* received test request, sent back after the test */
+    struct sockaddr_in sender;           /* app address */
+    socklen_t sender_size;               /* app address size */
+    ssize_t check;                       /* return error check */
+    uint32_t latency;                    /* simulated peripheral time */
+    uint32_t start_cycles;               /* cycle counter at the start of the simulated test */
+    uint32_t bus_us;                     /* time the frames of a bus test took on the bus */
+    uint8_t criteria;                    /* evaluation criteria of the test requested */
+
+    while (sim_running) {
+
+        sender_size = sizeof(sender);
+        check = recvfrom(task->sockfd, &pocket, sizeof(pocket), 0, (struct sockaddr*)&sender, &sender_size);
+        if (check == -1) {
+            continue;
+        }
+
+        /* like udp_receive_callback on the card, drop pockets not meant for this card or of wrong size */
+        if (check < (ssize_t)TEST_PACKAGE_HEADER_SIZE || pocket.data_len < MIN_BUF_LEN
+            || check != (ssize_t)(TEST_PACKAGE_HEADER_SIZE + pocket.data_len)
+            || memcmp(pocket.id, task->card_id, sizeof(pocket.id)) != 0) {
+
+            task->dropped++;
+            continue;
+        }
+
+        /* simulate a lost request or reply */
+        if ((uint32_t)rand_r(&task->rand_state) % SIM_RATE_SCALE < task->setting->loss_rate) {
+
+            task->lost++;
+            continue;
+        }
+
+        /* time the simulated test like testing_thread does, with the phases a uart test marks */
+        memset(pocket.phase_cycles, 0, sizeof(pocket.phase_cycles));
+        memset(&pocket.bus, 0, sizeof(pocket.bus));
+        memset(&pocket.stream, 0, sizeof(pocket.stream));
+        start_cycles = sim_cycle_counter();
+
+        pocket.error_report = sim_pick_error(task);
+        latency = sim_pick_latency(task);
+
+        /* the card waits for the peripheral until TIME_ELAPSED_ERROR before reporting over time */
+        if (pocket.error_report == OVER_TIME) {
+            latency = SIM_OVER_TIME_DELAY_US;
+        }
+
+        pocket.phase_cycles[TEST_PHASE_TX_START] = sim_cycle_counter() - start_cycles;
+        sim_sleep_us(latency);
+
+        if (pocket.error_report == NO_ERROR) {
+
+            criteria = task->first_test + pocket.request < sim_test_list_size
+                           ? sim_test_list_array[task->first_test + pocket.request].results_evaluation_criteria
+                           : COMMUNICATION_CRITERIA;
+
+            if (criteria == ADC_CRITERIA) {
+                sim_convert_adc(task, pocket.data, pocket.data_len);
+            } else if (criteria == LINEARITY_CRITERIA) {
+                pocket.error_report = sim_sweep(task, pocket.data, pocket.data_len);
+            } else if (criteria == STREAM_CRITERIA) {
+
+                /* the card checks the stream, it sends back the test data it streamed */
+                pocket.error_report = sim_stream(task, &pocket.stream, pocket.data_len);
+                if (SIM_STREAM_MS * 1000 > latency) {
+                    sim_sleep_us(SIM_STREAM_MS * 1000 - latency);
+                }
+            } else {
+                sim_corrupt_data(task, pocket.data, pocket.data_len);
+            }
+
+            /* the frames of a bus test take their bits on the bus, also when the peripheral time is shorter */
+            if (criteria == BUS_CRITERIA) {
+
+                sim_bus(task, &pocket.bus, pocket.data_len, latency);
+                bus_us = (uint32_t)((uint64_t)pocket.bus.bus_time * 1000000 / SIM_BUS_BITRATE);
+                if (bus_us > latency) {
+                    sim_sleep_us(bus_us - latency);
+                }
+            }
+            pocket.phase_cycles[TEST_PHASE_RX_DONE] = sim_cycle_counter() - start_cycles;
+            pocket.phase_cycles[TEST_PHASE_TASK_WAKE] = sim_cycle_counter() - start_cycles;
+        }
+        pocket.test_cycles = sim_cycle_counter() - start_cycles;
+
+        sendto(task->sockfd, &pocket, TEST_PACKAGE_HEADER_SIZE + pocket.data_len, 0, (struct sockaddr*)&sender,
+               sender_size);
+        task->served++;
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief           count simulated tasks, one for each test name beginning with '#'
+ * \param[out]      return: number of tasks
+ */
+static uint16_t
+sim_count_tasks(void) {
+
+    uint16_t task_num = 0; /* number of tasks */
+
+    for (uint16_t i = 0; i < sim_test_list_size; i++) {
+
+        if (sim_test_list_array[i].test_name[0] == '#') {
+            task_num++;
+        }
+    }
+
+    return task_num;
+}
+
+/**
+ * \brief           open the simulated card sockets and start the init and testing threads
+ * \param[in]       card: simulated card, with setting filled
+ * \param[out]      return: sim_error_report_t value
+ */
+uint8_t
+sim_card_start(sim_card_t* card) {
+
+    int check; /* return error check */
+
+    card->init_sockfd = -1;
+    card->init_started = 0;
+    card->thread_num = 0;
+    card->init_rand_state = card->setting.seed;
+    card->task_num = sim_count_tasks();
+    card->task_list = (sim_task_t*)calloc(card->task_num, sizeof(sim_task_t));
+    if (card->task_list == NULL) {
+
+        return SIM_MALLOC_FAILED;
+    }
+
+    for (uint16_t i = 0, test = 0; i < card->task_num; i++) {
+
+        card->task_list[i].sockfd = -1;
+
+        /* the tests of a task end with the test name beginning with '#' */
+        card->task_list[i].first_test = test;
+        while (sim_test_list_array[test].test_name[0] != '#') {
+            test++;
+        }
+        test++;
+    }
+
+    card->init_sockfd = sim_open_socket(&card->setting, card->setting.app_init_port);
+    if (card->init_sockfd == -1) {
+
+        perror("app init socket");
+        return SIM_SOCKET_FAILED;
+    }
+
+    /* one socket for each task, on port number task index + server offset port  */
+    for (uint16_t i = 0; i < card->task_num; i++) {
+
+        card->task_list[i].port = card->setting.server_offset_port + i;
+        card->task_list[i].setting = &card->setting;
+        card->task_list[i].card_id = card->name_and_id.id;
+        card->task_list[i].rand_state = card->setting.seed + i;
+        card->task_list[i].sockfd = sim_open_socket(&card->setting, card->task_list[i].port);
+        if (card->task_list[i].sockfd == -1) {
+
+            perror("testing task socket");
+            return SIM_SOCKET_FAILED;
+        }
+    }
+
+    check = pthread_create(&card->init_thread, NULL, sim_app_data_init_thread, card);
+    if (check != 0) {
+
+        return SIM_THREAD_CREATE_FAILED;
+    }
+    card->init_started = 1;
+
+    for (uint16_t i = 0; i < card->task_num; i++) {
+
+        check = pthread_create(&card->task_list[i].thread, NULL, sim_testing_thread, &card->task_list[i]);
+        if (check != 0) {
+
+            sim_running = 0;
+            return SIM_THREAD_CREATE_FAILED;
+        }
+        card->thread_num++;
+    }
+
+    return SIM_OK;
+}
+
+/**
+ * \brief           waite for all simulated card threads to finish
+ * \param[in]       card: simulated card
+ * \note            only the threads sim_card_start created are joined, it may have failed before creating them all
+ */
+void
+sim_card_join(sim_card_t* card) {
+
+    if (card->init_started) {
+
+        pthread_join(card->init_thread, NULL);
+        card->init_started = 0;
+    }
+
+    for (uint16_t i = 0; i < card->thread_num; i++) {
+
+        pthread_join(card->task_list[i].thread, NULL);
+    }
+    card->thread_num = 0;
+}
+
+/**
+ * \brief           print how many requests each simulated task served
+ * \param[in]       card: simulated card
+ */
+void
+sim_card_print_statistics(const sim_card_t* card) {
+
+    uint64_t total = 0; /* requests served by all tasks */
+
+    for (uint16_t i = 0; i < card->task_num; i++) {
+
+        printf("task port %u: served %" PRIu64 " dropped %" PRIu64 " lost %" PRIu64 "\n",
+               (unsigned int)card->task_list[i].port, card->task_list[i].served, card->task_list[i].dropped,
+               card->task_list[i].lost);
+        total += card->task_list[i].served;
+    }
+
+    printf("total served %" PRIu64 "\n", total);
+}
+
+/**
+ * \brief           close simulated card sockets and free memory
+ * \param[in]       card: simulated card
+ */
+void
+sim_card_free(sim_card_t* card) {
+
+    if (card->task_list != NULL) {
+
+        for (uint16_t i = 0; i < card->task_num; i++) {
+
+            if (card->task_list[i].sockfd != -1) {
+                close(card->task_list[i].sockfd);
+            }
+        }
+    }
+
+    if (card->init_sockfd != -1) {
+        close(card->init_sockfd);
+    }
+
+    free(card->task_list);
+    card->task_list = NULL;
+}
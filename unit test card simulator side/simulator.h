@@ -0,0 +1,606 @@
+/**
+ * \file            simulator.h
+ * \brief           stm card simulator inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef SIMULATOR
+#define SIMULATOR
+#define _XOPEN_SOURCE 600
+#include <arpa/inet.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * \brief    size of test name array
+ * \hideinitializer
+ */
+#define TEST_NAME_SIZE           100
+
+/**
+ * \brief    biggest test data size, a test request still fits in one ethernet mtu
+ * \hideinitializer
+ */
+#define MAX_BUF_LEN              1400
+
+/**
+ * \brief    smallest test data size
+ * \hideinitializer
+ */
+#define MIN_BUF_LEN              1
+
+/**
+ * \brief          test's first port increment for each task
+ * \hideinitializer
+ */
+#define SERVER_OFFSET_PORT       50007
+
+/**
+ * \brief                    app initialisation task port
+ * \hideinitializer
+ */
+#define APP_INIT_PORT            50006
+
+/**
+ * \brief                    size of array holding stm part number
+ * \hideinitializer
+ */
+#define PART_NUM_SIZE            100
+
+/**
+ * \brief                     size of id uint32_t array
+ * \hideinitializer
+ */
+#define ID_SIZE                  3
+
+/**
+ * \brief                     size of the firmware build string of the card hello
+ * \hideinitializer
+ */
+#define FIRMWARE_BUILD_SIZE      32
+
+/**
+ * \brief                     request board uniq id
+ * \hideinitializer
+ */
+#define ID_REQUEST               0
+
+/**
+ * \brief                      request size of task list
+ * \hideinitializer
+ */
+#define LIST_SIZE_REQUEST        1
+
+/**
+ * \brief                      request specific task in task list
+ * \hideinitializer
+ */
+#define LIST_MEMBER_REQUEST      2
+
+/**
+ * \brief                      request as many test list members as fit in one datagram, from list_index on
+ * \hideinitializer
+ */
+#define LIST_BULK_REQUEST        3
+
+/**
+ * \brief                      test list members sent in one LIST_BULK_REQUEST reply,
+ *                             as many as fit in an ethernet mtu (1472 bytes of udp payload)
+ * \hideinitializer
+ */
+#define LIST_BULK_MAX_MEMBERS    14
+
+/**
+ * \brief                      request card id, list sizes, protocol version and capabilities in one reply
+ * \hideinitializer
+ */
+#define HELLO_REQUEST            4
+
+/**
+ * \brief                      version of the unit test protocol, sent in the hello reply.
+ *                             incremented on every change of the protocol structs
+ * \hideinitializer
+ */
+#define PROTOCOL_VERSION         8
+
+/**
+ * \brief                      hello feature, the card answers LIST_BULK_REQUEST
+ * \hideinitializer
+ */
+#define FEATURE_LIST_BULK        0x01
+
+/**
+ * \brief                      hello feature, the card sends back the test request sequence number
+ * \hideinitializer
+ */
+#define FEATURE_SEQUENCE         0x02
+
+/**
+ * \brief                      hello feature, the card queues test requests sent while a test is running
+ * \hideinitializer
+ */
+#define FEATURE_REQUEST_QUEUE    0x04
+
+/**
+ * \brief                      hello feature, the card times the tests with its cycle counter
+ * \hideinitializer
+ */
+#define FEATURE_CYCLE_COUNT      0x08
+
+/**
+ * \brief                     communication evaluation criteria
+ * \hideinitializer
+ */
+#define COMMUNICATION_CRITERIA   0
+
+/**
+ * \brief                     analog evaluation criteria
+ * \hideinitializer
+ */
+#define ADC_CRITERIA             1
+
+/**
+ * \brief                     dac to adc linearity sweep evaluation criteria, the test data is a sweep_request_t
+ *                            followed by the sums of the adc codes the card converted
+ * \hideinitializer
+ */
+#define LINEARITY_CRITERIA       2
+
+/**
+ * \brief                     frame bus evaluation criteria, the test data is compared like a COMMUNICATION_CRITERIA
+ *                            test and the reply carries the bus statistics of the frames that moved it
+ * \hideinitializer
+ */
+#define BUS_CRITERIA             3
+
+/**
+ * \brief                     stream evaluation criteria, the card streams the test data over its peripheral pair for
+ *                            the stream time of the test, checks it as it comes in and replies the stream statistics
+ * \hideinitializer
+ */
+#define STREAM_CRITERIA          4
+
+/**
+ * \brief                     most adc samples the card sums at each dac code of a sweep, the sum fits 16 bits
+ * \hideinitializer
+ */
+#define SWEEP_MAX_AVERAGE        16
+
+/**
+ * \brief                     bytes of one analog sample in the test data of an ADC_CRITERIA test,
+ *                            a little endian dac code sent and the adc code sent back in its place
+ * \hideinitializer
+ */
+#define ADC_SAMPLE_SIZE          2
+
+/**
+ * \brief                     biggest 12 bit dac and adc code
+ * \hideinitializer
+ */
+#define ADC_CODE_MAX             4095
+
+/**
+ * \brief                     test running in pulling mode
+ * \hideinitializer
+ */
+#define PULLING_MODE             0
+
+/**
+ * \brief                     test running in IT mode
+ * \hideinitializer
+ */
+#define IT_MODE                  1
+
+/**
+ * \brief                     time the card waits for a peripheral before reporting OVER_TIME, in us
+ *                            (TIME_ELAPSED_ERROR ticks on the card)
+ * \hideinitializer
+ */
+#define SIM_OVER_TIME_DELAY_US   100000
+
+/**
+ * \brief                     how often a blocked simulator thread checks for shutdown, in us
+ * \hideinitializer
+ */
+#define SIM_POLL_INTERVAL_US     100000
+
+/**
+ * \brief                     error injection rates are given per this many requests
+ * \hideinitializer
+ */
+#define SIM_RATE_SCALE           1000
+
+/**
+ * \brief                     adcs converting the dac output in a simulated linearity sweep, like the card
+ * \hideinitializer
+ */
+#define SIM_SWEEP_ADC_NUM        3
+
+/**
+ * \brief                     test requests the simulated card says it queues, like TEST_REQUEST_QUEUE_SIZE on the card.
+ *                            the simulator itself queues them in the socket receive buffer
+ * \hideinitializer
+ */
+#define SIM_REQUEST_QUEUE_SIZE   4
+
+/**
+ * \brief                     clock of the simulated cycle counter, the core clock of the nucleo-f746zg
+ * \hideinitializer
+ */
+#define SIM_CYCLE_CLOCK_HZ       216000000
+
+/**
+ * \brief                     bitrate of the simulated can bus, the bus of the nucleo-f746zg can test
+ * \hideinitializer
+ */
+#define SIM_BUS_BITRATE          675000
+
+/**
+ * \brief                     bytes of test data in one simulated can frame
+ * \hideinitializer
+ */
+#define SIM_BUS_FRAME_DATA       8
+
+/**
+ * \brief                     bits of a standard can frame without its data and stuff bits, with the interframe space
+ * \hideinitializer
+ */
+#define SIM_BUS_FRAME_BITS       47
+
+/**
+ * \brief                     bits of a standard can frame without its data that may be stuffed, start of frame to crc
+ * \hideinitializer
+ */
+#define SIM_BUS_STUFFED_BITS     34
+
+/**
+ * \brief                     can transmit mailboxes, frames queued ahead of the frame on the bus
+ * \hideinitializer
+ */
+#define SIM_BUS_MAILBOXES        3
+
+/**
+ * \brief                     time a simulated stream test streams its data, in ms
+ * \hideinitializer
+ */
+#define SIM_STREAM_MS            20
+
+/**
+ * \brief                     throughput of a simulated stream test, in bytes a second
+ * \hideinitializer
+ */
+#define SIM_STREAM_BYTES_PER_SEC 1000000
+
+/**
+ * \brief                     default simulated peripheral latency in us
+ * \hideinitializer
+ */
+#define SIM_DEFAULT_LATENCY_US   1000
+
+/**
+ * \brief                     maximum length of the simulator bind address string
+ * \hideinitializer
+ */
+#define SIM_ADDR_SIZE            INET_ADDRSTRLEN
+
+/**
+ * \brief         test error report marcos
+ */
+typedef enum error_report {
+
+    NO_ERROR,         /*!< report stm do not see e problem with test */
+    HAL_RETURN_ERROR, /*!< report cimsis peripheral function return error */
+    ERROR_IT,         /*!< report error interrupt has jump   */
+    OVER_TIME,        /*!< report waited to long for peripheral to resume action */
+    MISMATCH          /*!< report the card found the data received different from the data sent */
+
+} error_report_t;
+
+/**
+ * \brief           simulator returns error report marcos
+ */
+typedef enum sim_error_report {
+
+    SIM_OK,                    /*!< no error during execution */
+    SIM_BAD_ARGUMENT,          /*!< command line argument is not valid */
+    SIM_SOCKET_FAILED,         /*!< failed to create or bind a socket */
+    SIM_THREAD_CREATE_FAILED,  /*!< failed to create a simulator thread */
+    SIM_MALLOC_FAILED,         /*!< failed to allocate memory */
+} sim_error_report_t;
+
+/**
+ * \brief           phases of a test the card may time, relative to the start of the test function
+ */
+typedef enum test_phase {
+
+    TEST_PHASE_TX_START,  /*!< the test started the peripheral transfer */
+    TEST_PHASE_RX_DONE,   /*!< the receive complete interrupt */
+    TEST_PHASE_TASK_WAKE, /*!< the test task woke up after the interrupt */
+    TEST_PHASE_NUM        /*!< number of phases */
+
+} test_phase_t;
+
+/**
+ * \brief           statistics of the frames that moved the test data of a BUS_CRITERIA test, 0 for other tests
+ */
+#pragma pack(push, 1)
+
+typedef struct bus_stats {
+
+    uint16_t frames;      /*!< frames received */
+    uint32_t bus_bits;    /*!< bits the frames took on the bus, with the stuff bits and the interframe space */
+    uint32_t bus_time;    /*!< bit times from the start of the first frame to the end of the last frame */
+    uint32_t bitrate;     /*!< bus bits per second */
+    uint32_t latency_sum; /*!< sum of the card cycles from queuing each frame to receiving it */
+    uint32_t latency_max; /*!< most card cycles from queuing a frame to receiving it */
+
+} bus_stats_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           statistics of the data streamed by a STREAM_CRITERIA test, 0 for other tests
+ */
+#pragma pack(push, 1)
+
+typedef struct stream_stats {
+
+    uint32_t bytes;         /*!< bytes received and checked */
+    uint32_t bit_errors;    /*!< bits received different from the bits sent */
+    uint32_t error_blocks;  /*!< blocks checked with a bit error, a block is half the circular buffer or a transfer */
+    uint32_t stream_cycles; /*!< card cycles from the stream start to the last block checked */
+
+} stream_stats_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           unit testing testing communication protocol struct
+ */
+#pragma pack(push, 1)
+
+typedef struct uint_tasting_package {
+
+    uint32_t id[ID_SIZE];                  /*!< holds stm mcu uniq id */
+    uint8_t request;                       /*!< holds app request what test in a task belong to a particular port
+                                                to run. */
+    uint16_t sequence;                     /*!< app request number, sent back by the card to match the reply */
+    uint8_t error_report;                  /*!< stm32 fill this variable with report about transmission errors */
+    uint16_t data_len;                     /*!< number of data bytes used, only they are sent */
+    uint32_t test_cycles;                  /*!< card cycles the test function ran, filled by the card */
+    uint32_t phase_cycles[TEST_PHASE_NUM]; /*!< card cycles from the test start to each phase the test marked,
+                                                0 if not marked */
+    bus_stats_t bus;                       /*!< bus statistics of a BUS_CRITERIA test, filled by the card */
+    stream_stats_t stream;                 /*!< stream statistics of a STREAM_CRITERIA test, filled by the card */
+    uint8_t data[MAX_BUF_LEN];             /*!< data for testing */
+
+} unit_tasting_package_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           first bytes of the test data of a LINEARITY_CRITERIA test, one chunk of a dac sweep
+ * \note            the card sets the dac to each code of the chunk, and sums "average" samples of each of the
+ *                  adc_num adcs. the sums follow the header as uint16_t, code after code and adc after adc
+ */
+#pragma pack(push, 1)
+
+typedef struct sweep_request {
+
+    uint16_t first_code; /*!< first dac code of the chunk */
+    uint16_t step;       /*!< dac codes between the codes of the chunk */
+    uint16_t code_num;   /*!< number of dac codes of the chunk */
+    uint8_t average;     /*!< adc samples summed at each dac code, up to SWEEP_MAX_AVERAGE */
+    uint8_t adc_num;     /*!< adcs converting each dac code */
+
+} sweep_request_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief          size of a test request without its data, the datagram size is this plus data_len
+ * \hideinitializer
+ */
+#define TEST_PACKAGE_HEADER_SIZE offsetof(unit_tasting_package_t, data)
+
+/**
+ * \brief           holds task name and setting for linux testing app
+ * \note            will be send to linux app to start the testing
+ */
+#pragma pack(push, 1)
+
+typedef struct linux_app_test_setting {
+
+    uint8_t test_name[TEST_NAME_SIZE];   /*!< name of test */
+    uint8_t results_evaluation_criteria; /*!< how to masseur the test successes */
+    uint8_t pulling_or_it;               /*!< telling pc if test is in pulling mode(run separately)
+                                          or it mode(run simultaneously) for accurate timing */
+    uint16_t payload_size;               /*!< test data size, MIN_BUF_LEN up to MAX_BUF_LEN */
+} linux_app_test_setting_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           reply to LIST_BULK_REQUEST, a chunk of the test list
+ * \note            only member_num members are sent, bigger lists are read chunk after chunk
+ */
+#pragma pack(push, 1)
+
+typedef struct list_bulk_reply {
+
+    uint16_t first_index;                                        /*!< list index of the first member sent */
+    uint8_t member_num;                                          /*!< number of members sent */
+    linux_app_test_setting_t member_list[LIST_BULK_MAX_MEMBERS]; /*!< test list members */
+
+} list_bulk_reply_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           unit test system. app test initialisation communication  protocol struct
+ * \note            app get from the card, card information and tests information
+ */
+#pragma pack(push, 1)
+
+typedef struct app_data_init_commend {
+
+    uint32_t id[ID_SIZE]; /*!< card uniq id */
+    uint8_t type;         /*!< commend */
+    uint16_t list_index;  /*!< test request, and for other use */
+} app_data_init_commend_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief            name of evaluation board under test and is uniq id
+ */
+#pragma pack(push, 1)
+
+typedef struct card_name_and_id {
+
+    uint32_t id[ID_SIZE];                     /*!< uniq id */
+    uint8_t board_part_number[PART_NUM_SIZE]; /*!< name of board */
+
+} card_name_and_id_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief            reply to HELLO_REQUEST. everything the app needs before testing, in one round trip
+ */
+#pragma pack(push, 1)
+
+typedef struct card_hello {
+
+    card_name_and_id_t card;                  /*!< card name and uniq id */
+    uint16_t protocol_version;                /*!< PROTOCOL_VERSION of the card */
+    uint16_t pc_test_list_size;               /*!< number of tests */
+    uint16_t test_list_size;                  /*!< number of testing tasks */
+    uint16_t min_payload_size;                /*!< smallest test data size the card tests */
+    uint16_t max_payload_size;                /*!< biggest test data size the card tests */
+    uint8_t request_queue_size;               /*!< test requests the card queues for each task while a test is
+                                                   running */
+    uint32_t features;                        /*!< FEATURE_ flags of the card */
+    uint32_t cycle_clock_hz;                  /*!< clock of the card cycle counter, test_cycles / cycle_clock_hz is
+                                                   the time */
+    char firmware_build[FIRMWARE_BUILD_SIZE]; /*!< firmware build of the card, may not end with '\0' */
+
+} card_hello_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief            simulated card behaviour, set from the command line
+ */
+typedef struct sim_setting {
+
+    char bind_addr[SIM_ADDR_SIZE];            /*!< local address the simulated card answers on */
+    uint16_t app_init_port;                   /*!< port of the simulated app_data_init_task */
+    uint16_t server_offset_port;              /*!< port of the first simulated testing task */
+    uint32_t latency_us;                      /*!< simulated peripheral time of every test */
+    uint32_t jitter_us;                       /*!< latency varies uniformly by up to +- jitter_us */
+    uint16_t hal_error_rate;                  /*!< HAL_RETURN_ERROR injected per SIM_RATE_SCALE requests */
+    uint16_t it_error_rate;                   /*!< ERROR_IT injected per SIM_RATE_SCALE requests */
+    uint16_t over_time_rate;                  /*!< OVER_TIME injected per SIM_RATE_SCALE requests */
+    uint16_t loss_rate;                       /*!< requests lost without a reply per SIM_RATE_SCALE requests */
+    uint16_t bit_flip_rate;                   /*!< replies with one bit flipped per SIM_RATE_SCALE requests */
+    uint16_t bit_shift_rate;                  /*!< replies shifted one bit early per SIM_RATE_SCALE requests */
+    uint8_t stuck_low;                        /*!< bit positions cleared in every byte of every reply, a stuck
+                                                   data line */
+    int16_t adc_offset;                       /*!< simulated adc offset error in LSB */
+    int32_t adc_gain_ppm;                     /*!< simulated adc gain error in ppm */
+    uint16_t adc_noise;                       /*!< simulated adc noise, uniform +- LSB */
+    int16_t adc_inl;                          /*!< simulated adc integral non linearity in LSB, a bow peaking
+                                                   mid scale */
+    unsigned int seed;                        /*!< seed for latency jitter and error injection */
+    char firmware_build[FIRMWARE_BUILD_SIZE]; /*!< firmware build sent in the hello reply */
+
+} sim_setting_t;
+
+/**
+ * \brief            resources of one simulated freertos testing task
+ */
+typedef struct sim_task {
+
+    int sockfd;                   /*!< socket bound to SERVER_OFFSET_PORT + task index */
+    uint16_t port;                /*!< port the task answers on */
+    unsigned int rand_state;      /*!< per task rand_r state */
+    uint64_t served;              /*!< number of test requests answered */
+    uint64_t dropped;             /*!< number of test requests dropped */
+    uint64_t lost;                /*!< number of test requests lost on purpose, by loss_rate */
+    const sim_setting_t* setting; /*!< simulated card behaviour */
+    const uint32_t* card_id;      /*!< simulated card uniq id, requests with another id are dropped */
+    uint16_t first_test;          /*!< index in sim_test_list_array of the first test of the task */
+    pthread_t thread;             /*!< thread running the task */
+
+} sim_task_t;
+
+/**
+ * \brief            everything the simulated card needs
+ */
+typedef struct sim_card {
+
+    sim_setting_t setting;          /*!< simulated card behaviour */
+    card_name_and_id_t name_and_id; /*!< simulated card part number and uniq id */
+    int init_sockfd;                /*!< socket of the simulated app_data_init_task */
+    unsigned int init_rand_state;   /*!< rand_r state of the simulated app_data_init_task */
+    pthread_t init_thread;          /*!< thread running the simulated app_data_init_task */
+    sim_task_t* task_list;          /*!< one member for each simulated testing task. dynamicly allocated */
+    uint16_t task_num;              /*!< number of simulated testing tasks */
+    uint8_t init_started;           /*!< init_thread was created and must be joined */
+    uint16_t thread_num;            /*!< number of testing task threads created, the first thread_num are joined */
+
+} sim_card_t;
+
+extern const linux_app_test_setting_t sim_test_list_array[];
+extern const uint16_t sim_test_list_size;
+extern volatile sig_atomic_t sim_running;
+
+void sim_setting_init(sim_setting_t* setting);
+uint8_t sim_parse_arguments(sim_card_t* card, int argc, char* argv[]);
+uint8_t sim_card_start(sim_card_t* card);
+void sim_card_join(sim_card_t* card);
+void sim_card_print_statistics(const sim_card_t* card);
+void sim_card_free(sim_card_t* card);
+
+#endif /* SIMULATOR */
@@ -0,0 +1,323 @@
+/**
+ * \file            cards.c
+ * \brief           unit test multiple cards scheduler src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "cards.h"
+
+/**
+ * \brief           initialise the unit test of one card. card information, test list and testing threads input
+ * \note            handel_in config and testing_tread need to be initialised before calling this function.
+ *                  finish_card_unit_test must be called after this function, also when it fails
+ * \param[in]       handel_in: library structure of the card
+ * \param[out]      error:error massage
+ */
+uint8_t
+prepare_card_unit_test(unit_test_pack_t* handel_in) {
+
+    uint8_t check; /* return error check */
+
+    handel_in->sockfd = -1;
+
+    check = create_app_init_socket(handel_in);
+
+    if (check == ERROR_OK) {
+        check = request_card_hello(handel_in);
+    }
+
+    if (check == ERROR_OK) {
+        check = print_card_name_and_id(handel_in);
+    }
+
+    if (check == ERROR_OK) {
+        check = allocate_test_list_mem(handel_in);
+    }
+
+    if (check == ERROR_OK) {
+        check = read_and_fill_test_list_from_stm(handel_in);
+    }
+
+    if (check == ERROR_OK) {
+        check = allocate_test_results_mem(handel_in);
+    }
+
+    if (check == ERROR_OK) {
+        check = allocating_testing_threads_handles(handel_in);
+    }
+
+    if (check == ERROR_OK) {
+        check = initialising_testing_threads_input(handel_in);
+    }
+
+    /* the card is tested also without a journal, its results are then written only at the end */
+    if (check == ERROR_OK && journal_open(handel_in) != ERROR_OK) {
+
+        fprintf(stderr, "card %s:%u failed to open its results journal, the results are written only at the end\n",
+                handel_in->config.stm_ip, (unsigned int)handel_in->config.app_init_port);
+    }
+
+    return check;
+}
+
+/**
+ * \brief           finish the unit test of one card. write the results file if the tests passed
+ *                  and release all card resources
+ * \note            the journal is removed once the results files are written, otherwise it is kept
+ *                  for resuming the tests. the results are then compared with the results history and added to it
+ * \param[in]       handel_in: library structure of the card
+ * \param[in]       check: error the card tests finished with
+ * \param[out]      error:error massage
+ */
+uint8_t
+finish_card_unit_test(unit_test_pack_t* handel_in, uint8_t check) {
+
+    if (check == ERROR_OK) {
+        check = generate_result_file(handel_in->test_raw_results_list, handel_in->list_len, &handel_in->card_id_in,
+                                     &handel_in->config);
+    }
+
+    journal_close(handel_in, check == ERROR_OK);
+
+    /* the results files are written, a regression found in the history is printed. it fails the card, keeping
+       the results files, only when regression_fail is set */
+    if (check == ERROR_OK && handel_in->config.history[0] != '\0') {
+        check = history_update(handel_in->config.history, &handel_in->card_id_in, handel_in->hello.firmware_build,
+                               handel_in->test_raw_results_list, handel_in->list_len);
+        if (check == REGRESSION_FOUND && !handel_in->config.regression_fail) {
+            check = ERROR_OK;
+        }
+    }
+
+    close_test_threads_sockets(handel_in);
+
+    free_allocated_recurses(handel_in);
+
+    return check;
+}
+
+/**
+ * \brief           run the whole unit test of one card. card information, test list, testing threads and results file
+ * \note            handel_in config and testing_tread need to be initialised before calling this function.
+ *                  all card resources are released before the function returns
+ * \param[in]       handel_in: library structure of the card
+ * \param[out]      error:error massage
+ */
+uint8_t
+run_card_unit_test(unit_test_pack_t* handel_in) {
+
+    uint8_t check; /* return error check */
+
+    check = prepare_card_unit_test(handel_in);
+
+    if (check == ERROR_OK) {
+        check = creating_and_joining_testing_threads(handel_in);
+    }
+
+    return finish_card_unit_test(handel_in, check);
+}
+
+/**
+ * \brief           thread testing one card, one for each card
+ * \param[in]       arg: "card_runner_t" struct pointer
+ * \param[out]      return: NULL
+ */
+static void*
+card_thread(void* arg) {
+
+    card_runner_t* runner = (card_runner_t*)arg; /* for casting arg to card_runner_t pointer */
+
+    runner->result = run_card_unit_test(&runner->test);
+
+    return NULL;
+}
+
+/**
+ * \brief           thread initialising the unit test of one card, one for each card
+ * \note            used by the epoll engine, the tests themselves are run by the event loops
+ * \param[in]       arg: "card_runner_t" struct pointer
+ * \param[out]      return: NULL
+ */
+static void*
+card_prepare_thread(void* arg) {
+
+    card_runner_t* runner = (card_runner_t*)arg; /* for casting arg to card_runner_t pointer */
+
+    runner->result = prepare_card_unit_test(&runner->test);
+
+    return NULL;
+}
+
+/**
+ * \brief           run the tests of the cards that were initialised with the event loop engine
+ *                  and finish the unit test of all cards
+ * \param[in]       runner_list: all cards, initialised by card_prepare_thread
+ * \param[in]       card_num: number of cards in runner_list
+ * \param[in]       loop_num: number of event loop threads
+ */
+static void
+run_cards_event_loops(card_runner_t* runner_list, uint16_t card_num, uint8_t loop_num) {
+
+    event_loop_card_t* loop_card_list; /* cards ready to be tested. dynamicly allocated */
+    uint16_t loop_card_num = 0;        /* number of cards ready to be tested */
+    uint8_t check;                     /* return error check */
+
+    loop_card_list = (event_loop_card_t*)calloc(card_num, sizeof(event_loop_card_t));
+
+    for (uint16_t i = 0; i < card_num && loop_card_list != NULL; i++) {
+
+        if (runner_list[i].result == ERROR_OK) {
+            loop_card_list[loop_card_num++].test = &runner_list[i].test;
+        }
+    }
+
+    if (loop_card_list == NULL) {
+        check = MALLOC_FAILED;
+    } else {
+        check = run_event_loops(loop_card_list, loop_card_num, loop_num);
+    }
+
+    /* store the card results, in the same order the cards were added */
+    for (uint16_t i = 0, loop_card_index = 0; i < card_num; i++) {
+
+        if (runner_list[i].result != ERROR_OK) {
+            continue;
+        }
+
+        if (loop_card_list != NULL && loop_card_index < loop_card_num) {
+            runner_list[i].result = loop_card_list[loop_card_index++].result;
+        } else {
+            runner_list[i].result = check;
+        }
+    }
+
+    free(loop_card_list);
+
+    for (uint16_t i = 0; i < card_num; i++) {
+        runner_list[i].result = finish_card_unit_test(&runner_list[i].test, runner_list[i].result);
+    }
+}
+
+/**
+ * \brief           test all the cards of the configuration simultaneously
+ * \note            each card is tested by its own thread, so the card initialisation requests
+ *                  and the tests of all cards overlap. a card failing does not stop the other cards.
+ *                  the results of all cards are journaled by one journal writer thread
+ * \param[in]       run: application configuration, the cards to test and their settings
+ * \param[in]       testing_tread_in: testing thread function, used for the tests of every card
+ * \param[out]      error:error massage, the first card error if any card failed
+ */
+uint8_t
+run_cards_simultaneously(const run_config_t* run, void* (*testing_tread_in)(void*)) {
+
+    uint16_t card_num = run_config_card_count(run); /* number of cards to test */
+    uint16_t started;                                /* number of card threads started */
+    card_runner_t* runner_list;                      /* one runner for each card. dynamicly allocated */
+    uint8_t result = ERROR_OK;                       /* first card error */
+    int check;                                       /* return error check */
+    void* (*card_function)(void*) = card_thread;     /* what the card threads run */
+    journal_t* journal_list = NULL;                  /* one journal for each card. dynamicly allocated */
+    journal_writer_t writer;                         /* thread writing the journals */
+
+    if (run->card_default.engine == ENGINE_EPOLL) {
+        card_function = card_prepare_thread;
+    }
+
+    runner_list = (card_runner_t*)calloc(card_num, sizeof(card_runner_t));
+    if (runner_list == NULL) {
+        return MALLOC_FAILED;
+    }
+
+    if (run->card_default.journal) {
+
+        journal_list = (journal_t*)calloc(card_num, sizeof(journal_t));
+        if (journal_list == NULL || journal_writer_start(&writer, journal_list, card_num) != ERROR_OK) {
+
+            fprintf(stderr, "failed to start the journal writer, the results are written only at the end\n");
+            free(journal_list);
+            journal_list = NULL;
+        }
+    }
+
+    printf("test data pattern %s seed %" PRIu64 ", give -S %" PRIu64 " to send the same test data again\n",
+           payload_pattern_name(run->card_default.pattern), run->card_default.seed, run->card_default.seed);
+
+    /* start a thread for each card */
+    for (started = 0; started < card_num; started++) {
+
+        run_config_card(run, started, &runner_list[started].test.config);
+        testing_thread_function_init(&runner_list[started].test, testing_tread_in);
+        runner_list[started].test.journal = (journal_list != NULL) ? &journal_list[started] : NULL;
+
+        check = pthread_create(&runner_list[started].thread, NULL, card_function, &runner_list[started]);
+        if (check != 0) {
+
+            runner_list[started].result = THREAD_CREATE_FAILED;
+            break;
+        }
+    }
+
+    /* waite for all card threads to finish */
+    for (uint16_t i = 0; i < started; i++) {
+        pthread_join(runner_list[i].thread, NULL);
+    }
+
+    if (started < card_num) {
+        card_num = started + 1;
+    }
+
+    /* with the epoll engine the card threads only initialised the cards, the event loops run the tests */
+    if (run->card_default.engine == ENGINE_EPOLL) {
+        run_cards_event_loops(runner_list, started, run->card_default.event_threads);
+    }
+
+    /* all journals are closed by now */
+    if (journal_list != NULL) {
+
+        journal_writer_stop(&writer);
+        free(journal_list);
+    }
+
+    for (uint16_t i = 0; i < card_num; i++) {
+
+        if (runner_list[i].result != ERROR_OK) {
+
+            fprintf(stderr, "card %s:%u failed with error %u\n", runner_list[i].test.config.stm_ip,
+                    (unsigned int)runner_list[i].test.config.app_init_port, (unsigned int)runner_list[i].result);
+
+            if (result == ERROR_OK) {
+                result = runner_list[i].result;
+            }
+        }
+    }
+
+    free(runner_list);
+
+    return result;
+}
@@ -0,0 +1,58 @@
+/**
+ * \file            cards.h
+ * \brief           unit test multiple cards scheduler inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef CARDS
+#define CARDS
+
+#include "config.h"
+#include "event_loop.h"
+#include "history.h"
+#include "journal.h"
+#include "unit_test_lib.h"
+
+/**
+ * \brief            resources of one card tested by the scheduler
+ */
+typedef struct card_runner {
+
+    unit_test_pack_t test; /*!< library structure of the card */
+    uint8_t result;        /*!< lib_error_massages_t value the card test finished with */
+    pthread_t thread;      /*!< thread running the card test */
+
+} card_runner_t;
+
+uint8_t prepare_card_unit_test(unit_test_pack_t* handel_in);
+uint8_t finish_card_unit_test(unit_test_pack_t* handel_in, uint8_t check);
+uint8_t run_card_unit_test(unit_test_pack_t* handel_in);
+uint8_t run_cards_simultaneously(const run_config_t* run, void* (*testing_tread_in)(void*));
+
+#endif /* CARDS */
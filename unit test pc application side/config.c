@@ -0,0 +1,701 @@
+/**
+ * \file            config.c
+ * \brief           unit test run time configuration src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "config.h"
+#include "result_sink.h"
+
+/**
+ * \brief           initialise the configuration to the compiled in defaults
+ * \param[in]       config: configuration to initialise
+ */
+void
+unit_test_config_init(unit_test_config_t* config) {
+
+    memset(config, 0, sizeof(*config));
+    strcpy(config->stm_ip, STM_IP);
+    config->app_init_port = APP_INIT_PORT;
+    config->server_offset_port = SERVER_OFFSET_PORT;
+    config->engine = ENGINE_THREADS;
+    config->event_threads = 1;
+    config->window = 1;
+    config->timeout_ms = DEFAULT_TIMEOUT_MS;
+    config->retries = DEFAULT_RETRIES;
+    config->result_formats = RESULT_FORMAT_TEXT;
+    config->journal = 1;
+    config->resume = 0;
+    config->iterations = DEFAULT_ITERATIONS;
+    config->adaptive = 0;
+    config->min_iterations = DEFAULT_MIN_ITERATIONS;
+    config->max_iterations = DEFAULT_MAX_ITERATIONS;
+    config->precision = DEFAULT_PRECISION;
+    config->pattern = PAYLOAD_RANDOM;
+    config->seed = 0;
+    config->adc_tolerance = DEFAULT_ADC_TOLERANCE;
+    config->adc_tolerance_mv = 0;
+    config->vref_mv = DEFAULT_VREF_MV;
+    config->sweep_step = DEFAULT_SWEEP_STEP;
+    config->sweep_average = DEFAULT_SWEEP_AVERAGE;
+    strcpy(config->history, DEFAULT_HISTORY_FILE);
+    config->regression_fail = 0;
+}
+
+/**
+ * \brief           parse a number of iterations
+ * \param[in]       text: number of iterations text, 1 up to MAX_ITERATIONS
+ * \param[out]      iterations_out: parsed number of iterations
+ * \param[out]      error:error massage
+ */
+static uint8_t
+parse_iterations(const char* text, uint32_t* iterations_out) {
+
+    unsigned long number; /* parsed number */
+    char* end;            /* end of the parsed number */
+
+    errno = 0;
+    number = strtoul(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0' || number == 0 || number > MAX_ITERATIONS) {
+        return CONFIG_ERROR;
+    }
+
+    *iterations_out = (uint32_t)number;
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           add a test with its own number of iterations
+ * \param[in]       config: card configuration
+ * \param[in]       value: "test name:iterations", the test name may have ':' in it
+ * \param[out]      error:error massage
+ */
+static uint8_t
+add_test_iterations(unit_test_config_t* config, const char* value) {
+
+    const char* separator = strrchr(value, ':'); /* points to the ':' before the number of iterations */
+    test_iterations_t* test;                     /* test added */
+
+    if (separator == NULL || separator == value || (size_t)(separator - value) >= test_name_SIZE
+        || config->test_iterations_num >= MAX_TEST_ITERATIONS) {
+        return CONFIG_ERROR;
+    }
+
+    test = &config->test_iterations_list[config->test_iterations_num];
+    if (parse_iterations(separator + 1, &test->iterations) != ERROR_OK) {
+        return CONFIG_ERROR;
+    }
+
+    memset(test->test_name, 0, sizeof(test->test_name));
+    memcpy(test->test_name, value, (size_t)(separator - value));
+    config->test_iterations_num++;
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           parse an on or off setting
+ * \param[in]       text: "on" or "off"
+ * \param[out]      value_out: 1 for on, 0 for off
+ * \param[out]      error:error massage
+ */
+static uint8_t
+parse_on_off(const char* text, uint8_t* value_out) {
+
+    if (strcmp(text, "on") == 0) {
+        *value_out = 1;
+    } else if (strcmp(text, "off") == 0) {
+        *value_out = 0;
+    } else {
+        return CONFIG_ERROR;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           parse a port number
+ * \param[in]       text: port number text
+ * \param[out]      port_out: parsed port
+ * \param[out]      error:error massage
+ */
+static uint8_t
+parse_port(const char* text, uint16_t* port_out) {
+
+    char* end;           /* end of parsed number */
+    unsigned long value; /* parsed number */
+
+    errno = 0;
+    value = strtoul(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0' || value == 0 || value > UINT16_MAX) {
+
+        return CONFIG_ERROR;
+    }
+
+    *port_out = (uint16_t)value;
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           set one configuration value by its name
+ * \note            used by both the configuration file and the command line,
+ *                  so each setting is parsed and checked in one place
+ * \param[in]       config: configuration to change
+ * \param[in]       key: setting name
+ * \param[in]       value: setting value text
+ * \param[out]      error:error massage
+ */
+uint8_t
+unit_test_config_set(unit_test_config_t* config, const char* key, const char* value) {
+
+    struct in_addr addr_check; /* checks the ip address is valid */
+    char* end;                 /* end of parsed number */
+    unsigned long number;      /* parsed number */
+
+    if (strcmp(key, "stm_ip") == 0) {
+
+        if (strlen(value) >= sizeof(config->stm_ip) || inet_pton(AF_INET, value, &addr_check) != 1) {
+            return CONFIG_ERROR;
+        }
+        strcpy(config->stm_ip, value);
+
+    } else if (strcmp(key, "app_init_port") == 0) {
+
+        return parse_port(value, &config->app_init_port);
+
+    } else if (strcmp(key, "server_offset_port") == 0) {
+
+        return parse_port(value, &config->server_offset_port);
+
+    } else if (strcmp(key, "engine") == 0) {
+
+        if (strcmp(value, "threads") == 0) {
+            config->engine = ENGINE_THREADS;
+        } else if (strcmp(value, "epoll") == 0) {
+            config->engine = ENGINE_EPOLL;
+        } else {
+            return CONFIG_ERROR;
+        }
+
+    } else if (strcmp(key, "event_threads") == 0) {
+
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0' || number == 0 || number > MAX_EVENT_THREADS) {
+            return CONFIG_ERROR;
+        }
+        config->event_threads = (uint8_t)number;
+
+    } else if (strcmp(key, "window") == 0) {
+
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0' || number == 0 || number > MAX_REQUEST_WINDOW) {
+            return CONFIG_ERROR;
+        }
+        config->window = (uint8_t)number;
+
+    } else if (strcmp(key, "timeout_ms") == 0) {
+
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0' || number == 0 || number > MAX_TIMEOUT_MS) {
+            return CONFIG_ERROR;
+        }
+        config->timeout_ms = (uint16_t)number;
+
+    } else if (strcmp(key, "retries") == 0) {
+
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0' || number > MAX_RETRIES) {
+            return CONFIG_ERROR;
+        }
+        config->retries = (uint8_t)number;
+
+    } else if (strcmp(key, "format") == 0) {
+
+        return result_format_parse(value, &config->result_formats);
+
+    } else if (strcmp(key, "journal") == 0) {
+
+        return parse_on_off(value, &config->journal);
+
+    } else if (strcmp(key, "resume") == 0) {
+
+        return parse_on_off(value, &config->resume);
+
+    } else if (strcmp(key, "history") == 0) {
+
+        /* a file name, or off for no history */
+        if (strlen(value) == 0 || strlen(value) >= sizeof(config->history)) {
+            return CONFIG_ERROR;
+        }
+        strcpy(config->history, strcmp(value, "off") == 0 ? "" : value);
+
+    } else if (strcmp(key, "regression_fail") == 0) {
+
+        return parse_on_off(value, &config->regression_fail);
+
+    } else if (strcmp(key, "iterations") == 0) {
+
+        return parse_iterations(value, &config->iterations);
+
+    } else if (strcmp(key, "adaptive") == 0) {
+
+        return parse_on_off(value, &config->adaptive);
+
+    } else if (strcmp(key, "min_iterations") == 0) {
+
+        return parse_iterations(value, &config->min_iterations);
+
+    } else if (strcmp(key, "max_iterations") == 0) {
+
+        return parse_iterations(value, &config->max_iterations);
+
+    } else if (strcmp(key, "precision") == 0) {
+
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0' || number == 0 || number > 100) {
+            return CONFIG_ERROR;
+        }
+        config->precision = (uint8_t)number;
+
+    } else if (strcmp(key, "test_iterations") == 0) {
+
+        return add_test_iterations(config, value);
+
+    } else if (strcmp(key, "pattern") == 0) {
+
+        if (payload_pattern_parse(value, &config->pattern) != 0) {
+            return CONFIG_ERROR;
+        }
+
+    } else if (strcmp(key, "adc_tolerance") == 0) {
+
+        /* in LSB, or in mV with a "mv" suffix */
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || number > ADC_CODE_MAX
+            || (*end != '\0' && strcmp(end, "lsb") != 0 && strcmp(end, "mv") != 0)) {
+            return CONFIG_ERROR;
+        }
+        config->adc_tolerance = (uint16_t)number;
+        config->adc_tolerance_mv = (strcmp(end, "mv") == 0);
+
+    } else if (strcmp(key, "vref_mv") == 0) {
+
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0' || number == 0 || number > UINT16_MAX) {
+            return CONFIG_ERROR;
+        }
+        config->vref_mv = (uint16_t)number;
+
+    } else if (strcmp(key, "sweep_step") == 0) {
+
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0' || number == 0 || number > ADC_CODE_MAX) {
+            return CONFIG_ERROR;
+        }
+        config->sweep_step = (uint16_t)number;
+
+    } else if (strcmp(key, "sweep_average") == 0) {
+
+        errno = 0;
+        number = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || *end != '\0' || number == 0 || number > SWEEP_MAX_AVERAGE) {
+            return CONFIG_ERROR;
+        }
+        config->sweep_average = (uint8_t)number;
+
+    } else if (strcmp(key, "seed") == 0) {
+
+        errno = 0;
+        config->seed = strtoull(value, &end, 0);
+        if (errno != 0 || end == value || *end != '\0') {
+            return CONFIG_ERROR;
+        }
+
+    } else {
+
+        return CONFIG_ERROR;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           add a card to the list of cards to test
+ * \param[in]       run: application configuration
+ * \param[in]       value: card address "ip[:app_init_port[:server_offset_port]]"
+ * \param[out]      error:error massage
+ */
+static uint8_t
+add_card(run_config_t* run, const char* value) {
+
+    char text[IP_ADDR_SIZE + 2 * sizeof("65535")]; /* copy of value, split at the ':' */
+    card_target_t* card;                          /* card being added */
+    struct in_addr addr_check;                    /* checks the ip address is valid */
+    char* port_text;                              /* port part of value */
+    char* offset_text = NULL;                     /* server offset port part of value */
+
+    if (run->card_num >= MAX_CARDS || strlen(value) >= sizeof(text)) {
+        return CONFIG_ERROR;
+    }
+
+    strcpy(text, value);
+    card = &run->card_list[run->card_num];
+    memset(card, 0, sizeof(*card));
+
+    /* split address and ports */
+    port_text = strchr(text, ':');
+    if (port_text != NULL) {
+
+        *port_text++ = '\0';
+        offset_text = strchr(port_text, ':');
+        if (offset_text != NULL) {
+            *offset_text++ = '\0';
+        }
+    }
+
+    if (strlen(text) >= sizeof(card->stm_ip) || inet_pton(AF_INET, text, &addr_check) != 1) {
+        return CONFIG_ERROR;
+    }
+    strcpy(card->stm_ip, text);
+
+    /* an empty port keeps the default, so "ip::port" only changes the server offset port */
+    if (port_text != NULL && *port_text != '\0' && parse_port(port_text, &card->app_init_port) != ERROR_OK) {
+        return CONFIG_ERROR;
+    }
+
+    if (offset_text != NULL && parse_port(offset_text, &card->server_offset_port) != ERROR_OK) {
+        return CONFIG_ERROR;
+    }
+
+    run->card_num++;
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           set one application configuration value by its name
+ * \note            "card" adds a card to test, all other settings are shared by all cards
+ * \param[in]       run: application configuration
+ * \param[in]       key: setting name
+ * \param[in]       value: setting value text
+ * \param[out]      error:error massage
+ */
+uint8_t
+run_config_set(run_config_t* run, const char* key, const char* value) {
+
+    if (strcmp(key, "card") == 0) {
+
+        return add_card(run, value);
+    }
+
+    return unit_test_config_set(&run->card_default, key, value);
+}
+
+/**
+ * \brief           number of cards the application tests
+ * \param[in]       run: application configuration
+ * \param[out]      return: number of cards, at least one
+ */
+uint16_t
+run_config_card_count(const run_config_t* run) {
+
+    return run->card_num == 0 ? 1 : run->card_num;
+}
+
+/**
+ * \brief           build the configuration of one card from the shared settings and the card address
+ * \param[in]       run: application configuration
+ * \param[in]       card_index: card number, smaller than run_config_card_count
+ * \param[out]      config_out: the card configuration
+ */
+void
+run_config_card(const run_config_t* run, uint16_t card_index, unit_test_config_t* config_out) {
+
+    const card_target_t* card; /* card address */
+
+    *config_out = run->card_default;
+
+    if (run->card_num == 0) {
+        return;
+    }
+
+    card = &run->card_list[card_index];
+    strcpy(config_out->stm_ip, card->stm_ip);
+
+    if (card->app_init_port != 0) {
+        config_out->app_init_port = card->app_init_port;
+    }
+
+    if (card->server_offset_port != 0) {
+        config_out->server_offset_port = card->server_offset_port;
+    }
+}
+
+/**
+ * \brief           remove white space from the start and end of a string
+ * \param[in]       text: string to trim, changed in place
+ * \param[out]      return: pointer to the first none white space character
+ */
+static char*
+trim(char* text) {
+
+    char* end; /* last character of the string */
+
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+
+    end = text + strlen(text);
+    while (end > text && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r')) {
+        end--;
+    }
+    *end = '\0';
+
+    return text;
+}
+
+/**
+ * \brief           read configuration from a file
+ * \note            one "key = value" setting per line, empty lines and lines starting with '#' are ignored.
+ *                  "card" may be given many times, once for each card to test
+ * \param[in]       run: configuration to change
+ * \param[in]       path: configuration file path
+ * \param[out]      error:error massage
+ */
+uint8_t
+read_config_file(run_config_t* run, const char* path) {
+
+    FILE* fptr;                  /* configuration file pointer */
+    char line[CONFIG_LINE_SIZE]; /* line read from the file */
+    char* key;                   /* setting name */
+    char* value;                 /* setting value */
+    char* separator;             /* points to the '=' in the line */
+    unsigned int line_num = 0;   /* line number for error messages */
+    uint8_t check;               /* return error check */
+
+    fptr = fopen(path, "r");
+    if (fptr == NULL) {
+
+        perror(path);
+        return CONFIG_ERROR;
+    }
+
+    while (fgets(line, sizeof(line), fptr) != NULL) {
+
+        line_num++;
+        key = trim(line);
+
+        if (*key == '\0' || *key == '#') {
+            continue;
+        }
+
+        separator = strchr(key, '=');
+        if (separator == NULL) {
+
+            fprintf(stderr, "%s:%u: expected key = value\n", path, line_num);
+            fclose(fptr);
+            return CONFIG_ERROR;
+        }
+
+        *separator = '\0';
+        value = trim(separator + 1);
+        key = trim(key);
+
+        check = run_config_set(run, key, value);
+        if (check != ERROR_OK) {
+
+            fprintf(stderr, "%s:%u: bad setting %s = %s\n", path, line_num, key, value);
+            fclose(fptr);
+            return check;
+        }
+    }
+
+    fclose(fptr);
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           print command line usage
+ * \param[in]       program_name: name the program was started with
+ */
+void
+print_usage(const char* program_name) {
+
+    printf("usage: %s [-c config_file] [-i card]... [-p app_init_port] [-o server_offset_port]\n"
+           "       [-e threads|epoll] [-t event_threads] [-w window] [-T timeout_ms] [-r retries]\n"
+           "       [-f format[,format]...] [-j on|off] [-R] [-n iterations] [-a] [-m min_iterations]\n"
+           "       [-M max_iterations] [-P precision] [-N test:iterations]... [-d pattern] [-S seed]\n"
+           "       [-A adc_tolerance[lsb|mv]] [-V vref_mv] [-g sweep_step] [-v sweep_average]\n"
+           "       [-H history_file|off] [-F]\n",
+           program_name);
+    printf("  -c file   read settings from a configuration file, one \"key = value\" per line\n");
+    printf("  -i card   card to test, ip[:app_init_port[:server_offset_port]] (card, default %s).\n", STM_IP);
+    printf("            give -i once for each card, all cards are tested simultaneously\n");
+    printf("  -p port   default card app init port (app_init_port, default %u)\n", (unsigned int)APP_INIT_PORT);
+    printf("  -o port   default card first testing task port (server_offset_port, default %u)\n",
+           (unsigned int)SERVER_OFFSET_PORT);
+    printf("  -e name   test engine (engine, default threads). threads: one blocking thread for each card task,\n");
+    printf("            epoll: event loop threads multiplexing the tasks of all cards\n");
+    printf("  -t num    number of event loop threads for the epoll engine (event_threads, default 1, max %u)\n",
+           (unsigned int)MAX_EVENT_THREADS);
+    printf("  -w num    test requests in flight for each card testing task (window, default 1, max %u).\n",
+           (unsigned int)MAX_REQUEST_WINDOW);
+    printf("            more than 1 keeps the card busy, but the time elapsed includes the card queue time\n");
+    printf("  -T ms     time to waite for a reply before sending a request again (timeout_ms, default %u).\n",
+           (unsigned int)DEFAULT_TIMEOUT_MS);
+    printf("            the time doubles on each retry\n");
+    printf("  -r num    times a request is sent again before the card counts as not answering\n");
+    printf("            and the test as lost (retries, default %u, max %u)\n", (unsigned int)DEFAULT_RETRIES,
+           (unsigned int)MAX_RETRIES);
+    printf("  -f list   results file formats, comma separated text,jsonl,csv (format, default text).\n");
+    printf("            a results file is written in each format\n");
+    printf("  -j on|off write the results to a journal file while the tests run (journal, default on).\n");
+    printf("            the journal is removed once the results files are written\n");
+    printf("  -R        resume the tests of a run that did not finish, the tests found in its journal\n");
+    printf("            are not run again (resume, default off)\n");
+    printf("  -n num    iterations of each test (iterations, default %u, max %u)\n", (unsigned int)DEFAULT_ITERATIONS,
+           (unsigned int)MAX_ITERATIONS);
+    printf("  -a        adaptive mode (adaptive = on), each test runs until the 95%% confidence intervals of its\n");
+    printf("            average time elapsed and failure rate are within +-precision%%\n");
+    printf("  -m num    smallest number of iterations in adaptive mode (min_iterations, default %u)\n",
+           (unsigned int)DEFAULT_MIN_ITERATIONS);
+    printf("  -M num    biggest number of iterations in adaptive mode (max_iterations, default %u)\n",
+           (unsigned int)DEFAULT_MAX_ITERATIONS);
+    printf("  -P num    adaptive mode precision in percent (precision, default %u)\n", (unsigned int)DEFAULT_PRECISION);
+    printf("  -N test:num  iterations of one test, also in adaptive mode (test_iterations). give -N once for\n");
+    printf("            each test, up to %u tests\n", (unsigned int)MAX_TEST_ITERATIONS);
+    printf("  -d name   test data pattern (pattern, default random). random, prbs7, prbs15, prbs31, walking1,\n");
+    printf("            walking0, zeros, ones, alternating or counting\n");
+    printf("  -S num    test data seed (seed, default 0 picks one from the clock). the seed is written\n");
+    printf("            to the results, running again with it sends the same test data\n");
+    printf("  -A num    largest error of a successful dac to adc sample (adc_tolerance, default %u). in LSB,\n",
+           (unsigned int)DEFAULT_ADC_TOLERANCE);
+    printf("            or in mV with a mv suffix, like 15mv\n");
+    printf("  -V mV     adc and dac reference voltage, the full scale of the codes (vref_mv, default %u)\n",
+           (unsigned int)DEFAULT_VREF_MV);
+    printf("  -g num    dac codes between the codes of a linearity sweep (sweep_step, default %u). 1 sweeps every\n",
+           (unsigned int)DEFAULT_SWEEP_STEP);
+    printf("            code and, with -v 1, also counts the missing adc codes\n");
+    printf("  -v num    adc samples averaged at each dac code of a linearity sweep (sweep_average, default %u,\n",
+           (unsigned int)DEFAULT_SWEEP_AVERAGE);
+    printf("            max %u). the missing adc codes are counted only from single samples, -v 1\n",
+           (unsigned int)SWEEP_MAX_AVERAGE);
+    printf("  -H file   results history file, or off (history, default \"%s\"). each run is compared with the\n",
+           DEFAULT_HISTORY_FILE);
+    printf("            earlier runs of the card and the other cards of its part number, then added to the file.\n");
+    printf("            the tests whose time elapsed or failure rate regressed are printed\n");
+    printf("  -F        a regression found in the history fails the card and the program (regression_fail = on,\n");
+    printf("            default off)\n");
+}
+
+/**
+ * \brief           initialise the configuration from the defaults, configuration file and command line
+ * \note            options are applied in the order they are given,
+ *                  so options after "-c" override the values in the configuration file
+ * \param[in]       run: configuration to fill
+ * \param[in]       argc: argument count
+ * \param[in]       argv: argument vector
+ * \param[out]      error:error massage
+ */
+uint8_t
+parse_command_line(run_config_t* run, int argc, char* argv[]) {
+
+    int option;          /* current command line option */
+    uint8_t check;       /* return error check */
+    struct timespec now; /* time the seed is picked from */
+
+    unit_test_config_init(&run->card_default);
+    run->card_num = 0;
+
+    while ((option = getopt(argc, argv, "c:i:p:o:e:t:w:T:r:f:j:Rn:am:M:P:N:d:S:A:V:g:v:H:Fh")) != -1) {
+
+        switch (option) {
+
+            case 'c': check = read_config_file(run, optarg); break;
+            case 'i': check = run_config_set(run, "card", optarg); break;
+            case 'p': check = run_config_set(run, "app_init_port", optarg); break;
+            case 'o': check = run_config_set(run, "server_offset_port", optarg); break;
+            case 'e': check = run_config_set(run, "engine", optarg); break;
+            case 't': check = run_config_set(run, "event_threads", optarg); break;
+            case 'w': check = run_config_set(run, "window", optarg); break;
+            case 'T': check = run_config_set(run, "timeout_ms", optarg); break;
+            case 'r': check = run_config_set(run, "retries", optarg); break;
+            case 'f': check = run_config_set(run, "format", optarg); break;
+            case 'j': check = run_config_set(run, "journal", optarg); break;
+            case 'R': check = run_config_set(run, "resume", "on"); break;
+            case 'n': check = run_config_set(run, "iterations", optarg); break;
+            case 'a': check = run_config_set(run, "adaptive", "on"); break;
+            case 'm': check = run_config_set(run, "min_iterations", optarg); break;
+            case 'M': check = run_config_set(run, "max_iterations", optarg); break;
+            case 'P': check = run_config_set(run, "precision", optarg); break;
+            case 'N': check = run_config_set(run, "test_iterations", optarg); break;
+            case 'd': check = run_config_set(run, "pattern", optarg); break;
+            case 'S': check = run_config_set(run, "seed", optarg); break;
+            case 'A': check = run_config_set(run, "adc_tolerance", optarg); break;
+            case 'V': check = run_config_set(run, "vref_mv", optarg); break;
+            case 'g': check = run_config_set(run, "sweep_step", optarg); break;
+            case 'v': check = run_config_set(run, "sweep_average", optarg); break;
+            case 'H': check = run_config_set(run, "history", optarg); break;
+            case 'F': check = run_config_set(run, "regression_fail", "on"); break;
+            default: check = CONFIG_ERROR; break;
+        }
+
+        if (check != ERROR_OK) {
+
+            print_usage(argv[0]);
+            return check;
+        }
+    }
+
+    if (optind != argc || run->card_default.min_iterations > run->card_default.max_iterations) {
+
+        print_usage(argv[0]);
+        return CONFIG_ERROR;
+    }
+
+    /* picking the seed now, so all cards get the same one and it can be written to the results */
+    if (run->card_default.seed == 0) {
+
+        clock_gettime(CLOCK_REALTIME, &now);
+        run->card_default.seed = ((uint64_t)now.tv_sec * NS_IN_SEC) ^ (uint64_t)now.tv_nsec;
+    }
+
+    return ERROR_OK;
+}
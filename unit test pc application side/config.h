@@ -0,0 +1,53 @@
+/**
+ * \file            config.h
+ * \brief           unit test run time configuration inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef CONFIG
+#define CONFIG
+
+#include "unit_test_lib.h"
+
+/**
+ * \brief          size of buffer for reading a configuration file line
+ * \hideinitializer
+ */
+#define CONFIG_LINE_SIZE 256
+
+void unit_test_config_init(unit_test_config_t* config);
+uint8_t unit_test_config_set(unit_test_config_t* config, const char* key, const char* value);
+uint8_t run_config_set(run_config_t* run, const char* key, const char* value);
+uint8_t read_config_file(run_config_t* run, const char* path);
+uint8_t parse_command_line(run_config_t* run, int argc, char* argv[]);
+uint16_t run_config_card_count(const run_config_t* run);
+void run_config_card(const run_config_t* run, uint16_t card_index, unit_test_config_t* config_out);
+void print_usage(const char* program_name);
+
+#endif /* CONFIG */
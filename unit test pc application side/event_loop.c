@@ -0,0 +1,414 @@
+/**
+ * \file            event_loop.c
+ * \brief           epoll event loop test engine src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "event_loop.h"
+
+/**
+ * \brief           stop the tests of a card, its task sockets are removed from the event loop
+ * \param[in]       loop: event loop testing the card
+ * \param[in]       card: card to stop
+ * \param[in]       result: error the card tests stopped with
+ */
+static void
+card_stop(event_loop_t* loop, event_loop_card_t* card, uint8_t result) {
+
+    for (uint8_t i = 0; i < card->test->thread_num; i++) {
+
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL,
+                  card->test->test_thread_input_list[i].thread_socket.task_port_socket_fd, NULL);
+    }
+
+    card->result = result;
+    card->running_stream = 0;
+    card->finished = 1;
+}
+
+/**
+ * \brief           start the tests of one testing task, its socket is added to the event loop
+ *                  and the first test request is sent
+ * \note            a task whose tests were all resumed from the journal is not added, running_stream does not change
+ * \param[in]       loop: event loop testing the card
+ * \param[in]       card_index: card index in the event loop card list
+ * \param[in]       stream_index: testing task index
+ * \param[out]      error:error massage
+ */
+static uint8_t
+stream_start(event_loop_t* loop, uint16_t card_index, uint8_t stream_index) {
+
+    event_loop_card_t* card = &loop->card_list[card_index];                            /* card tested */
+    tasting_thread_pack_t* stream = &card->test->test_thread_input_list[stream_index]; /* task tested */
+    struct epoll_event event;                                                          /* socket event to watch */
+
+    test_stream_reset(stream);
+
+    /* all the tests of the task were resumed from the journal */
+    if (test_stream_done(stream)) {
+        return ERROR_OK;
+    }
+
+    /* the event carries the card and the task, so a reply is matched to its stream without a search */
+    event.events = EPOLLIN;
+    event.data.u64 = ((uint64_t)card_index << 16) | stream_index;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, stream->thread_socket.task_port_socket_fd, &event) == -1) {
+        return EVENT_LOOP_FAILED;
+    }
+
+    card->running_stream++;
+
+    return test_stream_fill(stream);
+}
+
+/**
+ * \brief           start the next testing tasks of a card once the running ones finished.
+ *                  pulling mode tasks run one at a time, then all interrupt mode tasks run together
+ * \param[in]       loop: event loop testing the card
+ * \param[in]       card_index: card index in the event loop card list
+ * \param[out]      error:error massage
+ */
+static uint8_t
+card_schedule(event_loop_t* loop, uint16_t card_index) {
+
+    event_loop_card_t* card = &loop->card_list[card_index];                  /* card tested */
+    tasting_thread_pack_t* stream_list = card->test->test_thread_input_list; /* card testing tasks */
+    uint8_t check;                                                           /* return error check */
+
+    if (card->running_stream != 0 || card->finished) {
+        return ERROR_OK;
+    }
+
+    /* pulling mode tasks, run separately */
+    while (!card->it_started && card->next_stream < card->test->thread_num) {
+
+        if (stream_list[card->next_stream].first_test_addr->test_request_pack.pulling_or_it == PULLING_MODE) {
+
+            check = stream_start(loop, card_index, card->next_stream++);
+            if (check != ERROR_OK || card->running_stream != 0) {
+                return check;
+            }
+
+            continue;
+        }
+
+        card->next_stream++;
+    }
+
+    /* interrupt mode tasks, run simultaneously */
+    if (!card->it_started) {
+
+        card->it_started = 1;
+
+        for (uint8_t i = 0; i < card->test->thread_num; i++) {
+
+            if (stream_list[i].first_test_addr->test_request_pack.pulling_or_it == IT_MODE) {
+
+                check = stream_start(loop, card_index, i);
+                if (check != ERROR_OK) {
+                    return check;
+                }
+            }
+        }
+    }
+
+    if (card->running_stream == 0) {
+        card->finished = 1;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           move a testing task forward after replies were received or requests expired.
+ *                  send the next test requests, or schedule the next tasks of the card when the task finished
+ * \param[in]       loop: event loop testing the card
+ * \param[in]       card_index: card index in the event loop card list
+ * \param[in]       stream_index: testing task index
+ * \param[out]      error:error massage
+ */
+static uint8_t
+stream_progress(event_loop_t* loop, uint16_t card_index, uint8_t stream_index) {
+
+    event_loop_card_t* card = &loop->card_list[card_index];                            /* card tested */
+    tasting_thread_pack_t* stream = &card->test->test_thread_input_list[stream_index]; /* task tested */
+
+    uint8_t check;                                                                     /* return error check */
+
+    /* in adaptive mode the last test may finish without sending more requests */
+    check = test_stream_fill(stream);
+    if (check != ERROR_OK || !test_stream_done(stream)) {
+        return check;
+    }
+
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, stream->thread_socket.task_port_socket_fd, NULL);
+    card->running_stream--;
+
+    return card_schedule(loop, card_index);
+}
+
+/**
+ * \brief           handel a readable task socket. receive all waiting replies and move the task forward
+ * \param[in]       loop: event loop testing the card
+ * \param[in]       event_data: card and task index of the socket
+ * \param[out]      error:error massage
+ */
+static uint8_t
+stream_event(event_loop_t* loop, uint64_t event_data) {
+
+    uint16_t card_index = (uint16_t)(event_data >> 16);                                /* card index */
+    uint8_t stream_index = (uint8_t)(event_data & 0xFF);                               /* testing task index */
+    event_loop_card_t* card = &loop->card_list[card_index];                            /* card tested */
+    tasting_thread_pack_t* stream = &card->test->test_thread_input_list[stream_index]; /* task tested */
+    uint8_t check;                                                                     /* return error check */
+
+    if (card->finished) {
+        return ERROR_OK;
+    }
+
+    /* drain the socket, all the replies waiting are received before sending new requests */
+    while ((check = test_stream_receive(stream, MSG_DONTWAIT)) == ERROR_OK) {}
+
+    if (check != NO_MASSAGE_WAITING) {
+        return check;
+    }
+
+    return stream_progress(loop, card_index, stream_index);
+}
+
+/**
+ * \brief           send again the requests of a card with no reply in time, or count them as LOST
+ * \param[in]       loop: event loop testing the card
+ * \param[in]       card_index: card index in the event loop card list
+ * \param[out]      error:error massage
+ */
+static uint8_t
+card_expire(event_loop_t* loop, uint16_t card_index) {
+
+    event_loop_card_t* card = &loop->card_list[card_index]; /* card tested */
+    tasting_thread_pack_t* stream;                          /* task checked */
+    uint8_t check;                                          /* return error check */
+
+    for (uint8_t i = 0; i < card->test->thread_num && !card->finished; i++) {
+
+        stream = &card->test->test_thread_input_list[i];
+        if (stream->in_flight == 0) {
+            continue;
+        }
+
+        check = test_stream_expire(stream);
+        if (check == ERROR_OK) {
+            check = stream_progress(loop, card_index, i);
+        }
+
+        if (check != ERROR_OK) {
+            return check;
+        }
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           event loop thread. run the tests of its cards until all of them finished
+ * \note            a card that fails is stopped and reported, the other cards keep running
+ * \param[in]       arg: "event_loop_t" struct pointer
+ * \param[out]      return: NULL
+ */
+static void*
+event_loop_thread(void* arg) {
+
+    event_loop_t* loop = (event_loop_t*)arg;              /* for casting arg to event_loop_t pointer */
+    struct epoll_event event_list[EVENT_LOOP_MAX_EVENTS]; /* ready sockets */
+    uint16_t running_card = 0;                            /* cards with tests not finished */
+    event_loop_card_t* card;                              /* card handled */
+    uint8_t check;                                        /* return error check */
+    int event_num;                                        /* number of ready sockets */
+    uint64_t now;                                         /* current time in ns */
+    uint64_t last_tick;                                   /* last time requests were checked for timeouts */
+
+    /* start the first tasks of every card */
+    for (uint16_t i = loop->first_card; i < loop->card_num; i += loop->card_step) {
+
+        card = &loop->card_list[i];
+        check = card_schedule(loop, i);
+        if (check != ERROR_OK) {
+            card_stop(loop, card, check);
+        }
+
+        if (!card->finished) {
+            running_card++;
+        }
+    }
+
+    last_tick = monotonic_time_ns();
+
+    while (running_card > 0) {
+
+        event_num = epoll_wait(loop->epoll_fd, event_list, EVENT_LOOP_MAX_EVENTS, EVENT_LOOP_TICK_MS);
+        if (event_num == -1) {
+
+            if (errno == EINTR) {
+                continue;
+            }
+
+            loop->result = EVENT_LOOP_FAILED;
+            break;
+        }
+
+        for (int i = 0; i < event_num; i++) {
+
+            card = &loop->card_list[event_list[i].data.u64 >> 16];
+            if (card->finished) {
+                continue;
+            }
+
+            check = stream_event(loop, event_list[i].data.u64);
+            if (check != ERROR_OK) {
+                card_stop(loop, card, check);
+            }
+
+            if (card->finished) {
+                running_card--;
+            }
+        }
+
+        /* check the requests in flight for timeouts once every tick */
+        now = monotonic_time_ns();
+        if (now - last_tick < (uint64_t)EVENT_LOOP_TICK_MS * NS_IN_MS) {
+            continue;
+        }
+        last_tick = now;
+
+        for (uint16_t i = loop->first_card; i < loop->card_num; i += loop->card_step) {
+
+            card = &loop->card_list[i];
+            if (card->finished) {
+                continue;
+            }
+
+            check = card_expire(loop, i);
+            if (check != ERROR_OK) {
+                card_stop(loop, card, check);
+            }
+
+            if (card->finished) {
+                running_card--;
+            }
+        }
+    }
+
+    /* cards not finished when the event loop failed */
+    for (uint16_t i = loop->first_card; i < loop->card_num; i += loop->card_step) {
+
+        if (!loop->card_list[i].finished) {
+            card_stop(loop, &loop->card_list[i], loop->result);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief           run the tests of all cards with event loop threads, instead of a thread for each testing task
+ * \note            each event loop thread tests every loop_num card, so the cards are split evenly.
+ *                  the tests of a card are scheduled as creating_and_joining_testing_threads does
+ * \param[in]       card_list: cards to test, initialised up to initialising_testing_threads_input
+ * \param[in]       card_num: number of cards in card_list
+ * \param[in]       loop_num: number of event loop threads
+ * \param[out]      error:error massage, the card results are stored in card_list
+ */
+uint8_t
+run_event_loops(event_loop_card_t* card_list, uint16_t card_num, uint8_t loop_num) {
+
+    event_loop_t* loop_list;   /* one member for each event loop thread. dynamicly allocated */
+    uint8_t result = ERROR_OK; /* first event loop error */
+    uint8_t started = 0;       /* number of event loop threads started */
+
+    if (loop_num > card_num) {
+        loop_num = (uint8_t)card_num;
+    }
+
+    if (loop_num == 0) {
+        return ERROR_OK;
+    }
+
+    loop_list = (event_loop_t*)calloc(loop_num, sizeof(event_loop_t));
+    if (loop_list == NULL) {
+        return MALLOC_FAILED;
+    }
+
+    for (; started < loop_num; started++) {
+
+        loop_list[started].card_list = card_list;
+        loop_list[started].card_num = card_num;
+        loop_list[started].first_card = started;
+        loop_list[started].card_step = loop_num;
+        loop_list[started].result = ERROR_OK;
+
+        loop_list[started].epoll_fd = epoll_create1(0);
+        if (loop_list[started].epoll_fd == -1) {
+
+            result = EVENT_LOOP_FAILED;
+            break;
+        }
+
+        if (pthread_create(&loop_list[started].thread, NULL, event_loop_thread, &loop_list[started]) != 0) {
+
+            close(loop_list[started].epoll_fd);
+            result = THREAD_CREATE_FAILED;
+            break;
+        }
+    }
+
+    /* waite for all event loops to finish */
+    for (uint8_t i = 0; i < started; i++) {
+
+        pthread_join(loop_list[i].thread, NULL);
+        close(loop_list[i].epoll_fd);
+
+        if (result == ERROR_OK) {
+            result = loop_list[i].result;
+        }
+    }
+
+    /* cards of event loops that could not start */
+    for (uint16_t i = 0; i < card_num; i++) {
+
+        if (!card_list[i].finished) {
+
+            card_list[i].result = result;
+            card_list[i].finished = 1;
+        }
+    }
+
+    free(loop_list);
+
+    return result;
+}
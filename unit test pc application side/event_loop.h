@@ -0,0 +1,84 @@
+/**
+ * \file            event_loop.h
+ * \brief           epoll event loop test engine inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef EVENT_LOOP
+#define EVENT_LOOP
+
+#include <sys/epoll.h>
+#include "unit_test_lib.h"
+
+/**
+ * \brief                     maximum number of socket events handled by one epoll_wait call
+ * \hideinitializer
+ */
+#define EVENT_LOOP_MAX_EVENTS    64
+
+/**
+ * \brief                     how often an event loop checks its requests in flight for timeouts, in ms
+ * \hideinitializer
+ */
+#define EVENT_LOOP_TICK_MS       10
+
+/**
+ * \brief            one card tested by an event loop, and where its test schedule is
+ * \note             the tests of a card run in the same order as with testing threads.
+ *                   pulling mode tasks one after the other, then all interrupt mode tasks together
+ */
+typedef struct event_loop_card {
+
+    unit_test_pack_t* test; /*!< library structure of the card, initialised up to the testing threads input */
+    uint8_t next_stream;    /*!< next testing task checked for pulling mode */
+    uint8_t it_started;     /*!< interrupt mode testing tasks were started */
+    uint8_t running_stream; /*!< number of testing tasks started and not finished */
+    uint8_t finished;       /*!< all the card tests are finished, or the card failed */
+    uint8_t result;         /*!< lib_error_massages_t value the card tests finished with */
+
+} event_loop_card_t;
+
+/**
+ * \brief            one event loop thread, testing every card_step card starting from first_card
+ */
+typedef struct event_loop {
+
+    event_loop_card_t* card_list; /*!< all the cards tested by all the event loops */
+    uint16_t card_num;            /*!< number of cards in card_list */
+    uint16_t first_card;          /*!< first card tested by this event loop */
+    uint16_t card_step;           /*!< distance between cards tested by this event loop */
+    int epoll_fd;                 /*!< epoll instance watching the task sockets of the event loop cards */
+    uint8_t result;               /*!< lib_error_massages_t value the event loop stopped with */
+    pthread_t thread;             /*!< thread running the event loop */
+
+} event_loop_t;
+
+uint8_t run_event_loops(event_loop_card_t* card_list, uint16_t card_num, uint8_t loop_num);
+
+#endif /* EVENT_LOOP */
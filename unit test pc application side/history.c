@@ -0,0 +1,651 @@
+/**
+ * \file            history.c
+ * \brief           results history of the cards and regression detection src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "history.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "journal.h"
+
+/**
+ * \brief           serialises the card threads updating the history file, the fcntl lock of the file only
+ *                  serialises processes
+ */
+static pthread_mutex_t history_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * \brief           copy a string the card may not end with '\0' into a record string, always ended with '\0'
+ * \param[out]      to: record string
+ * \param[in]       to_size: size of the record string
+ * \param[in]       from: card string
+ * \param[in]       from_size: size of the card string array
+ */
+static void
+history_copy_string(char* to, size_t to_size, const void* from, size_t from_size) {
+
+    const char* end = memchr(from, '\0', from_size); /* end of the card string */
+    size_t len;                                      /* card string length */
+
+    len = end == NULL ? from_size : (size_t)(end - (const char*)from);
+
+    if (len > to_size - 1) {
+        len = to_size - 1;
+    }
+
+    memset(to, 0, to_size);
+    memcpy(to, from, len);
+}
+
+/**
+ * \brief           fill the history record of one test of this run
+ * \param[out]      record: history record
+ * \param[in]       run_time: time of the run, seconds since the epoch
+ * \param[in]       card: card name and id
+ * \param[in]       firmware_build: card firmware build, FIRMWARE_BUILD_SIZE bytes that may not end with '\0'
+ * \param[in]       test: test and its results
+ */
+static void
+history_fill(history_record_t* record, int64_t run_time, const card_name_and_id_t* card, const char* firmware_build,
+             const test_recurses_t* test) {
+
+    memset(record, 0, sizeof(*record));
+
+    record->magic = HISTORY_MAGIC;
+    record->version = HISTORY_VERSION;
+    record->run_time = run_time;
+    memcpy(record->card_id, card->id, sizeof(record->card_id));
+    history_copy_string(record->part_number, sizeof(record->part_number), card->board_part_number,
+                        sizeof(card->board_part_number));
+    history_copy_string(record->firmware_build, sizeof(record->firmware_build), firmware_build, FIRMWARE_BUILD_SIZE);
+
+    /* without the '#' or ' ' the card puts in front of the name, it marks the place of the test in its task */
+    history_copy_string(record->test_name, sizeof(record->test_name), &test->test_request_pack.test_name[1],
+                        sizeof(test->test_request_pack.test_name) - 1);
+
+    record->payload_size = test->test_request_pack.payload_size;
+    record->iterations = test->iteration_num;
+    record->failures = test->iteration_num - test->sums.success_num;
+
+    record->latency_count = test->latency.count;
+    record->latency_mean = test->latency.mean;
+    record->latency_m2 = test->latency.m2;
+    record->checksum = journal_hash(record, offsetof(history_record_t, checksum), JOURNAL_HASH_START);
+}
+
+/**
+ * \brief           check if two records are the same test of the same part number, the same name and test data size
+ * \param[in]       record: history record
+ * \param[in]       current: record of this run
+ * \param[out]      return: 1 if the same test, 0 if not
+ */
+static uint8_t
+history_same_test(const history_record_t* record, const history_record_t* current) {
+
+    return record->magic == HISTORY_MAGIC && record->payload_size == current->payload_size
+           && strcmp(record->part_number, current->part_number) == 0
+           && strcmp(record->test_name, current->test_name) == 0;
+}
+
+/**
+ * \brief           p value of a failure rate above the failure rate of a baseline, one sided fisher exact test
+ * \note            the failures of both are dealt at random between the tests of this run and of the baseline,
+ *                  the p value is the chance this run gets as many failures or more. the terms of the
+ *                  hypergeometric distribution are added from its mode, where the term is 1, so they do not
+ *                  overflow, and each term comes from the one next to it
+ * \param[in]       failures: failures
+ * \param[in]       iterations: test requests
+ * \param[in]       base_failures: failures of the baseline
+ * \param[in]       base_iterations: test requests of the baseline
+ * \param[out]      return: p value, 1 if it can not be told
+ */
+static double
+history_rate_p(uint32_t failures, uint32_t iterations, uint64_t base_failures, uint64_t base_iterations) {
+
+    double n = iterations;                               /* test requests of this run */
+    double base_n = (double)base_iterations;             /* test requests of the baseline */
+    double k = (double)failures + (double)base_failures; /* failures of both */
+    double low = k > base_n ? k - base_n : 0;            /* fewest failures this run can get */
+    double high = k < n ? k : n;                         /* most failures this run can get */
+    double mode;                                         /* most likely failures of this run */
+    double term;                                         /* chance of a number of failures, over the mode's */
+    double total = 0;                                    /* sum of all the terms */
+    double tail = 0;                                     /* sum of the terms of failures or more */
+
+    if (iterations == 0 || base_iterations == 0 || failures == 0) {
+        return 1;
+    }
+
+    mode = (double)(uint64_t)((k + 1) * (n + 1) / (n + base_n + 2));
+    mode = mode < low ? low : (mode > high ? high : mode);
+
+    term = 1;
+    for (double x = mode; x <= high && term > 0; x++) {
+
+        total += term;
+        if (x >= failures) {
+            tail += term;
+        }
+        term *= (k - x) * (n - x) / ((x + 1) * (base_n - k + x + 1));
+    }
+
+    term = 1;
+    for (double x = mode; x > low && term > 0; x--) {
+
+        term *= x * (base_n - k + x) / ((k - x + 1) * (n - x + 1));
+        total += term;
+        if (x - 1 >= failures) {
+            tail += term;
+        }
+    }
+
+    return tail / total;
+}
+
+/**
+ * \brief           chance of a standard normal value above z
+ * \note            abramowitz and stegun 26.2.17, the error is below 7.5e-8
+ * \param[in]       z: z score
+ * \param[out]      return: one sided p value
+ */
+static double
+history_normal_tail(double z) {
+
+    double t; /* 1 / (1 + 0.2316419 * |z|) */
+    double p; /* tail of |z| */
+
+    t = 1 / (1 + 0.2316419 * (z < 0 ? -z : z));
+    p = 0.3989422804014327 * exp(-z * z / 2) * t
+        * (0.319381530 + t * (-0.356563782 + t * (1.781477937 + t * (-1.821255978 + t * 1.330274429))));
+
+    return z < 0 ? 1 - p : p;
+}
+
+/**
+ * \brief           p value of the average time elapsed of this run above a baseline time
+ * \note            the spread of the baseline and the standard error of the average of this run add up
+ * \param[in]       current: record of this run
+ * \param[in]       base: baseline average time elapsed in ns
+ * \param[in]       spread: baseline standard deviation in ns
+ * \param[out]      return: one sided p value
+ */
+static double
+history_latency_p(const history_record_t* current, double base, double spread) {
+
+    double variance = 0; /* variance of the average time elapsed of this run */
+    double error;        /* standard error of the difference */
+
+    if (current->latency_count > 1) {
+        variance = current->latency_m2 / (current->latency_count - 1) / current->latency_count;
+    }
+
+    error = sqrt(spread * spread + variance);
+    if (error <= 0) {
+        return current->latency_mean > base ? 0 : 1;
+    }
+
+    return history_normal_tail((current->latency_mean - base) / error);
+}
+
+/**
+ * \brief           count a comparison of the average time elapsed of this run with a baseline, and check if it is
+ *                  significantly and noticeably above it
+ * \param[in]       current: record of this run
+ * \param[in]       base: baseline average time elapsed in ns
+ * \param[in]       spread: baseline standard deviation in ns
+ * \param[in]       check: comparisons of the run
+ * \param[out]      p: p value
+ * \param[out]      return: 1 if regressed, 0 if not
+ */
+static uint8_t
+history_latency_regressed(const history_record_t* current, double base, double spread, history_check_t* check,
+                          double* p) {
+
+    check->comparisons++;
+    *p = history_latency_p(current, base, spread);
+
+    return *p < check->p_limit && current->latency_mean * 100 > base * (100 + HISTORY_MIN_CHANGE_PCT);
+}
+
+/**
+ * \brief           count a comparison of the failure rate of this run with a baseline, and check if it is
+ *                  significantly above it
+ * \note            a run with less then HISTORY_MIN_FAILURES failures is not a regression, a few failures of a
+ *                  test that did not fail before are not enough to tell
+ * \param[in]       current: record of this run
+ * \param[in]       base_failures: failures of the baseline
+ * \param[in]       base_iterations: test requests of the baseline
+ * \param[in]       check: comparisons of the run
+ * \param[out]      p: p value
+ * \param[out]      return: 1 if regressed, 0 if not
+ */
+static uint8_t
+history_rate_regressed(const history_record_t* current, uint64_t base_failures, uint64_t base_iterations,
+                       history_check_t* check, double* p) {
+
+    check->comparisons++;
+    *p = history_rate_p(current->failures, current->iterations, base_failures, base_iterations);
+
+    return *p < check->p_limit && current->failures >= HISTORY_MIN_FAILURES;
+}
+
+/**
+ * \brief           qsort compare of doubles
+ * \param[in]       a: first double
+ * \param[in]       b: second double
+ * \param[out]      return: below 0, 0 or above 0 as a is below, equal or above b
+ */
+static int
+history_compare_double(const void* a, const void* b) {
+
+    double first = *(const double*)a;  /* first double */
+    double second = *(const double*)b; /* second double */
+
+    return (first > second) - (first < second);
+}
+
+/**
+ * \brief           median of a list, the list is sorted
+ * \param[in]       list: list of numbers, not empty
+ * \param[in]       num: number of numbers
+ * \param[out]      return: median
+ */
+static double
+history_median(double* list, uint32_t num) {
+
+    qsort(list, num, sizeof(double), history_compare_double);
+
+    return num % 2 ? list[num / 2] : (list[num / 2 - 1] + list[num / 2]) / 2;
+}
+
+/**
+ * \brief           print a regression of one test of this run
+ * \param[in]       current: record of this run
+ * \param[in]       text: what regressed against what
+ */
+static void
+history_print(const history_record_t* current, const char* text) {
+
+    printf("regression card %s UID:  %" PRIu32 "  ::  %" PRIu32 "  ::  %" PRIu32 " test %s: %s\n", current->part_number,
+           current->card_id[0], current->card_id[1], current->card_id[2], current->test_name, text);
+}
+
+/**
+ * \brief           compare one test of this run with the latest runs of the same card
+ * \note            the time elapsed is compared with the average and spread of the averages of the runs,
+ *                  the failure rate with the failure rate of all their tests together
+ * \param[in]       current: record of this run
+ * \param[in]       record_list: history records, oldest first
+ * \param[in]       record_num: number of history records
+ * \param[in]       check: comparisons of the run, the regressions found are counted in it
+ */
+static void
+history_compare_card(const history_record_t* current, const history_record_t* record_list, uint32_t record_num,
+                     history_check_t* check) {
+
+    char text[TXT_TRANSFER_SIZE];        /* regression text */
+    const history_record_t* last = NULL; /* latest run of the card */
+    uint32_t runs = 0;                   /* runs compared with */
+    uint32_t timed = 0;                  /* runs with successful tests timed */
+    double sum = 0;                      /* sum of the average times elapsed of the runs */
+    double sum_sq = 0;                   /* sum of the average times elapsed squared */
+    uint64_t base_iterations = 0;        /* test requests of the runs */
+    uint64_t base_failures = 0;          /* failures of the runs */
+    double base;                         /* average of the average times elapsed of the runs */
+    double spread;                       /* standard deviation of the average times elapsed of the runs */
+    double p;                            /* p value of the difference */
+
+    for (uint32_t i = record_num; i-- > 0 && runs < HISTORY_RUN_NUM;) {
+
+        if (!history_same_test(&record_list[i], current)
+            || memcmp(record_list[i].card_id, current->card_id, sizeof(current->card_id)) != 0) {
+            continue;
+        }
+
+        if (last == NULL) {
+            last = &record_list[i];
+        }
+
+        runs++;
+        base_iterations += record_list[i].iterations;
+        base_failures += record_list[i].failures;
+
+        if (record_list[i].latency_count > 0) {
+
+            timed++;
+            sum += record_list[i].latency_mean;
+            sum_sq += record_list[i].latency_mean * record_list[i].latency_mean;
+        }
+    }
+
+    if (timed >= HISTORY_MIN_RUNS && current->latency_count > 0) {
+
+        base = sum / timed;
+        spread = sqrt(fmax(0, (sum_sq - sum * base) / (timed - 1)));
+
+        if (history_latency_regressed(current, base, spread, check, &p)) {
+
+            snprintf(text, sizeof(text),
+                     "time elapsed %.3fms is %.1f%% above the %.3fms of its last %u runs (p = %.1e). firmware build "
+                     "%s, the last run had %s",
+                     current->latency_mean / NS_TO_MS, (current->latency_mean / base - 1) * 100, base / NS_TO_MS,
+                     (unsigned int)timed, p, current->firmware_build, last->firmware_build);
+            history_print(current, text);
+            check->regressions++;
+        }
+    }
+
+    if (runs >= HISTORY_MIN_RUNS) {
+
+        if (history_rate_regressed(current, base_failures, base_iterations, check, &p)) {
+
+            snprintf(text, sizeof(text),
+                     "failure rate %.3f%% is above the %.3f%% of its last %u runs (p = %.1e). firmware build %s,"
+                     " the last run had %s",
+                     (double)current->failures * 100 / current->iterations,
+                     (double)base_failures * 100 / (double)base_iterations, (unsigned int)runs, p,
+                     current->firmware_build, last->firmware_build);
+            history_print(current, text);
+            check->regressions++;
+        }
+    }
+}
+
+/**
+ * \brief           compare one test of this run with the latest run of each other card of the same part number
+ * \note            the time elapsed is compared with the median of the cards, its spread is the median absolute
+ *                  deviation, so a card that is off does not move the baseline. the failure rate is compared with
+ *                  the failure rate of all their tests together
+ * \param[in]       current: record of this run
+ * \param[in]       record_list: history records, oldest first
+ * \param[in]       record_num: number of history records
+ * \param[in]       check: comparisons of the run, the regressions found are counted in it
+ * \param[out]      error:error massage
+ */
+static uint8_t
+history_compare_part(const history_record_t* current, const history_record_t* record_list, uint32_t record_num,
+                     history_check_t* check) {
+
+    char text[TXT_TRANSFER_SIZE];       /* regression text */
+    const history_record_t** card_list; /* latest record of each other card. dynamicly allocated */
+    double* mean_list;                  /* average times elapsed of the cards. dynamicly allocated */
+    uint32_t card_num = 0;              /* other cards found */
+    uint32_t timed = 0;                 /* other cards with successful tests timed */
+    uint64_t base_iterations = 0;       /* test requests of the other cards */
+    uint64_t base_failures = 0;         /* failures of the other cards */
+    uint32_t known;                     /* index of the card in card_list, card_num if not in it */
+    double median;                      /* median of the average times elapsed of the cards */
+    double p;                           /* p value of the difference */
+
+    if (record_num == 0) {
+        return ERROR_OK;
+    }
+
+    card_list = (const history_record_t**)malloc(record_num * sizeof(const history_record_t*));
+    mean_list = (double*)malloc(record_num * sizeof(double));
+    if (card_list == NULL || mean_list == NULL) {
+
+        free(card_list);
+        free(mean_list);
+        return MALLOC_FAILED;
+    }
+
+    for (uint32_t i = record_num; i-- > 0;) {
+
+        if (!history_same_test(&record_list[i], current)
+            || memcmp(record_list[i].card_id, current->card_id, sizeof(current->card_id)) == 0) {
+            continue;
+        }
+
+        for (known = 0; known < card_num; known++) {
+
+            if (memcmp(card_list[known]->card_id, record_list[i].card_id, sizeof(current->card_id)) == 0) {
+                break;
+            }
+        }
+
+        if (known < card_num) {
+            continue;
+        }
+
+        card_list[card_num++] = &record_list[i];
+        base_iterations += record_list[i].iterations;
+        base_failures += record_list[i].failures;
+
+        if (record_list[i].latency_count > 0) {
+            mean_list[timed++] = record_list[i].latency_mean;
+        }
+    }
+
+    if (timed >= HISTORY_MIN_RUNS && current->latency_count > 0) {
+
+        median = history_median(mean_list, timed);
+
+        /* the absolute deviations from the median, their median times 1.4826 is the standard deviation */
+        for (uint32_t i = 0; i < timed; i++) {
+            mean_list[i] = mean_list[i] > median ? mean_list[i] - median : median - mean_list[i];
+        }
+
+        if (history_latency_regressed(current, median, history_median(mean_list, timed) * 1.4826, check, &p)) {
+
+            snprintf(text, sizeof(text),
+                     "time elapsed %.3fms is %.1f%% above the %.3fms median of %u other %s cards (p = %.1e)",
+                     current->latency_mean / NS_TO_MS, (current->latency_mean / median - 1) * 100, median / NS_TO_MS,
+                     (unsigned int)timed, current->part_number, p);
+            history_print(current, text);
+            check->regressions++;
+        }
+    }
+
+    if (card_num >= HISTORY_MIN_RUNS) {
+
+        if (history_rate_regressed(current, base_failures, base_iterations, check, &p)) {
+
+            snprintf(text, sizeof(text), "failure rate %.3f%% is above the %.3f%% of %u other %s cards (p = %.1e)",
+                     (double)current->failures * 100 / current->iterations,
+                     (double)base_failures * 100 / (double)base_iterations, (unsigned int)card_num,
+                     current->part_number, p);
+            history_print(current, text);
+            check->regressions++;
+        }
+    }
+
+    free(card_list);
+    free(mean_list);
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           read the whole history file
+ * \note            records of another version, or that fail their checksum, are kept so the file stays aligned,
+ *                  with their magic cleared so they are not compared
+ * \param[in]       fd: history file
+ * \param[out]      record_list: history records, oldest first. dynamicly allocated, NULL if there are none
+ * \param[out]      record_num: number of history records, a record cut by a crash at the end is not counted
+ * \param[out]      error:error massage
+ */
+static uint8_t
+history_read(int fd, history_record_t** record_list, uint32_t* record_num) {
+
+    struct stat file_stat; /* history file size */
+    size_t size;           /* bytes of the whole records */
+    size_t done = 0;       /* bytes read */
+    ssize_t check;         /* return error check */
+
+    *record_list = NULL;
+    *record_num = 0;
+
+    if (fstat(fd, &file_stat) != 0) {
+        return HISTORY_FAILED;
+    }
+
+    *record_num = (uint32_t)((size_t)file_stat.st_size / sizeof(history_record_t));
+    if (*record_num == 0) {
+        return ERROR_OK;
+    }
+
+    size = (size_t)*record_num * sizeof(history_record_t);
+    *record_list = (history_record_t*)malloc(size);
+    if (*record_list == NULL) {
+        return MALLOC_FAILED;
+    }
+
+    while (done < size) {
+
+        check = pread(fd, (uint8_t*)*record_list + done, size - done, (off_t)done);
+        if (check <= 0) {
+            return HISTORY_FAILED;
+        }
+        done += (size_t)check;
+    }
+
+    for (uint32_t i = 0; i < *record_num; i++) {
+
+        if ((*record_list)[i].magic != HISTORY_MAGIC || (*record_list)[i].version != HISTORY_VERSION
+            || (*record_list)[i].checksum
+                   != journal_hash(&(*record_list)[i], offsetof(history_record_t, checksum), JOURNAL_HASH_START)) {
+
+            (*record_list)[i].magic = 0;
+        }
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           compare the results of a card with its history and with the other cards of its part number,
+ *                  then append them to the history
+ * \note            a test is a regression when its average time elapsed or failure rate is above the baseline
+ *                  with a p value below HISTORY_ALPHA over the number of comparisons of the run. the time elapsed
+ *                  also needs to be more than HISTORY_MIN_CHANGE_PCT percent above it, and the failures at least
+ *                  HISTORY_MIN_FAILURES. the regressions are printed
+ * \param[in]       path: history file, created if it does not exist
+ * \param[in]       card: card name and id
+ * \param[in]       firmware_build: card firmware build, FIRMWARE_BUILD_SIZE bytes that may not end with '\0'
+ * \param[in]       test_list: tests and their results
+ * \param[in]       list_len: number of tests
+ * \param[out]      error:error massage, REGRESSION_FOUND if a test regressed
+ */
+uint8_t
+history_update(const char* path, const card_name_and_id_t* card, const char* firmware_build,
+               const test_recurses_t* test_list, uint16_t list_len) {
+
+    history_record_t* current_list;         /* records of this run. dynamicly allocated */
+    history_record_t* record_list = NULL;   /* records of the earlier runs. dynamicly allocated */
+    uint32_t record_num = 0;                /* number of records of the earlier runs */
+    struct flock lock;                      /* lock of the whole file against other processes */
+    history_check_t run_check;              /* comparisons of this run and the regressions found */
+    uint8_t result;                         /* return error check */
+    int64_t run_time = (int64_t)time(NULL); /* time of the run */
+    size_t size;                            /* bytes of the records of this run */
+    size_t done = 0;                        /* bytes written */
+    ssize_t check;                          /* return error check */
+    int fd;                                 /* history file */
+
+    current_list = (history_record_t*)calloc(list_len, sizeof(history_record_t));
+    if (current_list == NULL) {
+        return MALLOC_FAILED;
+    }
+
+    for (uint16_t i = 0; i < list_len; i++) {
+        history_fill(&current_list[i], run_time, card, firmware_build, &test_list[i]);
+    }
+
+    pthread_mutex_lock(&history_mutex);
+
+    fd = open(path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd < 0) {
+
+        pthread_mutex_unlock(&history_mutex);
+        free(current_list);
+        return HISTORY_FAILED;
+    }
+
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    result = fcntl(fd, F_SETLKW, &lock) == 0 ? ERROR_OK : HISTORY_FAILED;
+
+    if (result == ERROR_OK) {
+        result = history_read(fd, &record_list, &record_num);
+    }
+
+    /* the first pass counts the comparisons, the second finds the regressions. the chance of a false regression
+       in the run is split between its comparisons */
+    memset(&run_check, 0, sizeof(run_check));
+    for (uint8_t pass = 0; result == ERROR_OK && pass < 2; pass++) {
+
+        if (pass == 1) {
+
+            run_check.p_limit = run_check.comparisons > 0 ? HISTORY_ALPHA / run_check.comparisons : 0;
+            run_check.comparisons = 0;
+        }
+
+        for (uint16_t i = 0; result == ERROR_OK && i < list_len; i++) {
+
+            history_compare_card(&current_list[i], record_list, record_num, &run_check);
+            result = history_compare_part(&current_list[i], record_list, record_num, &run_check);
+        }
+    }
+
+    /* a record cut by a crash is dropped, so the records appended start at a record boundary */
+    if (result == ERROR_OK && ftruncate(fd, (off_t)((size_t)record_num * sizeof(history_record_t))) != 0) {
+        result = HISTORY_FAILED;
+    }
+
+    size = (size_t)list_len * sizeof(history_record_t);
+    while (result == ERROR_OK && done < size) {
+
+        check = pwrite(fd, (uint8_t*)current_list + done, size - done,
+                       (off_t)((size_t)record_num * sizeof(history_record_t) + done));
+        if (check <= 0) {
+            result = HISTORY_FAILED;
+        } else {
+            done += (size_t)check;
+        }
+    }
+
+    /* closing the file releases its lock */
+    if (close(fd) != 0 && result == ERROR_OK) {
+        result = HISTORY_FAILED;
+    }
+
+    pthread_mutex_unlock(&history_mutex);
+
+    free(record_list);
+    free(current_list);
+
+    if (result == ERROR_OK && run_check.regressions > 0) {
+        result = REGRESSION_FOUND;
+    }
+
+    return result;
+}
@@ -0,0 +1,128 @@
+/**
+ * \file            history.h
+ * \brief           results history of the cards and regression detection inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef HISTORY
+#define HISTORY
+
+#include "unit_test_lib.h"
+
+/**
+ * \brief                     first bytes of each history record, "HIST"
+ * \hideinitializer
+ */
+#define HISTORY_MAGIC             0x54534948
+
+/**
+ * \brief                     history record layout version, records of another version are not compared
+ * \hideinitializer
+ */
+#define HISTORY_VERSION           1
+
+/**
+ * \brief                     latest runs of a card a test is compared with
+ * \hideinitializer
+ */
+#define HISTORY_RUN_NUM           20
+
+/**
+ * \brief                     fewest earlier runs of the card, or other cards of the part number, to compare with
+ * \hideinitializer
+ */
+#define HISTORY_MIN_RUNS          3
+
+/**
+ * \brief                     chance of a false regression in a run of a card. it is split between all the comparisons
+ *                            of the run (bonferroni correction), a comparison is a regression when its p value is
+ *                            below HISTORY_ALPHA / comparisons
+ * \hideinitializer
+ */
+#define HISTORY_ALPHA             0.01
+
+/**
+ * \brief                     fewest failures of a test in a run for its failure rate to be a regression
+ * \hideinitializer
+ */
+#define HISTORY_MIN_FAILURES      3
+
+/**
+ * \brief                     smallest time elapsed increase in percent reported, smaller ones are not worth a look
+ *                            even when significant
+ * \hideinitializer
+ */
+#define HISTORY_MIN_CHANGE_PCT    5
+
+/**
+ * \brief           results of one test of one run, appended to the history file
+ * \note            the history is append only, a record cut by a crash fails its checksum and is skipped.
+ *                  the records are indexed by card uid, part number, test name and payload size when the file
+ *                  is read, the firmware build tells which build a run tested
+ */
+#pragma pack(push, 1)
+
+typedef struct history_record {
+
+    uint32_t magic;                           /*!< HISTORY_MAGIC */
+    uint16_t version;                         /*!< HISTORY_VERSION */
+    int64_t run_time;                         /*!< time of the run, seconds since the epoch */
+    uint32_t card_id[ID_SIZE];                /*!< card uniq id */
+    char part_number[PART_NUM_SIZE];          /*!< card part number */
+    char firmware_build[FIRMWARE_BUILD_SIZE]; /*!< card firmware build, empty if the card did not say */
+    char test_name[test_name_SIZE];           /*!< test name */
+    uint16_t payload_size;                    /*!< test data size */
+    uint32_t iterations;                      /*!< test requests */
+    uint32_t failures;                        /*!< test requests without data match */
+    uint32_t latency_count;                   /*!< successful tests timed */
+    double latency_mean;                      /*!< average time elapsed of the successful tests in ns */
+    double latency_m2;                        /*!< sum of squared differences of the time elapsed from the mean */
+    uint32_t checksum;                        /*!< hash of the record fields before it */
+
+} history_record_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           comparisons of a run of a card with the history
+ * \note            the run is compared twice. the first time counts the comparisons, the second finds the
+ *                  regressions with the p value limit of the number of comparisons
+ */
+typedef struct history_check {
+
+    double p_limit;       /*!< p value below which a difference is a regression, 0 to only count the comparisons */
+    uint32_t comparisons; /*!< comparisons made */
+    uint32_t regressions; /*!< regressions found */
+
+} history_check_t;
+
+uint8_t history_update(const char* path, const card_name_and_id_t* card, const char* firmware_build,
+                       const test_recurses_t* test_list, uint16_t list_len);
+
+#endif /* HISTORY */
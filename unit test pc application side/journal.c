@@ -0,0 +1,648 @@
+/**
+ * \file            journal.c
+ * \brief           crash safe journal of the test results src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "journal.h"
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/stat.h>
+
+/**
+ * \brief           FNV-1a hash of a buffer, checksum of the journal header and records and of the history records
+ * \param[in]       data: buffer to hash
+ * \param[in]       size: buffer size in bytes
+ * \param[in]       hash: hash to continue from, JOURNAL_HASH_START for a new hash
+ * \param[out]      return: hash
+ */
+uint32_t
+journal_hash(const void* data, size_t size, uint32_t hash) {
+
+    const uint8_t* byte = (const uint8_t*)data; /* byte hashed */
+
+    for (size_t i = 0; i < size; i++) {
+
+        hash ^= byte[i];
+        hash *= JOURNAL_HASH_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief           fill the journal header of a card, from its uniq id and test list
+ * \param[in]       handel_in: library structure of the card
+ * \param[out]      header: journal header
+ */
+static void
+journal_header_fill(const unit_test_pack_t* handel_in, journal_header_t* header) {
+
+    memset(header, 0, sizeof(*header));
+    header->magic = JOURNAL_MAGIC;
+    header->version = JOURNAL_VERSION;
+    memcpy(header->card_id, handel_in->commend.id, sizeof(header->card_id));
+    header->list_len = handel_in->list_len;
+
+    header->list_hash = JOURNAL_HASH_START;
+    for (uint16_t i = 0; i < handel_in->list_len; i++) {
+
+        header->list_hash = journal_hash(&handel_in->test_raw_results_list[i].test_request_pack,
+                                         sizeof(linux_app_test_setting_t), header->list_hash);
+        header->list_hash = journal_hash(&handel_in->test_raw_results_list[i].iteration_min, sizeof(uint32_t),
+                                         header->list_hash);
+        header->list_hash = journal_hash(&handel_in->test_raw_results_list[i].iteration_max, sizeof(uint32_t),
+                                         header->list_hash);
+    }
+
+    header->checksum = journal_hash(header, offsetof(journal_header_t, checksum), JOURNAL_HASH_START);
+}
+
+/**
+ * \brief           write a whole buffer to the journal file
+ * \param[in]       fd: journal file
+ * \param[in]       data: buffer to write
+ * \param[in]       size: buffer size in bytes
+ * \param[out]      error:error massage
+ */
+static uint8_t
+journal_write_all(int fd, const void* data, size_t size) {
+
+    const uint8_t* byte = (const uint8_t*)data; /* next byte to write */
+    ssize_t check;                              /* return error check */
+
+    while (size > 0) {
+
+        check = write(fd, byte, size);
+        if (check == -1) {
+
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return JOURNAL_FAILED;
+        }
+
+        byte += check;
+        size -= (size_t)check;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           queue a record for the journal writer
+ * \note            called only by the testing thread or event loop running the test stream of the queue.
+ *                  waits for the writer when the queue is full
+ * \param[in]       queue: result queue of the test stream
+ * \param[in]       test_index: index of the test in the card test list
+ * \param[in]       iteration: iteration of the test
+ * \param[in]       data_match: error_report_t of the iteration, or JOURNAL_TEST_DONE
+ * \param[in]       result: result of the iteration, NULL for a record with no times
+ */
+static void
+journal_queue_record(result_queue_t* queue, uint16_t test_index, uint32_t iteration, uint8_t data_match,
+                     const single_test_result_t* result) {
+
+    unsigned int head;        /* number of records pushed */
+    journal_record_t* record; /* record filled */
+
+    head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    while (head - atomic_load_explicit(&queue->tail, memory_order_acquire) >= RESULT_QUEUE_SIZE) {
+        sched_yield();
+    }
+
+    record = &queue->record_list[head % RESULT_QUEUE_SIZE];
+    memset(record, 0, sizeof(*record));
+    record->magic = JOURNAL_MAGIC;
+    record->test_index = test_index;
+    record->iteration = iteration;
+    record->data_match = data_match;
+    if (result != NULL) {
+        record->time_elapsed = result->time_elapsed;
+        record->card_time = result->card_time;
+        memcpy(record->phase_time, result->phase_time, sizeof(record->phase_time));
+        record->bit_errors = result->preferments.bit_errors;
+        record->first_error = result->preferments.first_error;
+        record->flip_to_one = result->preferments.flip_to_one;
+        record->flip_to_zero = result->preferments.flip_to_zero;
+        record->bit_shift = result->preferments.bit_shift;
+        record->analog = result->preferments.analog;
+        record->bus = result->bus;
+        record->stream = result->stream;
+    }
+    record->checksum = journal_hash(record, offsetof(journal_record_t, checksum), JOURNAL_HASH_START);
+
+    /* the record is seen by the writer only after it is filled */
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+}
+
+/**
+ * \brief           queue the result of one test iteration for the journal writer
+ * \param[in]       queue: result queue of the test stream, NULL if the results are not journaled
+ * \param[in]       test_index: index of the test in the card test list
+ * \param[in]       iteration: iteration of the test
+ * \param[in]       result: result of the iteration
+ */
+void
+journal_push(result_queue_t* queue, uint16_t test_index, uint32_t iteration, const single_test_result_t* result) {
+
+    if (queue != NULL) {
+        journal_queue_record(queue, test_index, iteration, result->preferments.data_match, result);
+    }
+}
+
+/**
+ * \brief           queue the record marking a test done for the journal writer,
+ *                  after the results of all its iterations were queued
+ * \param[in]       queue: result queue of the test stream, NULL if the results are not journaled
+ * \param[in]       test_index: index of the test in the card test list
+ * \param[in]       iteration_num: number of iterations of the test
+ */
+void
+journal_push_test_done(result_queue_t* queue, uint16_t test_index, uint32_t iteration_num) {
+
+    if (queue != NULL) {
+        journal_queue_record(queue, test_index, iteration_num, JOURNAL_TEST_DONE, NULL);
+    }
+}
+
+/**
+ * \brief           write the queued records of a card to its journal file, and flush them to the disk
+ *                  every JOURNAL_FSYNC_INTERVAL_MS. a closing journal is flushed and closed
+ * \note            called only by the journal writer
+ * \param[in]       journal: journal of the card
+ */
+static void
+journal_service(journal_t* journal) {
+
+    journal_record_t batch[JOURNAL_WRITE_BATCH]; /* records written by one write */
+    uint16_t batch_len;                          /* number of records in the batch */
+    unsigned int state;                          /* journal state */
+    unsigned int head;                           /* number of records pushed to the queue */
+    unsigned int tail;                           /* number of records taken from the queue */
+    uint64_t now;                                /* current time in ns */
+    result_queue_t* queue;                       /* queue emptied */
+
+    state = atomic_load(&journal->state);
+    if (state != JOURNAL_OPEN && state != JOURNAL_CLOSING) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < journal->queue_num; i++) {
+
+        queue = &journal->queue_list[i];
+        tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        head = atomic_load_explicit(&queue->head, memory_order_acquire);
+
+        while (tail != head) {
+
+            for (batch_len = 0; tail != head && batch_len < JOURNAL_WRITE_BATCH; batch_len++, tail++) {
+                batch[batch_len] = queue->record_list[tail % RESULT_QUEUE_SIZE];
+            }
+
+            /* the records are copied, the testing thread may use them again */
+            atomic_store_explicit(&queue->tail, tail, memory_order_release);
+
+            if (!journal->write_failed) {
+
+                if (journal_write_all(journal->fd, batch, batch_len * sizeof(journal_record_t)) != ERROR_OK) {
+
+                    journal->write_failed = 1;
+                    fprintf(stderr, "failed to write the journal %s, it is not written any more\n", journal->path);
+                }
+
+                journal->unsynced += batch_len;
+            }
+        }
+    }
+
+    now = monotonic_time_ns();
+    if (journal->unsynced > 0 && !journal->write_failed
+        && (state == JOURNAL_CLOSING || now - journal->sync_time >= (uint64_t)JOURNAL_FSYNC_INTERVAL_MS * NS_IN_MS)) {
+
+        if (fdatasync(journal->fd) == -1) {
+
+            journal->write_failed = 1;
+            fprintf(stderr, "failed to flush the journal %s, it is not written any more\n", journal->path);
+        }
+
+        journal->unsynced = 0;
+        journal->sync_time = now;
+    }
+
+    if (state == JOURNAL_CLOSING) {
+
+        close(journal->fd);
+        journal->fd = -1;
+
+        if (journal->remove_on_close) {
+            unlink(journal->path);
+        }
+
+        atomic_store(&journal->state, JOURNAL_CLOSED);
+    }
+}
+
+/**
+ * \brief           journal writer thread, writes the results of all cards to their journals
+ * \param[in]       arg: "journal_writer_t" struct pointer
+ * \param[out]      return: NULL
+ */
+static void*
+journal_writer_thread(void* arg) {
+
+    journal_writer_t* writer = (journal_writer_t*)arg; /* for casting arg to journal_writer_t pointer */
+    struct timespec interval = {0, JOURNAL_WRITE_INTERVAL_MS * NS_IN_MS}; /* sleep between the writes */
+    unsigned int running;                                                 /* writer not stopped yet */
+
+    /* one more pass after the writer is stopped, so no record is left in the queues */
+    do {
+
+        running = atomic_load(&writer->running);
+
+        for (uint16_t i = 0; i < writer->journal_num; i++) {
+            journal_service(&writer->journal_list[i]);
+        }
+
+        if (running) {
+            nanosleep(&interval, NULL);
+        }
+
+    } while (running);
+
+    return NULL;
+}
+
+/**
+ * \brief           start the thread writing the journals of all cards
+ * \note            journal_writer_stop must be called after the journals are closed
+ * \param[in]       writer: journal writer to start
+ * \param[in]       journal_list: journals of the cards, set to JOURNAL_IDLE by this function
+ * \param[in]       journal_num: number of journals
+ * \param[out]      error:error massage
+ */
+uint8_t
+journal_writer_start(journal_writer_t* writer, journal_t* journal_list, uint16_t journal_num) {
+
+    for (uint16_t i = 0; i < journal_num; i++) {
+
+        journal_list[i].fd = -1;
+        journal_list[i].queue_list = NULL;
+        journal_list[i].queue_num = 0;
+        atomic_init(&journal_list[i].state, JOURNAL_IDLE);
+    }
+
+    writer->journal_list = journal_list;
+    writer->journal_num = journal_num;
+    atomic_init(&writer->running, 1);
+
+    if (pthread_create(&writer->thread, NULL, journal_writer_thread, writer) != 0) {
+        return THREAD_CREATE_FAILED;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           stop the journal writer and waite for it to finish
+ * \param[in]       writer: journal writer started by journal_writer_start
+ */
+void
+journal_writer_stop(journal_writer_t* writer) {
+
+    atomic_store(&writer->running, 0);
+    pthread_join(writer->thread, NULL);
+}
+
+/**
+ * \brief           add the result of a journal record to the sums of its test
+ * \param[in]       test: test of the record
+ * \param[in]       record: result record
+ */
+static void
+journal_result_add(test_recurses_t* test, const journal_record_t* record) {
+
+    single_test_result_t result; /* result restored */
+
+    memset(&result, 0, sizeof(result));
+    result.preferments.data_match = record->data_match;
+    result.time_elapsed = record->time_elapsed;
+    result.card_time = record->card_time;
+    memcpy(result.phase_time, record->phase_time, sizeof(result.phase_time));
+    result.preferments.bit_errors = record->bit_errors;
+    result.preferments.first_error = record->first_error;
+    result.preferments.flip_to_one = record->flip_to_one;
+    result.preferments.flip_to_zero = record->flip_to_zero;
+    result.preferments.bit_shift = record->bit_shift;
+    result.preferments.analog = record->analog;
+    result.bus = record->bus;
+    result.stream = record->stream;
+
+    test_result_add(test, &result);
+}
+
+/**
+ * \brief           read the journal of a previous run and restore the results of the tests it has
+ * \note            only tests with their JOURNAL_TEST_DONE record in the journal are resumed. the journal is cut
+ *                  after the last whole record, a record cut by a crash is written again when its test is run.
+ *                  the results are not kept, so the journal is read twice. the first read finds the tests done,
+ *                  the second adds the records of their last run to their sums
+ * \param[in]       handel_in: library structure of the card, test list and testing threads input initialised
+ * \param[in]       fd: journal file, open for reading and writing
+ * \param[in]       header: expected journal header of the card
+ * \param[out]      return: 1 if the journal was resumed, 0 if it belongs to another card or test list
+ */
+static uint8_t
+journal_resume(unit_test_pack_t* handel_in, int fd, const journal_header_t* header) {
+
+    journal_header_t file_header;                /* header of the journal file */
+    journal_record_t record;                     /* record read */
+    off_t end = sizeof(journal_header_t);        /* file offset after the last whole record */
+    journal_test_t* done_list;                   /* each test found in the journal. dynamicly allocated */
+    journal_test_t* done;                        /* test of the record read */
+    uint16_t resumed_num = 0;                    /* number of tests resumed */
+    uint8_t test_num;                            /* number of leading tests of a thread done */
+    uint8_t resumed;                             /* the tests of a thread up to the test checked are resumed */
+    tasting_thread_pack_t* stream;               /* testing thread input */
+    test_recurses_t* test;                       /* test restored */
+    const char* path = handel_in->journal->path; /* journal file name */
+
+    if (read(fd, &file_header, sizeof(file_header)) != (ssize_t)sizeof(file_header)
+        || memcmp(&file_header, header, sizeof(file_header)) != 0) {
+
+        fprintf(stderr, "journal %s belongs to another card or test list, starting over\n", path);
+        return 0;
+    }
+
+    done_list = (journal_test_t*)calloc(handel_in->list_len, sizeof(journal_test_t));
+    if (done_list == NULL) {
+        return 0;
+    }
+
+    /* find the tests done, a test run again after it was done is done only if the run again finished */
+    while (read(fd, &record, sizeof(record)) == (ssize_t)sizeof(record)) {
+
+        if (record.magic != JOURNAL_MAGIC
+            || record.checksum != journal_hash(&record, offsetof(journal_record_t, checksum), JOURNAL_HASH_START)
+            || record.test_index >= handel_in->list_len) {
+            break;
+        }
+
+        test = &handel_in->test_raw_results_list[record.test_index];
+        done = &done_list[record.test_index];
+
+        if (record.data_match == JOURNAL_TEST_DONE) {
+
+            if (record.iteration > test->iteration_max || record.iteration > done->record_num) {
+                break;
+            }
+
+            done->done = record.iteration;
+            done->run_end = done->record_num;
+
+        } else {
+
+            if (record.iteration >= test->iteration_max) {
+                break;
+            }
+
+            /* the test was run again after it was done */
+            done->done = 0;
+            done->record_num++;
+        }
+
+        end += sizeof(record);
+    }
+
+    /* a thread runs its tests in order, so it skips the tests before the first one not done.
+       the transfer curve of a sweep test is not journaled, the sweep is run again */
+    for (uint8_t thread_index = 0; thread_index < handel_in->thread_num; thread_index++) {
+
+        stream = &handel_in->test_thread_input_list[thread_index];
+        resumed = 1;
+
+        for (test_num = 0; test_num < stream->number_of_test; test_num++) {
+
+            done = &done_list[stream->first_test_index + test_num];
+            resumed = resumed && done->done != 0 && stream->first_test_addr[test_num].linearity == NULL;
+            if (!resumed) {
+                done->done = 0;
+            }
+            done->record_num = 0;
+
+            memset(&stream->first_test_addr[test_num].sums, 0, sizeof(result_sums_t));
+            latency_stats_init(&stream->first_test_addr[test_num].latency);
+        }
+    }
+
+    /* each iteration of a run has one record, and all of them are written before its JOURNAL_TEST_DONE record.
+       so the last run of a test done is the last "done" records of the test before it */
+    if (ftruncate(fd, end) == -1 || lseek(fd, sizeof(journal_header_t), SEEK_SET) == -1) {
+
+        free(done_list);
+        return 0;
+    }
+
+    for (off_t offset = sizeof(journal_header_t); offset < end; offset += sizeof(record)) {
+
+        if (read(fd, &record, sizeof(record)) != (ssize_t)sizeof(record)) {
+            break;
+        }
+
+        done = &done_list[record.test_index];
+        if (record.data_match == JOURNAL_TEST_DONE || done->done == 0) {
+            continue;
+        }
+
+        done->record_num++;
+        if (done->record_num > done->run_end - done->done && done->record_num <= done->run_end) {
+            journal_result_add(&handel_in->test_raw_results_list[record.test_index], &record);
+        }
+    }
+
+    /* new records are appended after the last whole record */
+    if (lseek(fd, 0, SEEK_CUR) != end || lseek(fd, end, SEEK_SET) == -1) {
+
+        /* the tests start over, without the results added */
+        for (uint8_t thread_index = 0; thread_index < handel_in->thread_num; thread_index++) {
+            test_stream_reset(&handel_in->test_thread_input_list[thread_index]);
+        }
+
+        free(done_list);
+        return 0;
+    }
+
+    for (uint8_t thread_index = 0; thread_index < handel_in->thread_num; thread_index++) {
+
+        stream = &handel_in->test_thread_input_list[thread_index];
+
+        for (test_num = 0; test_num < stream->number_of_test; test_num++) {
+
+            test = &stream->first_test_addr[test_num];
+            if (done_list[stream->first_test_index + test_num].done == 0) {
+                break;
+            }
+
+            test->iteration_sent = done_list[stream->first_test_index + test_num].done;
+            test->iteration_num = test->iteration_sent;
+            test->sending_done = 1;
+        }
+
+        stream->first_test = test_num;
+        test_stream_reset(stream);
+        resumed_num += test_num;
+    }
+
+    free(done_list);
+
+    printf("resuming from journal %s, %u of %u tests already run\n", path, (unsigned int)resumed_num,
+           (unsigned int)handel_in->list_len);
+
+    return 1;
+}
+
+/**
+ * \brief           open the journal of a card, after its test list and testing threads input are initialised.
+ *                  with the resume setting the tests found in the journal of a previous run are skipped
+ * \note            does nothing if the card has no journal. journal_close must be called after this function,
+ *                  also when it fails
+ * \param[in]       handel_in: library structure of the card
+ * \param[out]      error:error massage
+ */
+uint8_t
+journal_open(unit_test_pack_t* handel_in) {
+
+    journal_t* journal = handel_in->journal; /* journal of the card */
+    journal_header_t header;                 /* journal header of the card */
+    int fd = -1;                             /* journal file */
+    uint8_t resumed = 0;                     /* the journal of a previous run was resumed */
+
+    if (journal == NULL) {
+        return ERROR_OK;
+    }
+
+    /* same name as the results files, so a journal left by a crash is found by the next run */
+    snprintf(journal->path, sizeof(journal->path),
+             "unit test results of card: %s UID:  %" PRIu32 "  ::  %" PRIu32 "  ::  %" PRIu32 ".journal",
+             handel_in->card_id_in.board_part_number, handel_in->card_id_in.id[0], handel_in->card_id_in.id[1],
+             handel_in->card_id_in.id[2]);
+
+    journal_header_fill(handel_in, &header);
+
+    if (handel_in->config.resume) {
+
+        fd = open(journal->path, O_RDWR);
+        if (fd != -1) {
+            resumed = journal_resume(handel_in, fd, &header);
+        }
+    }
+
+    if (!resumed) {
+
+        if (fd != -1) {
+            close(fd);
+        }
+
+        fd = open(journal->path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (fd == -1) {
+            return JOURNAL_FAILED;
+        }
+
+        if (journal_write_all(fd, &header, sizeof(header)) != ERROR_OK) {
+
+            close(fd);
+            return JOURNAL_FAILED;
+        }
+    }
+
+    journal->queue_list = (result_queue_t*)calloc(handel_in->thread_num, sizeof(result_queue_t));
+    if (journal->queue_list == NULL) {
+
+        close(fd);
+        return MALLOC_FAILED;
+    }
+
+    journal->queue_num = handel_in->thread_num;
+    for (uint8_t i = 0; i < journal->queue_num; i++) {
+
+        atomic_init(&journal->queue_list[i].head, 0);
+        atomic_init(&journal->queue_list[i].tail, 0);
+        handel_in->test_thread_input_list[i].result_queue = &journal->queue_list[i];
+    }
+
+    journal->fd = fd;
+    journal->remove_on_close = 0;
+    journal->write_failed = 0;
+    journal->unsynced = 0;
+    journal->sync_time = monotonic_time_ns();
+
+    /* from now on the file is written only by the journal writer */
+    atomic_store(&journal->state, JOURNAL_OPEN);
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           close the journal of a card, after its tests finished. waits for the journal writer
+ *                  to write the last results and close the file
+ * \param[in]       handel_in: library structure of the card
+ * \param[in]       remove_file: remove the journal file, the results files were written
+ */
+void
+journal_close(unit_test_pack_t* handel_in, uint8_t remove_file) {
+
+    journal_t* journal = handel_in->journal;                              /* journal of the card */
+    struct timespec interval = {0, JOURNAL_WRITE_INTERVAL_MS * NS_IN_MS}; /* time between state checks */
+
+    if (journal == NULL) {
+        return;
+    }
+
+    if (atomic_load(&journal->state) == JOURNAL_OPEN) {
+
+        journal->remove_on_close = remove_file;
+        atomic_store(&journal->state, JOURNAL_CLOSING);
+
+        while (atomic_load(&journal->state) != JOURNAL_CLOSED) {
+            nanosleep(&interval, NULL);
+        }
+    }
+
+    if (handel_in->test_thread_input_list != NULL) {
+
+        for (uint8_t i = 0; i < journal->queue_num; i++) {
+            handel_in->test_thread_input_list[i].result_queue = NULL;
+        }
+    }
+
+    free(journal->queue_list);
+    journal->queue_list = NULL;
+    journal->queue_num = 0;
+}
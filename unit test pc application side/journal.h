@@ -0,0 +1,218 @@
+/**
+ * \file            journal.h
+ * \brief           crash safe journal of the test results inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef JOURNAL
+#define JOURNAL
+
+#include <stdatomic.h>
+#include "unit_test_lib.h"
+
+/**
+ * \brief                     first bytes of a journal file and of each of its records, "JRNL"
+ * \hideinitializer
+ */
+#define JOURNAL_MAGIC             0x4C4E524A
+
+/**
+ * \brief                     journal file layout version, a journal of another version is not resumed
+ * \hideinitializer
+ */
+#define JOURNAL_VERSION           6
+
+/**
+ * \brief                     first value of the FNV-1a hash
+ * \hideinitializer
+ */
+#define JOURNAL_HASH_START        2166136261u
+
+/**
+ * \brief                     FNV-1a hash multiplier
+ * \hideinitializer
+ */
+#define JOURNAL_HASH_PRIME        16777619u
+
+/**
+ * \brief                     data_match of the record written once all iterations of a test have a result,
+ *                            its iteration is the number of iterations
+ * \hideinitializer
+ */
+#define JOURNAL_TEST_DONE         0xFF
+
+/**
+ * \brief                     records each testing thread queues for the journal writer, a power of 2.
+ *                            a testing thread waits for the writer when its queue is full
+ * \hideinitializer
+ */
+#define RESULT_QUEUE_SIZE         256
+
+/**
+ * \brief                     time the journal writer sleeps between emptying the queues, in ms
+ * \hideinitializer
+ */
+#define JOURNAL_WRITE_INTERVAL_MS 5
+
+/**
+ * \brief                     longest time written records waite to be flushed to the disk, in ms.
+ *                            records written in that time are flushed together by one fdatasync
+ * \hideinitializer
+ */
+#define JOURNAL_FSYNC_INTERVAL_MS 100
+
+/**
+ * \brief                     records written to the journal file by one write
+ * \hideinitializer
+ */
+#define JOURNAL_WRITE_BATCH       64
+
+/**
+ * \brief           journal states, set by the card thread and the journal writer
+ */
+typedef enum journal_state {
+
+    JOURNAL_IDLE,    /*!< not opened, the card results are not journaled */
+    JOURNAL_OPEN,    /*!< the writer appends the queued records to the journal file */
+    JOURNAL_CLOSING, /*!< the tests finished, the writer writes the last records and closes the file */
+    JOURNAL_CLOSED   /*!< the file is closed, and removed if requested */
+
+} journal_state_t;
+
+/**
+ * \brief           first bytes of a journal file, the card and test list the results belong to
+ */
+#pragma pack(push, 1)
+
+typedef struct journal_header {
+
+    uint32_t magic;            /*!< JOURNAL_MAGIC */
+    uint16_t version;          /*!< JOURNAL_VERSION */
+    uint32_t card_id[ID_SIZE]; /*!< card uniq id */
+    uint16_t list_len;         /*!< number of tests */
+    uint32_t list_hash;        /*!< hash of the test list and iterations, they must not change to resume */
+    uint32_t checksum;         /*!< hash of the header fields before it */
+
+} journal_header_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           result of one test iteration, appended to the journal file after the header
+ * \note            a record cut by a crash fails its checksum, the journal is resumed up to the record before it.
+ *                  a test is resumed only if its JOURNAL_TEST_DONE record follows its results
+ */
+#pragma pack(push, 1)
+
+typedef struct journal_record {
+
+    uint32_t magic;                      /*!< JOURNAL_MAGIC */
+    uint16_t test_index;                 /*!< index of the test in the card test list */
+    uint32_t iteration;                  /*!< iteration of the test */
+    uint8_t data_match;                  /*!< error_report_t of the iteration, or JOURNAL_TEST_DONE */
+    uint64_t time_elapsed;               /*!< test time elapsed in ns */
+    uint64_t card_time;                  /*!< time in ns the card ran the test function */
+    uint64_t phase_time[TEST_PHASE_NUM]; /*!< time in ns from the test start to each phase */
+    uint32_t bit_errors;                 /*!< bits received different from the bits sent */
+    uint16_t first_error;                /*!< offset of the first byte received different from the byte sent */
+    uint8_t flip_to_one;                 /*!< bit positions that flipped from 0 to 1 */
+    uint8_t flip_to_zero;                /*!< bit positions that flipped from 1 to 0 */
+    uint8_t bit_shift;                   /*!< bit_shift_t of the data received */
+    analog_sums_t analog;                /*!< analog errors of an analog test */
+    bus_result_t bus;                    /*!< bus statistics of a bus test */
+    stream_result_t stream;              /*!< stream statistics of a stream test */
+    uint32_t checksum;                   /*!< hash of the record fields before it */
+
+} journal_record_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief            a test found in the journal of a previous run, while the journal is resumed
+ */
+typedef struct journal_test {
+
+    uint32_t done;       /*!< number of iterations of the test done, 0 if not done */
+    uint32_t record_num; /*!< result records of the test read */
+    uint32_t run_end;    /*!< result records of the test up to its last JOURNAL_TEST_DONE record */
+
+} journal_test_t;
+
+/**
+ * \brief            records of one testing thread waiting for the journal writer
+ * \note             lock free, single producer (the testing thread or event loop running the test stream)
+ *                   and single consumer (the journal writer). head and tail only grow, index % RESULT_QUEUE_SIZE
+ *                   is the record
+ */
+typedef struct result_queue {
+
+    journal_record_t record_list[RESULT_QUEUE_SIZE]; /*!< queued records */
+    atomic_uint head;                                /*!< number of records pushed, written by the producer */
+    atomic_uint tail;                                /*!< number of records written, written by the writer */
+
+} result_queue_t;
+
+/**
+ * \brief            journal of the results of one card
+ */
+typedef struct journal {
+
+    char path[TXT_TRANSFER_SIZE]; /*!< journal file name */
+    int fd;                       /*!< journal file, written only by the journal writer */
+    result_queue_t* queue_list;   /*!< a queue for each testing thread. dynamicly allocated */
+    uint8_t queue_num;            /*!< number of queues */
+    uint8_t remove_on_close;      /*!< remove the file when it is closed, the results file was written */
+    uint8_t write_failed;         /*!< writing the file failed, the journal is incomplete */
+    uint32_t unsynced;            /*!< records written since the last fdatasync */
+    uint64_t sync_time;           /*!< monotonic time in ns of the last fdatasync */
+    atomic_uint state;            /*!< journal_state_t */
+
+} journal_t;
+
+/**
+ * \brief            thread writing the journals of all cards
+ */
+typedef struct journal_writer {
+
+    journal_t* journal_list; /*!< journals of the cards */
+    uint16_t journal_num;    /*!< number of journals */
+    atomic_uint running;     /*!< cleared to stop the writer */
+    pthread_t thread;        /*!< writer thread */
+
+} journal_writer_t;
+
+uint32_t journal_hash(const void* data, size_t size, uint32_t hash);
+uint8_t journal_writer_start(journal_writer_t* writer, journal_t* journal_list, uint16_t journal_num);
+void journal_writer_stop(journal_writer_t* writer);
+uint8_t journal_open(unit_test_pack_t* handel_in);
+void journal_close(unit_test_pack_t* handel_in, uint8_t remove_file);
+void journal_push(result_queue_t* queue, uint16_t test_index, uint32_t iteration, const single_test_result_t* result);
+void journal_push_test_done(result_queue_t* queue, uint16_t test_index, uint32_t iteration_num);
+
+#endif /* JOURNAL */
@@ -0,0 +1,233 @@
+/**
+ * \file            latency_stats.c
+ * \brief           streaming latency statistics of a test src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "latency_stats.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * \brief           names of the decade buckets in the report histogram
+ */
+static const char* const latency_decade_name[LATENCY_DECADE_NUM] = {
+    "<1us", "1us-10us", "10us-100us", "100us-1ms", "1ms-10ms", "10ms-100ms", "100ms-1s", "1s-10s", ">=10s"};
+
+/**
+ * \brief           log-linear bucket of a latency
+ * \note            latencies below LATENCY_SUB_BUCKET_NUM ns have a bucket each, above that every power of 2
+ *                  is split in to LATENCY_SUB_BUCKET_NUM buckets
+ * \param[in]       latency_ns: latency
+ * \param[out]      return: bucket index
+ */
+static uint32_t
+latency_bucket_index(uint64_t latency_ns) {
+
+    uint32_t shift = 0; /* bits dropped from the latency, the power of 2 of the latency less sub bucket bits */
+
+    if (latency_ns >= (uint64_t)1 << LATENCY_MAX_BITS) {
+        return LATENCY_BUCKET_NUM - 1;
+    }
+
+    while ((latency_ns >> shift) >= 2 * LATENCY_SUB_BUCKET_NUM) {
+        shift++;
+    }
+
+    return shift * LATENCY_SUB_BUCKET_NUM + (uint32_t)(latency_ns >> shift);
+}
+
+/**
+ * \brief           middle latency of a log-linear bucket
+ * \param[in]       index: bucket index
+ * \param[out]      return: latency in ns
+ */
+static uint64_t
+latency_bucket_value(uint32_t index) {
+
+    uint32_t shift;    /* bits dropped from the latencies of the bucket */
+    uint64_t mantissa; /* latency of the bucket without the bits dropped */
+
+    if (index < 2 * LATENCY_SUB_BUCKET_NUM) {
+        return index;
+    }
+
+    shift = index / LATENCY_SUB_BUCKET_NUM - 1;
+    mantissa = index % LATENCY_SUB_BUCKET_NUM + LATENCY_SUB_BUCKET_NUM;
+
+    return (mantissa << shift) + ((uint64_t)1 << shift) / 2;
+}
+
+/**
+ * \brief           empty latency statistics
+ * \param[out]      stats: statistics to empty
+ */
+void
+latency_stats_init(latency_stats_t* stats) {
+
+    memset(stats, 0, sizeof(*stats));
+}
+
+/**
+ * \brief           record one latency
+ * \param[in]       stats: statistics of the test
+ * \param[in]       latency_ns: latency
+ */
+void
+latency_stats_add(latency_stats_t* stats, uint64_t latency_ns) {
+
+    double delta;           /* difference from the mean before this latency */
+    uint64_t decade_limit;  /* top of the decade bucket checked */
+    uint8_t decade = 0;     /* decade bucket of the latency */
+
+    if (stats->count == 0 || latency_ns < stats->min) {
+        stats->min = latency_ns;
+    }
+    if (stats->count == 0 || latency_ns > stats->max) {
+        stats->max = latency_ns;
+    }
+    stats->count++;
+
+    /* welford running mean and variance, no sum that may overflow and no big cancellation */
+    delta = (double)latency_ns - stats->mean;
+    stats->mean += delta / stats->count;
+    stats->m2 += delta * ((double)latency_ns - stats->mean);
+
+    stats->bucket[latency_bucket_index(latency_ns)]++;
+
+    /* decade 0 is below 1 us, the last decade is 10 s and above */
+    for (decade_limit = 1000; decade < LATENCY_DECADE_NUM - 1 && latency_ns >= decade_limit; decade_limit *= 10) {
+        decade++;
+    }
+    stats->decade[decade]++;
+}
+
+/**
+ * \brief           latency below which a percentage of the recorded latencies are
+ * \param[in]       stats: statistics of the test
+ * \param[in]       percentile: percentage, 0 to 100
+ * \param[out]      return: latency in ns, 0 if no latency was recorded
+ */
+uint64_t
+latency_stats_percentile(const latency_stats_t* stats, double percentile) {
+
+    uint64_t rank;      /* number of latencies up to the percentile */
+    uint64_t seen = 0;  /* latencies in the buckets walked */
+    uint64_t value;     /* latency of the bucket holding the percentile */
+
+    if (stats->count == 0) {
+        return 0;
+    }
+
+    /* rank rounded up, and at least the first latency */
+    rank = (uint64_t)(percentile / 100.0 * stats->count);
+    if (rank < percentile / 100.0 * stats->count || rank == 0) {
+        rank++;
+    }
+
+    for (uint32_t i = 0; i < LATENCY_BUCKET_NUM; i++) {
+
+        seen += stats->bucket[i];
+        if (seen >= rank) {
+
+            /* the bucket middle may be out of the latencies recorded */
+            value = latency_bucket_value(i);
+            if (value < stats->min) {
+                value = stats->min;
+            }
+            if (value > stats->max) {
+                value = stats->max;
+            }
+
+            return value;
+        }
+    }
+
+    return stats->max;
+}
+
+/**
+ * \brief           standard deviation of the recorded latencies
+ * \param[in]       stats: statistics of the test
+ * \param[out]      return: standard deviation in ns, 0 if less then 2 latencies were recorded
+ */
+uint64_t
+latency_stats_stddev(const latency_stats_t* stats) {
+
+    if (stats->count < 2 || stats->m2 <= 0) {
+        return 0;
+    }
+
+    return (uint64_t)sqrt(stats->m2 / (stats->count - 1));
+}
+
+/**
+ * \brief           name of a decade bucket of the report histogram
+ * \param[in]       decade: decade bucket index, below LATENCY_DECADE_NUM
+ * \param[out]      return: bucket name, like "1ms-10ms"
+ */
+const char*
+latency_stats_decade_name(uint8_t decade) {
+
+    return decade < LATENCY_DECADE_NUM ? latency_decade_name[decade] : "";
+}
+
+/**
+ * \brief           write the statistics as result file text, in ms
+ * \param[in]       stats: statistics of the test
+ * \param[out]      text: buffer for the text
+ * \param[in]       text_size: size of the text buffer
+ * \param[out]      return: length of the text written, like snprintf
+ */
+int
+latency_stats_print(const latency_stats_t* stats, char* text, size_t text_size) {
+
+    int text_len; /* length of the text so far */
+
+    text_len = snprintf(text, text_size,
+                        "latency min = %6.3fms. p50 = %6.3fms. p90 = %6.3fms. p99 = %6.3fms. p99.9 = %6.3fms. "
+                        "max = %6.3fms. stddev = %6.3fms.\n histogram:",
+                        stats->min / LATENCY_NS_TO_MS, latency_stats_percentile(stats, 50) / LATENCY_NS_TO_MS,
+                        latency_stats_percentile(stats, 90) / LATENCY_NS_TO_MS,
+                        latency_stats_percentile(stats, 99) / LATENCY_NS_TO_MS,
+                        latency_stats_percentile(stats, 99.9) / LATENCY_NS_TO_MS, stats->max / LATENCY_NS_TO_MS,
+                        latency_stats_stddev(stats) / LATENCY_NS_TO_MS);
+
+    for (uint8_t i = 0; i < LATENCY_DECADE_NUM && text_len >= 0 && (size_t)text_len < text_size; i++) {
+
+        if (stats->decade[i] > 0) {
+            text_len += snprintf(text + text_len, text_size - text_len, " %s %" PRIu32 ".", latency_decade_name[i],
+                                 stats->decade[i]);
+        }
+    }
+
+    return text_len;
+}
@@ -0,0 +1,100 @@
+/**
+ * \file            latency_stats.h
+ * \brief           streaming latency statistics of a test inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef LATENCY_STATS
+#define LATENCY_STATS
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \brief                     sub buckets for each power of 2, a recorded value is off by no more then 1/32
+ * \hideinitializer
+ */
+#define LATENCY_SUB_BUCKET_BITS  5
+
+/**
+ * \brief                     number of sub buckets for each power of 2
+ * \hideinitializer
+ */
+#define LATENCY_SUB_BUCKET_NUM   (1 << LATENCY_SUB_BUCKET_BITS)
+
+/**
+ * \brief                     biggest latency recorded exactly is 2^LATENCY_MAX_BITS ns (about 18 minutes),
+ *                            bigger latencies are counted in the last bucket
+ * \hideinitializer
+ */
+#define LATENCY_MAX_BITS         40
+
+/**
+ * \brief                     number of log-linear buckets
+ * \hideinitializer
+ */
+#define LATENCY_BUCKET_NUM       ((LATENCY_MAX_BITS - LATENCY_SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKET_NUM)
+
+/**
+ * \brief                     number of decade buckets printed in the report histogram, <1us up to >=10s
+ * \hideinitializer
+ */
+#define LATENCY_DECADE_NUM       9
+
+/**
+ * \brief                     divided by to convert ns to ms
+ * \hideinitializer
+ */
+#define LATENCY_NS_TO_MS         1000000.0
+
+/**
+ * \brief            latency statistics of one test, updated one latency at a time
+ * \note             the memory does not grow with the number of latencies recorded. percentiles are read
+ *                   from log-linear buckets, like an HDR histogram with 2 significant digits
+ */
+typedef struct latency_stats {
+
+    uint32_t count;                         /*!< number of latencies recorded */
+    uint64_t min;                           /*!< smallest latency in ns */
+    uint64_t max;                           /*!< biggest latency in ns */
+    double mean;                            /*!< running mean in ns */
+    double m2;                              /*!< running sum of squared differences from the mean, for the stddev */
+    uint32_t bucket[LATENCY_BUCKET_NUM];    /*!< log-linear buckets, for the percentiles */
+    uint32_t decade[LATENCY_DECADE_NUM];    /*!< decade buckets, for the report histogram */
+
+} latency_stats_t;
+
+void latency_stats_init(latency_stats_t* stats);
+void latency_stats_add(latency_stats_t* stats, uint64_t latency_ns);
+uint64_t latency_stats_percentile(const latency_stats_t* stats, double percentile);
+uint64_t latency_stats_stddev(const latency_stats_t* stats);
+const char* latency_stats_decade_name(uint8_t decade);
+int latency_stats_print(const latency_stats_t* stats, char* text, size_t text_size);
+
+#endif /* LATENCY_STATS */
@@ -0,0 +1,244 @@
+/**
+ * \file            linearity.c
+ * \brief           dac to adc transfer curve and linearity of a sweep test src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "linearity.h"
+#include <string.h>
+
+/**
+ * \brief           average adc code converted at a dac code
+ * \param[in]       curve: transfer curve
+ * \param[in]       adc: adc index
+ * \param[in]       code: dac code, with samples
+ * \param[out]      return: average adc code
+ */
+static double
+linearity_average(const linearity_t* curve, uint8_t adc, uint16_t code) {
+
+    return (double)curve->sum[adc][code] / curve->samples[adc][code];
+}
+
+/**
+ * \brief           nearest adc code of an average adc code
+ * \param[in]       average: average adc code
+ * \param[out]      return: adc code, 0 up to LINEARITY_CODE_NUM - 1
+ */
+static uint16_t
+linearity_round(double average) {
+
+    if (average <= 0) {
+        return 0;
+    }
+    if (average >= LINEARITY_CODE_NUM - 1) {
+        return LINEARITY_CODE_NUM - 1;
+    }
+
+    return (uint16_t)(average + 0.5);
+}
+
+/**
+ * \brief           initialise an empty transfer curve
+ * \param[in]       curve: transfer curve to initialise
+ * \param[in]       step: dac codes between the codes swept
+ * \param[in]       average: adc samples the card sums at each dac code
+ */
+void
+linearity_init(linearity_t* curve, uint16_t step, uint8_t average) {
+
+    memset(curve, 0, sizeof(*curve));
+    curve->step = step;
+    curve->average = average;
+}
+
+/**
+ * \brief           add the adc samples the card summed at one dac code
+ * \param[in]       curve: transfer curve
+ * \param[in]       adc: adc index, below LINEARITY_ADC_NUM
+ * \param[in]       code: dac code, below LINEARITY_CODE_NUM
+ * \param[in]       sum: sum of the adc codes
+ * \param[in]       samples: number of adc codes summed
+ */
+void
+linearity_add(linearity_t* curve, uint8_t adc, uint16_t code, uint32_t sum, uint32_t samples) {
+
+    if (adc < LINEARITY_ADC_NUM && code < LINEARITY_CODE_NUM) {
+        curve->sum[adc][code] += sum;
+        curve->samples[adc][code] += samples;
+    }
+}
+
+/**
+ * \brief           analyse the linearity of one adc from the transfer curve
+ * \note            inl is the distance of each average adc code from the best fit line, dnl the size of each step
+ *                  of the curve less the step of the line, both in LSB of the line. missing codes are counted only
+ *                  when every dac code was swept, a skipped dac code may be the one an adc code belongs to, and
+ *                  from one adc sample at each dac code. an average of samples can round to an adc code the adc
+ *                  never converted, from the codes next to it
+ * \param[in]       curve: transfer curve
+ * \param[in]       adc: adc index, below LINEARITY_ADC_NUM
+ * \param[out]      result: linearity of the adc
+ */
+void
+linearity_analyse(const linearity_t* curve, uint8_t adc, linearity_result_t* result) {
+
+    double n = 0;                    /* number of points as a double */
+    double sum_x = 0;                /* sum of the dac codes */
+    double sum_y = 0;                /* sum of the average adc codes */
+    double sum_xx = 0;               /* sum of the dac codes squared */
+    double sum_xy = 0;               /* sum of the dac codes times the average adc codes */
+    double slope;                    /* adc codes for each dac code of the best fit line */
+    double inl;                      /* distance of a point from the line */
+    double dnl;                      /* step between two points less the step of the line */
+    double average;                  /* average adc code of a point */
+    double previous = 0;             /* average adc code of the point before */
+    int32_t previous_code = -1;      /* dac code of the point before, -1 for none */
+    uint8_t dnl_num = 0;             /* a step was measured */
+    uint8_t raw = 1;                 /* each point is one adc sample, not an average */
+    uint16_t first = 0;              /* first dac code swept */
+    uint16_t last = 0;               /* adc code of the last dac code swept */
+    uint8_t hit[LINEARITY_CODE_NUM]; /* adc codes an average adc code rounds to */
+
+    memset(result, 0, sizeof(*result));
+    memset(hit, 0, sizeof(hit));
+    result->missing_codes = -1;
+
+    for (uint16_t code = 0; code < LINEARITY_CODE_NUM; code++) {
+
+        if (curve->samples[adc][code] == 0) {
+            continue;
+        }
+
+        average = linearity_average(curve, adc, code);
+        n++;
+        sum_x += code;
+        sum_y += average;
+        sum_xx += (double)code * code;
+        sum_xy += code * average;
+    }
+
+    result->points = (uint32_t)n;
+    if (result->points < 2 || n * sum_xx - sum_x * sum_x <= 0) {
+        return;
+    }
+
+    slope = (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
+    result->offset = (sum_y - slope * sum_x) / n;
+    result->gain_error = slope - 1;
+    if (slope <= 0) {
+        return;
+    }
+
+    for (uint16_t code = 0; code < LINEARITY_CODE_NUM; code++) {
+
+        if (curve->samples[adc][code] == 0) {
+            continue;
+        }
+
+        average = linearity_average(curve, adc, code);
+
+        inl = (average - (result->offset + slope * code)) / slope;
+        if (inl * inl > result->inl_max * result->inl_max) {
+            result->inl_max = inl;
+            result->inl_code = code;
+        }
+
+        if (previous_code >= 0) {
+
+            dnl = (average - previous) / (slope * (code - previous_code)) - 1;
+            if (dnl < result->dnl_min || dnl_num == 0) {
+                result->dnl_min = dnl;
+            }
+            if (dnl > result->dnl_max || dnl_num == 0) {
+                result->dnl_max = dnl;
+            }
+            dnl_num = 1;
+        } else {
+            first = code;
+        }
+
+        raw = raw && curve->samples[adc][code] == 1;
+        hit[linearity_round(average)] = 1;
+        last = linearity_round(average);
+        previous = average;
+        previous_code = code;
+    }
+
+    /* adc codes between the adc codes of the first and last dac codes, that no adc sample was converted to */
+    if (curve->step == 1 && raw) {
+
+        result->missing_codes = 0;
+        for (uint16_t code = linearity_round(linearity_average(curve, adc, first)); code < last; code++) {
+
+            if (!hit[code]) {
+                result->missing_codes++;
+            }
+        }
+    }
+}
+
+/**
+ * \brief           write the transfer curve as csv, the average adc code of each adc at each dac code swept
+ * \param[in]       curve: transfer curve
+ * \param[in]       fptr: curve file
+ */
+void
+linearity_write_curve(const linearity_t* curve, FILE* fptr) {
+
+    uint8_t swept; /* some adc has samples at the dac code */
+
+    fputs("dac_code", fptr);
+    for (uint8_t adc = 0; adc < LINEARITY_ADC_NUM; adc++) {
+        fprintf(fptr, ",adc%u", (unsigned int)adc + 1);
+    }
+    fputc('\n', fptr);
+
+    for (uint16_t code = 0; code < LINEARITY_CODE_NUM; code++) {
+
+        swept = 0;
+        for (uint8_t adc = 0; adc < LINEARITY_ADC_NUM; adc++) {
+            swept = swept || curve->samples[adc][code] > 0;
+        }
+        if (!swept) {
+            continue;
+        }
+
+        fprintf(fptr, "%u", (unsigned int)code);
+        for (uint8_t adc = 0; adc < LINEARITY_ADC_NUM; adc++) {
+
+            if (curve->samples[adc][code] > 0) {
+                fprintf(fptr, ",%.3f", linearity_average(curve, adc, code));
+            } else {
+                fputc(',', fptr);
+            }
+        }
+        fputc('\n', fptr);
+    }
+}
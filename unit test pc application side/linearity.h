@@ -0,0 +1,87 @@
+/**
+ * \file            linearity.h
+ * \brief           dac to adc transfer curve and linearity of a sweep test inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef LINEARITY
+#define LINEARITY
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * \brief                     codes of the 12 bit dac swept
+ * \hideinitializer
+ */
+#define LINEARITY_CODE_NUM       4096
+
+/**
+ * \brief                     adcs converting each dac code of a sweep
+ * \hideinitializer
+ */
+#define LINEARITY_ADC_NUM        3
+
+/**
+ * \brief            adc codes converted at each dac code of a sweep, added chunk by chunk as the replies arrive
+ */
+typedef struct linearity {
+
+    uint16_t step;                                           /*!< dac codes between the codes swept, 1 sweeps all */
+    uint8_t average;                                         /*!< adc samples the card sums at each dac code */
+    uint32_t sum[LINEARITY_ADC_NUM][LINEARITY_CODE_NUM];     /*!< sum of the adc codes at each dac code */
+    uint32_t samples[LINEARITY_ADC_NUM][LINEARITY_CODE_NUM]; /*!< adc samples summed at each dac code */
+
+} linearity_t;
+
+/**
+ * \brief            linearity of one adc, from the transfer curve of a sweep
+ * \note             in LSB of the adc. the best fit line is the least squares line of the average adc codes
+ *                   over the dac codes
+ */
+typedef struct linearity_result {
+
+    uint32_t points;       /*!< dac codes with adc samples, 0 if nothing to analyse */
+    double offset;         /*!< adc code of dac code 0 of the best fit line */
+    double gain_error;     /*!< slope of the best fit line less 1 */
+    double inl_max;        /*!< integral non linearity furthest from 0, distance from the best fit line */
+    uint16_t inl_code;     /*!< dac code of inl_max */
+    double dnl_min;        /*!< smallest differential non linearity, -1 is a step with no change */
+    double dnl_max;        /*!< biggest differential non linearity */
+    int32_t missing_codes; /*!< adc codes between the first and last adc code never converted, -1 if not
+                                measured, the sweep skipped dac codes or averaged the adc samples */
+
+} linearity_result_t;
+
+void linearity_init(linearity_t* curve, uint16_t step, uint8_t average);
+void linearity_add(linearity_t* curve, uint8_t adc, uint16_t code, uint32_t sum, uint32_t samples);
+void linearity_analyse(const linearity_t* curve, uint8_t adc, linearity_result_t* result);
+void linearity_write_curve(const linearity_t* curve, FILE* fptr);
+
+#endif /* LINEARITY */
@@ -33,87 +33,35 @@
 #include "main.h"
 
 /**
- * \brief  holds library resources for unit test      
+ * \brief  holds the application configuration, cards to test and their settings
  */
-unit_test_pack_t my_test;
+run_config_t my_run;
 
 /**
  * \brief           unit testing application main function
+ * \param[in]       argc: argument count
+ * \param[in]       argv: argument vector, cards addresses and ports. see print_usage
  * \param[out]      return: software error massage
  */
 int
-main() {
+main(int argc, char* argv[]) {
 
     int check;
 
-    testing_thread_function_init(&my_test, testing_thread);
-
-    check = create_app_init_socket(&my_test);
-    if (check != ERROR_OK) {
-        return check;
-    }
-
-    check = request_card_id(&my_test);
-
-    if (check != ERROR_OK) {
-        return check;
-    }
-
-    check = print_card_name_and_id(&my_test);
-
+    check = parse_command_line(&my_run, argc, argv);
     if (check != ERROR_OK) {
         return check;
     }
 
-    check = request_test_list_size(&my_test);
+    check = run_cards_simultaneously(&my_run, testing_thread);
 
     if (check != ERROR_OK) {
         return check;
     }
 
-    check = allocate_test_list_mem(&my_test);
-
-    if (check != ERROR_OK) {
-        return check;
-    }
-
-    check = read_and_fill_test_list_from_stm(&my_test);
-
-    if (check != ERROR_OK) {
-        return check;
-    }
-
-    check = allocating_testing_threads_handles(&my_test);
-
-    if (check != ERROR_OK) {
-        return check;
-    }
-
-    check = initialising_testing_threads_input(&my_test);
-
-    if (check != ERROR_OK) {
-        return check;
-    }
-
-    check = creating_and_joining_testing_threads(&my_test);
-
-    if (check != ERROR_OK) {
-        return check;
-    }
-
-    check = generate_result_file(my_test.test_raw_results_list, my_test.list_len, &my_test.card_id_in);
-
-    if (check != ERROR_OK) {
-        return check;
-    }
-
-    close_test_threads_sockets(&my_test);
-
-    free_allocated_recurses(&my_test);
-
     printf("program end\n");
 
     //while(1){}
 
     return ERROR_OK;
-}
\ No newline at end of file
+}
@@ -33,6 +33,9 @@
 #ifndef INC_MAIN
 #define INC_MAIN
 
+#include "cards.h"
+#include "config.h"
+#include "event_loop.h"
 #include "threads.h"
 #include "unit_test_lib.h"
 
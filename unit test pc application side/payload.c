@@ -0,0 +1,267 @@
+/**
+ * \file            payload.c
+ * \brief           test payload generator src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "payload.h"
+#include <string.h>
+
+/**
+ * \brief           names of the patterns, in the configuration and the results
+ */
+static const char* const pattern_name[PAYLOAD_PATTERN_NUM] = {
+    "random", "prbs7", "prbs15", "prbs31", "walking1", "walking0", "zeros", "ones", "alternating", "counting"};
+
+/**
+ * \brief           splitmix64, spreads a seed over the xoshiro256** state
+ * \param[in]       state: splitmix64 state, advanced by the function
+ * \param[out]      return: next value
+ */
+static uint64_t
+splitmix64(uint64_t* state) {
+
+    uint64_t value; /* value mixed */
+
+    *state += 0x9E3779B97F4A7C15ull;
+    value = *state;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+    return value ^ (value >> 31);
+}
+
+/**
+ * \brief           rotate a 64 bit word left
+ * \param[in]       value: word to rotate
+ * \param[in]       shift: number of bits, 1 to 63
+ * \param[out]      return: rotated word
+ */
+static inline uint64_t
+rotate_left(uint64_t value, int shift) {
+
+    return (value << shift) | (value >> (64 - shift));
+}
+
+/**
+ * \brief           xoshiro256** next random word
+ * \param[in]       rng: xoshiro256** state
+ * \param[out]      return: random word
+ */
+static uint64_t
+xoshiro256_next(uint64_t* rng) {
+
+    uint64_t result = rotate_left(rng[1] * 5, 7) * 9; /* random word */
+    uint64_t t = rng[1] << 17;                         /* state mixing */
+
+    rng[2] ^= rng[0];
+    rng[3] ^= rng[1];
+    rng[1] ^= rng[2];
+    rng[0] ^= rng[3];
+    rng[2] ^= t;
+    rng[3] = rotate_left(rng[3], 45);
+
+    return result;
+}
+
+/**
+ * \brief           next byte of a PRBS, most significant bit first
+ * \param[in]       prbs: shift register, advanced by 8 bits
+ * \param[in]       length: polynomial degree, the register length
+ * \param[in]       tap: second polynomial term
+ * \param[out]      return: next 8 bits of the sequence
+ */
+static uint8_t
+prbs_byte(uint32_t* prbs, uint8_t length, uint8_t tap) {
+
+    uint8_t byte = 0; /* bits generated */
+    uint32_t bit;     /* next bit */
+
+    for (uint8_t i = 0; i < 8; i++) {
+
+        bit = ((*prbs >> (length - 1)) ^ (*prbs >> (tap - 1))) & 1;
+        *prbs = ((*prbs << 1) | bit) & (uint32_t)((1ull << length) - 1);
+        byte = (uint8_t)((byte << 1) | bit);
+    }
+
+    return byte;
+}
+
+/**
+ * \brief           generate the next bytes of the generator pattern
+ * \param[in]       generator: payload generator
+ * \param[out]      data: buffer to fill
+ * \param[in]       size: number of bytes
+ */
+static void
+payload_generate(payload_generator_t* generator, uint8_t* data, size_t size) {
+
+    uint64_t word; /* random word */
+
+    switch (generator->pattern) {
+
+        case PAYLOAD_RANDOM:
+
+            /* a whole random word at a time */
+            for (size_t i = 0; i < size; i += sizeof(word)) {
+
+                word = xoshiro256_next(generator->rng);
+                memcpy(&data[i], &word, size - i < sizeof(word) ? size - i : sizeof(word));
+            }
+            break;
+
+        case PAYLOAD_PRBS7:
+            for (size_t i = 0; i < size; i++) {
+                data[i] = prbs_byte(&generator->prbs, 7, 6);
+            }
+            break;
+
+        case PAYLOAD_PRBS15:
+            for (size_t i = 0; i < size; i++) {
+                data[i] = prbs_byte(&generator->prbs, 15, 14);
+            }
+            break;
+
+        case PAYLOAD_PRBS31:
+            for (size_t i = 0; i < size; i++) {
+                data[i] = prbs_byte(&generator->prbs, 31, 28);
+            }
+            break;
+
+        case PAYLOAD_WALKING_ONES:
+            for (size_t i = 0; i < size; i++) {
+                data[i] = (uint8_t)(1 << (generator->phase++ % 8));
+            }
+            break;
+
+        case PAYLOAD_WALKING_ZEROS:
+            for (size_t i = 0; i < size; i++) {
+                data[i] = (uint8_t)~(1 << (generator->phase++ % 8));
+            }
+            break;
+
+        case PAYLOAD_ZEROS: memset(data, 0x00, size); break;
+
+        case PAYLOAD_ONES: memset(data, 0xFF, size); break;
+
+        case PAYLOAD_ALTERNATING:
+            for (size_t i = 0; i < size; i++) {
+                data[i] = (generator->phase++ & 1) ? 0xAA : 0x55;
+            }
+            break;
+
+        default:
+            for (size_t i = 0; i < size; i++) {
+                data[i] = generator->phase++;
+            }
+            break;
+    }
+}
+
+/**
+ * \brief           initialise the payload generator of a testing thread and fill its pool
+ * \note            the same pattern, seed and stream always generate the same payloads
+ * \param[in]       generator: payload generator
+ * \param[in]       pattern: payload_pattern_t
+ * \param[in]       seed: seed of the run
+ * \param[in]       stream: testing thread index, each thread gets its own random sequence
+ */
+void
+payload_init(payload_generator_t* generator, uint8_t pattern, uint64_t seed, uint32_t stream) {
+
+    uint64_t state = seed ^ ((uint64_t)stream << 32); /* splitmix64 state */
+
+    generator->pattern = pattern;
+    for (uint8_t i = 0; i < 4; i++) {
+        generator->rng[i] = splitmix64(&state);
+    }
+
+    /* the PRBS register starts with all ones, like PRBS test equipment */
+    generator->prbs = 0xFFFFFFFF;
+    generator->phase = 0;
+    generator->offset = 0;
+
+    payload_generate(generator, generator->pool, sizeof(generator->pool));
+}
+
+/**
+ * \brief           copy the next payload of a testing thread
+ * \note            the payloads follow each other in the pattern, the pool is refilled when it is used up
+ * \param[in]       generator: payload generator of the thread
+ * \param[out]      data: payload
+ * \param[in]       size: payload size, up to PAYLOAD_POOL_SIZE
+ */
+void
+payload_fill(payload_generator_t* generator, uint8_t* data, uint16_t size) {
+
+    size_t left = sizeof(generator->pool) - generator->offset; /* pool bytes not used yet */
+
+    if (size > left) {
+
+        /* keep the bytes not used yet, so the pattern goes on without a gap */
+        memmove(generator->pool, &generator->pool[generator->offset], left);
+        payload_generate(generator, &generator->pool[left], sizeof(generator->pool) - left);
+        generator->offset = 0;
+    }
+
+    memcpy(data, &generator->pool[generator->offset], size);
+    generator->offset += size;
+}
+
+/**
+ * \brief           parse a pattern name
+ * \param[in]       text: pattern name
+ * \param[out]      pattern_out: payload_pattern_t
+ * \param[out]      return: 0 if the name is known, 1 otherwise
+ */
+uint8_t
+payload_pattern_parse(const char* text, uint8_t* pattern_out) {
+
+    for (uint8_t i = 0; i < PAYLOAD_PATTERN_NUM; i++) {
+
+        if (strcmp(text, pattern_name[i]) == 0) {
+
+            *pattern_out = i;
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * \brief           name of a pattern
+ * \param[in]       pattern: payload_pattern_t
+ * \param[out]      return: pattern name
+ */
+const char*
+payload_pattern_name(uint8_t pattern) {
+
+    return pattern < PAYLOAD_PATTERN_NUM ? pattern_name[pattern] : "unknown";
+}
@@ -0,0 +1,86 @@
+/**
+ * \file            payload.h
+ * \brief           test payload generator inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef PAYLOAD
+#define PAYLOAD
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \brief                     bytes generated ahead for each testing thread, payloads are copied from them
+ * \hideinitializer
+ */
+#define PAYLOAD_POOL_SIZE        8192
+
+/**
+ * \brief           test data patterns
+ * \note            signal integrity failures depend on the data, the fixed patterns stress the lines in a known way
+ */
+typedef enum payload_pattern {
+
+    PAYLOAD_RANDOM,        /*!< xoshiro256** random bytes, repeated by running with the same seed */
+    PAYLOAD_PRBS7,         /*!< x^7 + x^6 + 1 pseudo random bit sequence */
+    PAYLOAD_PRBS15,        /*!< x^15 + x^14 + 1 pseudo random bit sequence */
+    PAYLOAD_PRBS31,        /*!< x^31 + x^28 + 1 pseudo random bit sequence */
+    PAYLOAD_WALKING_ONES,  /*!< 0x01 0x02 0x04 ... 0x80 */
+    PAYLOAD_WALKING_ZEROS, /*!< 0xFE 0xFD 0xFB ... 0x7F */
+    PAYLOAD_ZEROS,         /*!< all 0x00 */
+    PAYLOAD_ONES,          /*!< all 0xFF */
+    PAYLOAD_ALTERNATING,   /*!< 0x55 0xAA */
+    PAYLOAD_COUNTING,      /*!< 0x00 0x01 ... 0xFF */
+    PAYLOAD_PATTERN_NUM    /*!< number of patterns */
+
+} payload_pattern_t;
+
+/**
+ * \brief            test data generator of one testing thread
+ * \note             not shared between threads, so it needs no lock. the pool is refilled a whole word at a time
+ *                   when the payloads used it up, so sending a test request only copies bytes
+ */
+typedef struct payload_generator {
+
+    uint8_t pattern;                 /*!< payload_pattern_t */
+    uint64_t rng[4];                 /*!< xoshiro256** state */
+    uint32_t prbs;                   /*!< PRBS shift register */
+    uint8_t phase;                   /*!< position of the next byte in the fixed patterns */
+    uint16_t offset;                 /*!< next pool byte to copy */
+    uint8_t pool[PAYLOAD_POOL_SIZE]; /*!< bytes generated ahead */
+
+} payload_generator_t;
+
+void payload_init(payload_generator_t* generator, uint8_t pattern, uint64_t seed, uint32_t stream);
+void payload_fill(payload_generator_t* generator, uint8_t* data, uint16_t size);
+uint8_t payload_pattern_parse(const char* text, uint8_t* pattern_out);
+const char* payload_pattern_name(uint8_t pattern);
+
+#endif /* PAYLOAD */
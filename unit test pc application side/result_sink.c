@@ -0,0 +1,715 @@
+/**
+ * \file            result_sink.c
+ * \brief           result file formats, text json lines and csv src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#include "result_sink.h"
+
+/**
+ * \brief           names of the test phases in the results files
+ */
+static const char* const phase_name[TEST_PHASE_NUM] = {"tx start", "rx done", "task wake"};
+
+/**
+ * \brief           names of the test phases in json and csv keys
+ */
+static const char* const phase_key[TEST_PHASE_NUM] = {"tx_start", "rx_done", "task_wake"};
+
+/**
+ * \brief           length of a string sent by the card, that may fill its array with no '\0' at the end
+ * \param[in]       text: string
+ * \param[in]       size: size of the string array
+ * \param[out]      return: string length
+ */
+static int
+card_string_len(const uint8_t* text, size_t size) {
+
+    const uint8_t* end = memchr(text, '\0', size); /* end of the string */
+
+    return end == NULL ? (int)size : (int)(end - text);
+}
+
+/**
+ * \brief           name of a test evaluation criteria
+ * \param[in]       criteria: test criteria
+ * \param[out]      return: criteria name
+ */
+static const char*
+criteria_name(uint8_t criteria) {
+
+    switch (criteria) {
+        case COMMUNICATION_criteria: return "communication";
+        case ADC_criteria: return "adc";
+        case LINEARITY_criteria: return "linearity";
+        case BUS_criteria: return "bus";
+        case STREAM_criteria: return "stream";
+        default: return "unknown";
+    }
+}
+
+/**
+ * \brief           name of a test mode
+ * \param[in]       pulling_or_it: PULLING_MODE or IT_MODE
+ * \param[out]      return: mode name
+ */
+static const char*
+mode_name(uint8_t pulling_or_it) {
+
+    return pulling_or_it == PULLING_MODE ? "pulling" : "it";
+}
+
+/**
+ * \brief           name of a test, without the '#' or ' ' the card puts in front of it
+ * \param[in]       test: test information
+ * \param[out]      name_len: length of the name, the card may not end the name with '\0'
+ * \param[out]      return: test name
+ */
+static const char*
+test_name(const linux_app_test_setting_t* test, int* name_len) {
+
+    *name_len = card_string_len(&test->test_name[1], sizeof(test->test_name) - 1);
+
+    return (const char*)&test->test_name[1];
+}
+
+/**
+ * \brief           convert an analog error from LSB to mV of the reference voltage
+ * \param[in]       summary: test results summary, holding the reference voltage
+ * \param[in]       lsb: error in LSB
+ * \param[out]      return: error in mV
+ */
+static double
+lsb_to_mv(const test_summary_t* summary, double lsb) {
+
+    return lsb * summary->vref_mv / (ADC_CODE_MAX + 1);
+}
+
+/**
+ * \brief           write the bit errors of one test in the text format, where they are and how they look
+ * \param[in]       fptr: results file
+ * \param[in]       summary: test results summary
+ */
+static void
+text_write_bit_errors(FILE* fptr, const test_summary_t* summary) {
+
+    fprintf(fptr, " bit errors = %" PRIu64 "/%" PRIu64 ". BER = %.3e.", summary->bit_errors, summary->bits_compared,
+            (double)summary->bit_errors / (double)summary->bits_compared);
+
+    if (summary->mismatch_num == 0) {
+        return;
+    }
+
+    fprintf(fptr, "\n bit errors: first at byte %u. flips 0->1 bit 7..0 =", (unsigned int)summary->first_error);
+    for (int bit = BITS_IN_BYTE - 1; bit >= 0; bit--) {
+        fprintf(fptr, " %" PRIu32, summary->flip_to_one_num[bit]);
+    }
+    fputs(". flips 1->0 bit 7..0 =", fptr);
+    for (int bit = BITS_IN_BYTE - 1; bit >= 0; bit--) {
+        fprintf(fptr, " %" PRIu32, summary->flip_to_zero_num[bit]);
+    }
+    fprintf(fptr, ". shifted one bit early = %" PRIu32 "/%" PRIu32 ". late = %" PRIu32 "/%" PRIu32 ".",
+            summary->shift_left_num, summary->mismatch_num, summary->shift_right_num, summary->mismatch_num);
+
+    /* the signature of a bad data line */
+    for (int bit = BITS_IN_BYTE - 1; bit >= 0; bit--) {
+
+        if ((summary->stuck_high >> bit) & 1) {
+            fprintf(fptr, " bit %d stuck high.", bit);
+        } else if ((summary->stuck_low >> bit) & 1) {
+            fprintf(fptr, " bit %d stuck low.", bit);
+        }
+    }
+}
+
+/**
+ * \brief           write the linearity of each adc of a sweep test, a line for each adc
+ * \param[in]       fptr: results file
+ * \param[in]       summary: test results summary of a sweep test
+ */
+static void
+text_write_linearity(FILE* fptr, const test_summary_t* summary) {
+
+    linearity_result_t result; /* linearity of an adc */
+
+    for (uint8_t adc = 0; adc < LINEARITY_ADC_NUM; adc++) {
+
+        linearity_analyse(summary->linearity, adc, &result);
+
+        fprintf(fptr,
+                "\n adc%u linearity points = %" PRIu32 ". offset = %.2f LSB. gain error = %.3f%%. INL = %.2f LSB"
+                " at code %u. DNL = %.2f/%.2f LSB.",
+                (unsigned int)adc + 1, result.points, result.offset, result.gain_error * 100, result.inl_max,
+                (unsigned int)result.inl_code, result.dnl_min, result.dnl_max);
+
+        if (result.missing_codes >= 0) {
+            fprintf(fptr, " missing codes = %" PRId32 ".", result.missing_codes);
+        } else {
+            fputs(" missing codes not measured, the sweep skipped dac codes or averaged the adc samples.", fptr);
+        }
+    }
+}
+
+/**
+ * \brief           write the results of one test in the text format, one sentence for each test
+ * \param[in]       fptr: results file
+ * \param[in]       card: card name and id, written in the file name only
+ * \param[in]       summary: test results summary
+ */
+static void
+text_write_test(FILE* fptr, const card_name_and_id_t* card, const test_summary_t* summary) {
+
+    char latency_text[TXT_TRANSFER_SIZE]; /* latency statistics text */
+    const char* name;                     /* test name */
+    int name_len;                         /* test name length */
+
+    (void)card;
+    name = test_name(summary->test, &name_len);
+
+    fprintf(fptr,
+            "test %.*s data match = %" PRIu32 "/%" PRIu32 ".  average time elapsed =  %6.3fms. over time error = "
+            "%" PRIu32 "/%" PRIu32 ". error interrupt = %" PRIu32 "/%" PRIu32 ". HAL return error = %" PRIu32
+            "/%" PRIu32 ". lost = %" PRIu32 "/%" PRIu32 ".",
+            name_len, name, summary->iterations, summary->success_num, (double)summary->avr_time_elapsed / NS_TO_MS,
+            summary->iterations, summary->over_time_error_num, summary->iterations, summary->interrupt_error_num,
+            summary->iterations, summary->return_error_num, summary->iterations, summary->lost_num);
+
+    /* the time the card ran the test function, the rest of the time elapsed is network and card queue time */
+    if (summary->avr_card_time != NO_SUCCESS) {
+
+        fprintf(fptr, " card time = %6.3fms. transport overhead = %6.3fms.",
+                (double)summary->avr_card_time / NS_TO_MS,
+                (double)(summary->avr_time_elapsed > summary->avr_card_time
+                             ? summary->avr_time_elapsed - summary->avr_card_time
+                             : 0)
+                    / NS_TO_MS);
+    }
+
+    /* average time from the test start to each phase the test marked */
+    for (uint8_t phase = 0; phase < TEST_PHASE_NUM; phase++) {
+
+        if (summary->phase_num[phase] > 0) {
+            fprintf(fptr, " %s = %6.3fms.", phase_name[phase], (double)summary->avr_phase_time[phase] / NS_TO_MS);
+        }
+    }
+
+    fprintf(fptr, " data pattern = %s seed = %" PRIu64 ".", payload_pattern_name(summary->pattern), summary->seed);
+
+    if (summary->bits_compared > 0) {
+        text_write_bit_errors(fptr, summary);
+    }
+
+    /* analog accuracy, of the best fit line of the adc codes over the dac codes */
+    if (summary->analog_samples > 0) {
+
+        fprintf(fptr,
+                "\n analog samples = %" PRIu64 ". out of tolerance (+-%u LSB) = %" PRIu64 "/%" PRIu64
+                ". offset = %.2f LSB (%.2fmV). gain error = %.3f%%. noise = %.2f LSB rms (%.2fmV)."
+                " max error = %d LSB (%.2fmV).",
+                summary->analog_samples, (unsigned int)summary->adc_tolerance, summary->analog_samples,
+                summary->out_of_tolerance, summary->offset, lsb_to_mv(summary, summary->offset),
+                summary->gain_error * 100, summary->noise, lsb_to_mv(summary, summary->noise),
+                (int)summary->max_error, lsb_to_mv(summary, summary->max_error));
+    }
+
+    /* integral and differential non linearity, from the transfer curve of a sweep */
+    if (summary->linearity != NULL) {
+        text_write_linearity(fptr, summary);
+    }
+
+    /* frame rate and bus load over the bus time of the frames, and the time from queuing a frame to receiving it */
+    if (summary->bus_frames > 0) {
+
+        fprintf(fptr,
+                "\n bus frames = %" PRIu64 ". frames/s = %.0f. bus load = %.1f%%. frame latency = %6.3fms average,"
+                " %6.3fms max.",
+                summary->bus_frames, summary->frames_per_sec, summary->bus_load * 100,
+                (double)summary->avr_frame_latency / NS_TO_MS, (double)summary->max_frame_latency / NS_TO_MS);
+    }
+
+    /* bytes the card streamed and checked, over the stream time */
+    if (summary->stream_bytes > 0) {
+
+        fprintf(fptr, "\n stream bytes = %" PRIu64 ". throughput = %.3f MB/s. error blocks = %" PRIu64 ".",
+                summary->stream_bytes, summary->stream_mb_per_sec, summary->stream_error_blocks);
+    }
+
+    /* time elapsed distribution of the successful tests */
+    if (summary->latency->count > 0) {
+
+        latency_stats_print(summary->latency, latency_text, sizeof(latency_text));
+        fprintf(fptr, "\n %s", latency_text);
+    }
+
+    fputs("\n\n ", fptr);
+}
+
+/**
+ * \brief           write a json string, escaping the characters json does not allow in strings
+ * \param[in]       fptr: results file
+ * \param[in]       text: string
+ * \param[in]       text_len: string length
+ */
+static void
+json_write_string(FILE* fptr, const char* text, int text_len) {
+
+    fputc('"', fptr);
+
+    for (int i = 0; i < text_len; i++) {
+
+        if (text[i] == '"' || text[i] == '\\') {
+            fprintf(fptr, "\\%c", text[i]);
+        } else if ((unsigned char)text[i] < 0x20) {
+            fprintf(fptr, "\\u%04x", (unsigned int)(unsigned char)text[i]);
+        } else {
+            fputc(text[i], fptr);
+        }
+    }
+
+    fputc('"', fptr);
+}
+
+/**
+ * \brief           write the results of one test as one json object on one line
+ * \note            times are in ns. phases the test did not mark and the card time of a card that does not
+ *                  time the tests are null
+ * \param[in]       fptr: results file
+ * \param[in]       card: card name and id
+ * \param[in]       summary: test results summary
+ */
+static void
+jsonl_write_test(FILE* fptr, const card_name_and_id_t* card, const test_summary_t* summary) {
+
+    const char* name;             /* test name */
+    int name_len;                 /* test name length */
+    linearity_result_t linearity; /* linearity of an adc of a sweep test */
+
+    name = test_name(summary->test, &name_len);
+
+    fprintf(fptr, "{\"uid\":[%" PRIu32 ",%" PRIu32 ",%" PRIu32 "],\"part_number\":", card->id[0], card->id[1],
+            card->id[2]);
+    json_write_string(fptr, (const char*)card->board_part_number,
+                      card_string_len(card->board_part_number, sizeof(card->board_part_number)));
+    fputs(",\"test\":", fptr);
+    json_write_string(fptr, name, name_len);
+
+    fprintf(fptr,
+            ",\"criteria\":\"%s\",\"mode\":\"%s\",\"payload_size\":%u,\"pattern\":\"%s\",\"seed\":%" PRIu64
+            ",\"iterations\":%" PRIu32 ",\"data_match\":%" PRIu32 ",\"over_time\":%" PRIu32
+            ",\"error_interrupt\":%" PRIu32 ",\"hal_error\":%" PRIu32 ",\"lost\":%" PRIu32 ",\"avg_ns\":%" PRIu64,
+            criteria_name(summary->test->criteria), mode_name(summary->test->pulling_or_it),
+            (unsigned int)summary->test->payload_size, payload_pattern_name(summary->pattern), summary->seed,
+            summary->iterations, summary->success_num, summary->over_time_error_num, summary->interrupt_error_num,
+            summary->return_error_num, summary->lost_num, summary->avr_time_elapsed);
+
+    if (summary->avr_card_time != NO_SUCCESS) {
+        fprintf(fptr, ",\"card_ns\":%" PRIu64 ",\"transport_ns\":%" PRIu64, summary->avr_card_time,
+                summary->avr_time_elapsed > summary->avr_card_time
+                    ? summary->avr_time_elapsed - summary->avr_card_time
+                    : 0);
+    } else {
+        fputs(",\"card_ns\":null,\"transport_ns\":null", fptr);
+    }
+
+    for (uint8_t phase = 0; phase < TEST_PHASE_NUM; phase++) {
+
+        if (summary->phase_num[phase] > 0) {
+            fprintf(fptr, ",\"%s_ns\":%" PRIu64, phase_key[phase], summary->avr_phase_time[phase]);
+        } else {
+            fprintf(fptr, ",\"%s_ns\":null", phase_key[phase]);
+        }
+    }
+
+    /* bit errors, the ber and the first error are null if no data was compared bit by bit */
+    fprintf(fptr, ",\"bits\":%" PRIu64 ",\"bit_errors\":%" PRIu64, summary->bits_compared, summary->bit_errors);
+    if (summary->bits_compared > 0) {
+        fprintf(fptr, ",\"ber\":%.6e", (double)summary->bit_errors / (double)summary->bits_compared);
+    } else {
+        fputs(",\"ber\":null", fptr);
+    }
+    if (summary->bit_errors > 0) {
+        fprintf(fptr, ",\"first_error_byte\":%u", (unsigned int)summary->first_error);
+    } else {
+        fputs(",\"first_error_byte\":null", fptr);
+    }
+    fputs(",\"flips_to_one\":[", fptr);
+    for (uint8_t bit = 0; bit < BITS_IN_BYTE; bit++) {
+        fprintf(fptr, "%s%" PRIu32, bit == 0 ? "" : ",", summary->flip_to_one_num[bit]);
+    }
+    fputs("],\"flips_to_zero\":[", fptr);
+    for (uint8_t bit = 0; bit < BITS_IN_BYTE; bit++) {
+        fprintf(fptr, "%s%" PRIu32, bit == 0 ? "" : ",", summary->flip_to_zero_num[bit]);
+    }
+    fprintf(fptr,
+            "],\"shifted_early\":%" PRIu32 ",\"shifted_late\":%" PRIu32 ",\"stuck_high\":%u,\"stuck_low\":%u",
+            summary->shift_left_num, summary->shift_right_num, (unsigned int)summary->stuck_high,
+            (unsigned int)summary->stuck_low);
+
+    /* analog accuracy, null if the test is not analog */
+    if (summary->analog_samples > 0) {
+        fprintf(fptr,
+                ",\"analog_samples\":%" PRIu64 ",\"out_of_tolerance\":%" PRIu64 ",\"adc_tolerance_lsb\":%u"
+                ",\"offset_lsb\":%.3f,\"offset_mv\":%.3f,\"gain_error_pct\":%.4f,\"noise_lsb\":%.3f"
+                ",\"noise_mv\":%.3f,\"max_error_lsb\":%d",
+                summary->analog_samples, summary->out_of_tolerance, (unsigned int)summary->adc_tolerance,
+                summary->offset, lsb_to_mv(summary, summary->offset), summary->gain_error * 100, summary->noise,
+                lsb_to_mv(summary, summary->noise), (int)summary->max_error);
+    } else {
+        fputs(",\"analog_samples\":0,\"out_of_tolerance\":null,\"adc_tolerance_lsb\":null,\"offset_lsb\":null"
+              ",\"offset_mv\":null,\"gain_error_pct\":null,\"noise_lsb\":null,\"noise_mv\":null"
+              ",\"max_error_lsb\":null",
+              fptr);
+    }
+
+    /* linearity of each adc, null if the test is not a sweep */
+    if (summary->linearity != NULL) {
+
+        fputs(",\"linearity\":[", fptr);
+
+        for (uint8_t adc = 0; adc < LINEARITY_ADC_NUM; adc++) {
+
+            linearity_analyse(summary->linearity, adc, &linearity);
+
+            fprintf(fptr,
+                    "%s{\"points\":%" PRIu32 ",\"offset_lsb\":%.3f,\"gain_error_pct\":%.4f,\"inl_lsb\":%.3f"
+                    ",\"inl_code\":%u,\"dnl_min_lsb\":%.3f,\"dnl_max_lsb\":%.3f,\"missing_codes\":",
+                    adc == 0 ? "" : ",", linearity.points, linearity.offset, linearity.gain_error * 100,
+                    linearity.inl_max, (unsigned int)linearity.inl_code, linearity.dnl_min, linearity.dnl_max);
+
+            if (linearity.missing_codes >= 0) {
+                fprintf(fptr, "%" PRId32 "}", linearity.missing_codes);
+            } else {
+                fputs("null}", fptr);
+            }
+        }
+
+        fputc(']', fptr);
+    } else {
+        fputs(",\"linearity\":null", fptr);
+    }
+
+    /* bus statistics, null if the test is not a bus test */
+    if (summary->bus_frames > 0) {
+        fprintf(fptr,
+                ",\"bus_frames\":%" PRIu64 ",\"frames_per_sec\":%.1f,\"bus_load_pct\":%.2f"
+                ",\"frame_latency_ns\":%" PRIu64 ",\"frame_latency_max_ns\":%" PRIu64,
+                summary->bus_frames, summary->frames_per_sec, summary->bus_load * 100, summary->avr_frame_latency,
+                summary->max_frame_latency);
+    } else {
+        fputs(",\"bus_frames\":0,\"frames_per_sec\":null,\"bus_load_pct\":null,\"frame_latency_ns\":null"
+              ",\"frame_latency_max_ns\":null",
+              fptr);
+    }
+
+    /* stream statistics, null if the test is not a stream test */
+    if (summary->stream_bytes > 0) {
+        fprintf(fptr, ",\"stream_bytes\":%" PRIu64 ",\"stream_mb_per_sec\":%.3f,\"stream_error_blocks\":%" PRIu64,
+                summary->stream_bytes, summary->stream_mb_per_sec, summary->stream_error_blocks);
+    } else {
+        fputs(",\"stream_bytes\":0,\"stream_mb_per_sec\":null,\"stream_error_blocks\":null", fptr);
+    }
+
+    fprintf(fptr,
+            ",\"min_ns\":%" PRIu64 ",\"p50_ns\":%" PRIu64 ",\"p90_ns\":%" PRIu64 ",\"p99_ns\":%" PRIu64
+            ",\"p99_9_ns\":%" PRIu64 ",\"max_ns\":%" PRIu64 ",\"stddev_ns\":%" PRIu64 ",\"histogram\":{",
+            summary->latency->min, latency_stats_percentile(summary->latency, 50),
+            latency_stats_percentile(summary->latency, 90), latency_stats_percentile(summary->latency, 99),
+            latency_stats_percentile(summary->latency, 99.9), summary->latency->max,
+            latency_stats_stddev(summary->latency));
+
+    for (uint8_t i = 0; i < LATENCY_DECADE_NUM; i++) {
+
+        fprintf(fptr, "%s\"%s\":%" PRIu32, i == 0 ? "" : ",", latency_stats_decade_name(i),
+                summary->latency->decade[i]);
+    }
+
+    fputs("}}\n", fptr);
+}
+
+/**
+ * \brief           write a csv field, quoted, with the quotes in it doubled
+ * \param[in]       fptr: results file
+ * \param[in]       text: field text
+ * \param[in]       text_len: field text length
+ */
+static void
+csv_write_string(FILE* fptr, const char* text, int text_len) {
+
+    fputc('"', fptr);
+
+    for (int i = 0; i < text_len; i++) {
+
+        if (text[i] == '"') {
+            fputc('"', fptr);
+        }
+        fputc(text[i], fptr);
+    }
+
+    fputc('"', fptr);
+}
+
+/**
+ * \brief           write the csv header line, the column names
+ * \param[in]       fptr: results file
+ */
+static void
+csv_begin(FILE* fptr) {
+
+    fputs("uid0,uid1,uid2,part_number,test,criteria,mode,payload_size,pattern,seed,iterations,data_match,over_time,"
+          "error_interrupt,hal_error,lost,avg_ns,card_ns,transport_ns",
+          fptr);
+
+    for (uint8_t phase = 0; phase < TEST_PHASE_NUM; phase++) {
+
+        fprintf(fptr, ",%s_ns", phase_key[phase]);
+    }
+
+    fputs(",bits,bit_errors,ber,first_error_byte", fptr);
+    for (uint8_t bit = 0; bit < BITS_IN_BYTE; bit++) {
+        fprintf(fptr, ",flips_to_one bit %u", (unsigned int)bit);
+    }
+    for (uint8_t bit = 0; bit < BITS_IN_BYTE; bit++) {
+        fprintf(fptr, ",flips_to_zero bit %u", (unsigned int)bit);
+    }
+    fputs(",shifted_early,shifted_late,stuck_high,stuck_low", fptr);
+    fputs(",analog_samples,out_of_tolerance,adc_tolerance_lsb,offset_lsb,offset_mv,gain_error_pct,noise_lsb,noise_mv,"
+          "max_error_lsb",
+          fptr);
+
+    for (uint8_t adc = 1; adc <= LINEARITY_ADC_NUM; adc++) {
+
+        fprintf(fptr,
+                ",adc%u_offset_lsb,adc%u_gain_error_pct,adc%u_inl_lsb,adc%u_dnl_min_lsb,adc%u_dnl_max_lsb,"
+                "adc%u_missing_codes",
+                (unsigned int)adc, (unsigned int)adc, (unsigned int)adc, (unsigned int)adc, (unsigned int)adc,
+                (unsigned int)adc);
+    }
+
+    fputs(",bus_frames,frames_per_sec,bus_load_pct,frame_latency_ns,frame_latency_max_ns", fptr);
+    fputs(",stream_bytes,stream_mb_per_sec,stream_error_blocks", fptr);
+    fputs(",min_ns,p50_ns,p90_ns,p99_ns,p99_9_ns,max_ns,stddev_ns", fptr);
+
+    for (uint8_t i = 0; i < LATENCY_DECADE_NUM; i++) {
+
+        fprintf(fptr, ",histogram %s", latency_stats_decade_name(i));
+    }
+
+    fputc('\n', fptr);
+}
+
+/**
+ * \brief           write the results of one test as one csv line
+ * \note            times are in ns. phases the test did not mark and the card time of a card that does not
+ *                  time the tests are empty
+ * \param[in]       fptr: results file
+ * \param[in]       card: card name and id
+ * \param[in]       summary: test results summary
+ */
+static void
+csv_write_test(FILE* fptr, const card_name_and_id_t* card, const test_summary_t* summary) {
+
+    const char* name;             /* test name */
+    int name_len;                 /* test name length */
+    linearity_result_t linearity; /* linearity of an adc of a sweep test */
+
+    name = test_name(summary->test, &name_len);
+
+    fprintf(fptr, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",", card->id[0], card->id[1], card->id[2]);
+    csv_write_string(fptr, (const char*)card->board_part_number,
+                     card_string_len(card->board_part_number, sizeof(card->board_part_number)));
+    fputc(',', fptr);
+    csv_write_string(fptr, name, name_len);
+
+    fprintf(fptr, ",%s,%s,%u,%s,%" PRIu64 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32
+            ",%" PRIu64,
+            criteria_name(summary->test->criteria), mode_name(summary->test->pulling_or_it),
+            (unsigned int)summary->test->payload_size, payload_pattern_name(summary->pattern), summary->seed,
+            summary->iterations, summary->success_num,
+            summary->over_time_error_num, summary->interrupt_error_num, summary->return_error_num, summary->lost_num,
+            summary->avr_time_elapsed);
+
+    if (summary->avr_card_time != NO_SUCCESS) {
+        fprintf(fptr, ",%" PRIu64 ",%" PRIu64, summary->avr_card_time,
+                summary->avr_time_elapsed > summary->avr_card_time
+                    ? summary->avr_time_elapsed - summary->avr_card_time
+                    : 0);
+    } else {
+        fputs(",,", fptr);
+    }
+
+    for (uint8_t phase = 0; phase < TEST_PHASE_NUM; phase++) {
+
+        if (summary->phase_num[phase] > 0) {
+            fprintf(fptr, ",%" PRIu64, summary->avr_phase_time[phase]);
+        } else {
+            fputc(',', fptr);
+        }
+    }
+
+    fprintf(fptr, ",%" PRIu64 ",%" PRIu64, summary->bits_compared, summary->bit_errors);
+    if (summary->bits_compared > 0) {
+        fprintf(fptr, ",%.6e", (double)summary->bit_errors / (double)summary->bits_compared);
+    } else {
+        fputc(',', fptr);
+    }
+    if (summary->bit_errors > 0) {
+        fprintf(fptr, ",%u", (unsigned int)summary->first_error);
+    } else {
+        fputc(',', fptr);
+    }
+    for (uint8_t bit = 0; bit < BITS_IN_BYTE; bit++) {
+        fprintf(fptr, ",%" PRIu32, summary->flip_to_one_num[bit]);
+    }
+    for (uint8_t bit = 0; bit < BITS_IN_BYTE; bit++) {
+        fprintf(fptr, ",%" PRIu32, summary->flip_to_zero_num[bit]);
+    }
+    fprintf(fptr, ",%" PRIu32 ",%" PRIu32 ",%u,%u", summary->shift_left_num, summary->shift_right_num,
+            (unsigned int)summary->stuck_high, (unsigned int)summary->stuck_low);
+
+    if (summary->analog_samples > 0) {
+        fprintf(fptr, ",%" PRIu64 ",%" PRIu64 ",%u,%.3f,%.3f,%.4f,%.3f,%.3f,%d", summary->analog_samples,
+                summary->out_of_tolerance, (unsigned int)summary->adc_tolerance, summary->offset,
+                lsb_to_mv(summary, summary->offset), summary->gain_error * 100, summary->noise,
+                lsb_to_mv(summary, summary->noise), (int)summary->max_error);
+    } else {
+        fputs(",0,,,,,,,,", fptr);
+    }
+
+    for (uint8_t adc = 0; adc < LINEARITY_ADC_NUM; adc++) {
+
+        if (summary->linearity == NULL) {
+            fputs(",,,,,,", fptr);
+            continue;
+        }
+
+        linearity_analyse(summary->linearity, adc, &linearity);
+
+        fprintf(fptr, ",%.3f,%.4f,%.3f,%.3f,%.3f,", linearity.offset, linearity.gain_error * 100, linearity.inl_max,
+                linearity.dnl_min, linearity.dnl_max);
+
+        if (linearity.missing_codes >= 0) {
+            fprintf(fptr, "%" PRId32, linearity.missing_codes);
+        }
+    }
+
+    if (summary->bus_frames > 0) {
+        fprintf(fptr, ",%" PRIu64 ",%.1f,%.2f,%" PRIu64 ",%" PRIu64, summary->bus_frames, summary->frames_per_sec,
+                summary->bus_load * 100, summary->avr_frame_latency, summary->max_frame_latency);
+    } else {
+        fputs(",0,,,,", fptr);
+    }
+
+    if (summary->stream_bytes > 0) {
+        fprintf(fptr, ",%" PRIu64 ",%.3f,%" PRIu64, summary->stream_bytes, summary->stream_mb_per_sec,
+                summary->stream_error_blocks);
+    } else {
+        fputs(",0,,", fptr);
+    }
+
+    fprintf(fptr, ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64,
+            summary->latency->min, latency_stats_percentile(summary->latency, 50),
+            latency_stats_percentile(summary->latency, 90), latency_stats_percentile(summary->latency, 99),
+            latency_stats_percentile(summary->latency, 99.9), summary->latency->max,
+            latency_stats_stddev(summary->latency));
+
+    for (uint8_t i = 0; i < LATENCY_DECADE_NUM; i++) {
+
+        fprintf(fptr, ",%" PRIu32, summary->latency->decade[i]);
+    }
+
+    fputc('\n', fptr);
+}
+
+/**
+ * \brief           the results file formats, selected with "format" in the configuration
+ */
+const result_sink_t result_sink_list[] = {
+
+    {.name = "text", .format = RESULT_FORMAT_TEXT, .extension = "txt", .begin = NULL, .write_test = text_write_test},
+    {.name = "jsonl",
+     .format = RESULT_FORMAT_JSONL,
+     .extension = "jsonl",
+     .begin = NULL,
+     .write_test = jsonl_write_test},
+    {.name = "csv", .format = RESULT_FORMAT_CSV, .extension = "csv", .begin = csv_begin, .write_test = csv_write_test},
+
+};
+
+/**
+ * \brief           number of results file formats
+ */
+const uint8_t result_sink_num = sizeof(result_sink_list) / sizeof(result_sink_t);
+
+/**
+ * \brief           parse a comma separated list of results file formats, like "text,jsonl,csv"
+ * \param[in]       text: format names
+ * \param[out]      formats_out: RESULT_FORMAT_ flags of the formats
+ * \param[out]      error:error massage
+ */
+uint8_t
+result_format_parse(const char* text, uint8_t* formats_out) {
+
+    uint8_t formats = 0; /* formats parsed */
+    const char* name;    /* format name parsed */
+    size_t name_len;     /* format name length */
+    uint8_t found;       /* the format name is known */
+
+    name = text;
+    while (*name != '\0') {
+
+        name_len = strcspn(name, ",");
+        found = 0;
+
+        for (uint8_t i = 0; i < result_sink_num; i++) {
+
+            if (strlen(result_sink_list[i].name) == name_len
+                && strncmp(result_sink_list[i].name, name, name_len) == 0) {
+                formats |= result_sink_list[i].format;
+                found = 1;
+            }
+        }
+
+        if (!found) {
+            return CONFIG_ERROR;
+        }
+
+        name += name_len;
+        if (*name == ',') {
+            name++;
+        }
+    }
+
+    if (formats == 0) {
+        return CONFIG_ERROR;
+    }
+
+    *formats_out = formats;
+
+    return ERROR_OK;
+}
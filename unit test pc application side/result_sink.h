@@ -0,0 +1,112 @@
+/**
+ * \file            result_sink.h
+ * \brief           result file formats, text json lines and csv inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman 
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+#ifndef RESULT_SINK
+#define RESULT_SINK
+
+#include "unit_test_lib.h"
+
+/**
+ * \brief            summary of the results of one test, everything a result sink writes
+ */
+typedef struct test_summary {
+
+    const linux_app_test_setting_t* test; /*!< test information, name criteria mode and payload size */
+    uint8_t pattern;                      /*!< payload_pattern_t of the test data */
+    uint64_t seed;                        /*!< seed of the test data, the same seed sends the same data again */
+    uint32_t iterations;                  /*!< number of test requests */
+    uint32_t success_num;                 /*!< tests with data match */
+    uint32_t over_time_error_num;         /*!< tests with over time error */
+    uint32_t interrupt_error_num;         /*!< tests with error interrupt */
+    uint32_t return_error_num;            /*!< tests with HAL return error */
+    uint32_t lost_num;                    /*!< test requests with no reply, also after retries */
+    uint64_t avr_time_elapsed;            /*!< average time elapsed of the successful tests in ns */
+    uint64_t avr_card_time;               /*!< average time the card ran the test function in ns, 0 if not timed */
+    uint64_t avr_phase_time[TEST_PHASE_NUM]; /*!< average time to each phase in ns, of the tests that marked it */
+    uint32_t phase_num[TEST_PHASE_NUM];      /*!< number of successful tests that marked each phase */
+    const latency_stats_t* latency;          /*!< time elapsed statistics of the successful tests */
+    const linearity_t* linearity;            /*!< transfer curve of a sweep test, NULL for other tests */
+    uint64_t bits_compared;                  /*!< bits of the tests with data compared, 0 if the data is not compared
+                                                  bit by bit */
+    uint64_t bit_errors;                     /*!< bits received different from the bits sent */
+    uint32_t mismatch_num;                   /*!< tests with data mismatch */
+    uint16_t first_error;                    /*!< earliest byte received different from the byte sent, if bit_errors */
+    uint32_t flip_to_one_num[BITS_IN_BYTE];  /*!< mismatch tests with each bit position flipped from 0 to 1 */
+    uint32_t flip_to_zero_num[BITS_IN_BYTE]; /*!< mismatch tests with each bit position flipped from 1 to 0 */
+    uint32_t shift_left_num;                 /*!< mismatch tests with the data received one bit early */
+    uint32_t shift_right_num;                /*!< mismatch tests with the data received one bit late */
+    uint8_t stuck_high;                      /*!< bit positions flipped from 0 to 1 in every mismatch test that is not
+                                                  shifted, and never from 1 to 0 */
+    uint8_t stuck_low;                       /*!< bit positions flipped from 1 to 0 in every mismatch test that is not
+                                                  shifted, and never from 0 to 1 */
+    uint64_t analog_samples;                 /*!< analog samples converted, 0 if the test is not analog */
+    uint64_t out_of_tolerance;               /*!< analog samples with an error bigger then adc_tolerance */
+    uint16_t adc_tolerance;                  /*!< largest analog error in LSB of a successful analog sample */
+    uint16_t vref_mv;                        /*!< adc and dac reference voltage in mV, LSB to mV */
+    int16_t max_error;                       /*!< analog error in LSB of the sample furthest from its dac code */
+    double offset;                           /*!< adc code of dac code 0 in LSB, of the best fit line */
+    double gain_error;                       /*!< slope of the best fit line of the adc codes over the dac codes,
+                                                  less 1 */
+    double noise;                            /*!< rms distance of the adc codes from the best fit line in LSB */
+    uint64_t bus_frames;                     /*!< frames received over the bus, 0 if the test is not a bus test */
+    double frames_per_sec;                   /*!< frames received in a second of bus time */
+    double bus_load;                         /*!< bits the frames took on the bus over the bus time, 0 to 1 */
+    uint64_t avr_frame_latency;              /*!< average time from queuing a frame to receiving it in ns */
+    uint64_t max_frame_latency;              /*!< longest time from queuing a frame to receiving it in ns */
+    uint64_t stream_bytes;                   /*!< bytes streamed and checked by the card, 0 if the test is not a
+                                                  stream test */
+    double stream_mb_per_sec;                /*!< bytes streamed in a second of stream time, in MB */
+    uint64_t stream_error_blocks;            /*!< blocks streamed with a bit error */
+
+} test_summary_t;
+
+/**
+ * \brief            a results file format
+ * \note             generate_result_file writes a file for each format selected, "format" in the configuration
+ */
+typedef struct result_sink {
+
+    const char* name;      /*!< format name in the configuration */
+    uint8_t format;        /*!< RESULT_FORMAT_ flag */
+    const char* extension; /*!< results file name extension */
+    void (*begin)(FILE* fptr);                  /*!< write the file header, NULL if the format has none */
+    void (*write_test)(FILE* fptr, const card_name_and_id_t* card,
+                       const test_summary_t* summary); /*!< write the results of one test */
+
+} result_sink_t;
+
+extern const result_sink_t result_sink_list[];
+extern const uint8_t result_sink_num;
+
+uint8_t result_format_parse(const char* text, uint8_t* formats_out);
+
+#endif /* RESULT_SINK */
@@ -31,83 +31,68 @@
  * Author:          Uri Fridman <optional_email@example.com>
  */
 #include "threads.h"
-extern unit_test_pack_t my_test;
 
 /**
  * \brief           thread one for each testing freertos task, on stm. to test multiple peripherals simultaneously
+ * \note            a send or receive error stops only the thread, it is stored in the thread result
+ *                  and fails its card
  * \param[in]       arg: "tasting_thread_pack_t" struct pointer
  * \param[out]      return: NULL
  */
 void*
 testing_thread(void* arg) {
 
-    uint16_t check; /* return error check */
+    uint8_t check; /* return error check */
     tasting_thread_pack_t* test_setting =
-        (tasting_thread_pack_t*)arg;  /* for casting  arg to tasting_thread_pack_t pointer */
-    unit_tasting_package_t rx_pocket; /* udp receive buffer */
-    unit_tasting_package_t tx_pocket; /* udp transmit buffer */
-    struct timeval t1, t2;            /* store udp massage tranmission time */
+        (tasting_thread_pack_t*)arg; /* for casting  arg to tasting_thread_pack_t pointer */
+    struct pollfd reply_wait;        /* waits for a reply until a request needs to be sent again */
 
-    /* copy card uniq id to transmit buffer, in order for the test request to be recived  by stm card  */
-    memcpy(tx_pocket.id, my_test.commend.id, sizeof(tx_pocket.id));
+    reply_wait.fd = test_setting->thread_socket.task_port_socket_fd;
+    reply_wait.events = POLLIN;
 
-    /* run tests */
-    for (uint8_t peripheral_test = 0; peripheral_test < test_setting->number_of_test; peripheral_test++) {
+    test_setting->result = ERROR_OK;
+    test_stream_reset(test_setting);
 
-        tx_pocket.request = peripheral_test; /* test number to be run */
+    /* run tests, each test is rerun for a number of iterations */
+    while (!test_stream_done(test_setting)) {
 
-        /* test is rerun for a number of iterations */
-        for (uint8_t test_iteration = 0; test_iteration < NUM_OF_CHECKS; test_iteration++) {
+        /* request from stm card to ran peripheral tests on data and the send the data tested back */
+        check = test_stream_fill(test_setting);
+        if (check != ERROR_OK) {
 
-            /* generate random data to check peripheral  */
-            for (uint8_t i = 0; i < sizeof(tx_pocket.data); i++) {
+            perror("send filed");
+            test_setting->result = check;
+            return NULL;
+        }
 
-                tx_pocket.data[i] = rand() % UINT8_T_RANGE;
-            }
+        /* in adaptive mode the last test may finish without sending more requests */
+        if (test_stream_done(test_setting)) {
+            break;
+        }
 
-            tx_pocket.error_report = MISMATCH;
-            /* request from stm card to ran a peripheral test on data and the send the data tested back */
-            check = sendto(test_setting->thread_socket.task_port_socket_fd, (void*)&tx_pocket, sizeof(tx_pocket), 0,
-                           (struct sockaddr*)&test_setting->thread_socket.addr,
-                           sizeof(test_setting->thread_socket.addr));
-            if (check == -1) {
+        /* waite for a reply, no longer then the first request timeout */
+        if (poll(&reply_wait, 1, test_stream_timeout_ms(test_setting)) > 0) {
 
-                perror("send filed");
-                exit(FAILED_TO_SEND_MASSAGE);
-            }
-            /* take the time of the beginning of the test */
-            gettimeofday(&t1, NULL);
+            /* receive from stm data tested and evaluate the test results */
+            while ((check = test_stream_receive(test_setting, MSG_DONTWAIT)) == ERROR_OK) {}
 
-            /* receive from stm data tested  */
-            check = recvfrom(test_setting->thread_socket.task_port_socket_fd, (void*)&rx_pocket, sizeof(rx_pocket), 0,
-                             (struct sockaddr*)&test_setting->thread_socket.addr,
-                             &test_setting->thread_socket.addr_size);
-            if (check == -1) {
+            if (check != NO_MASSAGE_WAITING) {
 
                 perror("receive filed");
-                exit(FAILED_TO_RECEIVE_MASSAGE);
+                test_setting->result = check;
+                return NULL;
             }
+        }
 
-            /* compute and store test time elapsed */
-            gettimeofday(&t2, NULL);
-            test_setting->first_test_addr[peripheral_test].test_results_array[test_iteration].time_elapsed =
-                (t2.tv_usec - t1.tv_usec);
-
-            /* evaluating test result */
-            if (rx_pocket.error_report != NO_ERROR) {
-
-                test_setting->first_test_addr[peripheral_test]
-                    .test_results_array[test_iteration]
-                    .preferments.data_match = rx_pocket.error_report;
-
-            } else {
+        /* send again requests with no reply, or count them as lost */
+        check = test_stream_expire(test_setting);
+        if (check != ERROR_OK) {
 
-                preferments_check(
-                    &test_setting->first_test_addr[peripheral_test].test_results_array[test_iteration].preferments,
-                    test_setting->first_test_addr[peripheral_test].test_request_pack.criteria, rx_pocket.data,
-                    tx_pocket.data, sizeof(tx_pocket.data));
-            }
+            perror("send filed");
+            test_setting->result = check;
+            return NULL;
         }
     }
+
     return NULL;
 }
@@ -35,12 +35,6 @@
 
 #include "unit_test_lib.h"
 
-/**
- * \brief          highest number fitting in a byte
- * \hideinitializer 
- */
-#define UINT8_T_RANGE 0XFF
-
 void* testing_thread(void* arg);
 
 #endif /* THREADS */
\ No newline at end of file
@@ -31,104 +31,519 @@
  * Author:          Uri Fridman <optional_email@example.com>
  */
 #include "unit_test_lib.h"
+#include "journal.h"
+#include "result_sink.h"
+
+/**
+ * \brief           dac codes of one chunk of a sweep, as many as the sums of their adc codes fit the test data
+ * \param[in]       payload_size: test data size of the sweep test
+ * \param[out]      return: dac codes of a chunk
+ */
+static uint16_t
+sweep_chunk_codes(uint16_t payload_size) {
+
+    return (uint16_t)((payload_size - sizeof(sweep_request_t)) / (LINEARITY_ADC_NUM * sizeof(uint16_t)));
+}
+
+/**
+ * \brief           dac codes of a whole sweep
+ * \param[in]       step: dac codes between the codes swept
+ * \param[out]      return: dac codes swept
+ */
+static uint32_t
+sweep_code_num(uint16_t step) {
+
+    return (LINEARITY_CODE_NUM - 1) / step + 1;
+}
+
+/**
+ * \brief           fill the test data of a sweep test with the chunk of the sweep of an iteration
+ * \param[in]       test: sweep test
+ * \param[in]       iteration: iteration of the test, the chunk index
+ * \param[out]      data: test data, the sweep_request_t and room for the sums of the adc codes
+ */
+static void
+sweep_request_fill(const test_recurses_t* test, uint32_t iteration, uint8_t* data) {
+
+    sweep_request_t request;                                                  /* chunk of the sweep */
+    uint16_t chunk_codes = sweep_chunk_codes(test->test_request_pack.payload_size); /* dac codes of a chunk */
+    uint32_t first = iteration * chunk_codes; /* index in the sweep of the first dac code of the chunk */
+    uint32_t code_num = sweep_code_num(test->linearity->step); /* dac codes of the sweep */
+
+    request.first_code = (uint16_t)(first * test->linearity->step);
+    request.step = test->linearity->step;
+    request.code_num = (uint16_t)(code_num - first < chunk_codes ? code_num - first : chunk_codes);
+    request.average = test->linearity->average;
+    request.adc_num = LINEARITY_ADC_NUM;
+
+    memset(data, 0, test->test_request_pack.payload_size);
+    memcpy(data, &request, sizeof(request));
+}
+
+/**
+ * \brief           add the sums of the adc codes of a chunk of a sweep to the transfer curve
+ * \param[in]       curve: transfer curve of the sweep test
+ * \param[in]       data: test data received, the sweep_request_t sent followed by the sums
+ */
+static void
+sweep_store(linearity_t* curve, const uint8_t* data) {
+
+    sweep_request_t request; /* chunk of the sweep */
+    uint16_t sum;            /* sum of the adc codes of one adc at one dac code */
+
+    memcpy(&request, data, sizeof(request));
+
+    for (uint16_t code = 0; code < request.code_num; code++) {
+
+        for (uint8_t adc = 0; adc < request.adc_num; adc++) {
+
+            memcpy(&sum, &data[sizeof(request) + ((size_t)code * request.adc_num + adc) * sizeof(sum)], sizeof(sum));
+            linearity_add(curve, adc, (uint16_t)(request.first_code + code * request.step), sum, request.average);
+        }
+    }
+}
+
+/**
+ * \brief           add the result of one iteration to the sums and time elapsed statistics of its test
+ * \note            the results are not kept, so the memory of a test does not grow with its number of iterations
+ * \param[in]       test: test of the result
+ * \param[in]       result: result of the iteration
+ */
+void
+test_result_add(test_recurses_t* test, const single_test_result_t* result) {
+
+    result_sums_t* sums = &test->sums; /* sums of the test results */
+
+    if (result->preferments.data_match == NO_ERROR) {
+        sums->success_num++;
+
+        sums->time_elapsed = sums->time_elapsed + result->time_elapsed;
+        sums->card_time = sums->card_time + result->card_time;
+        latency_stats_add(&test->latency, result->time_elapsed);
+
+        /* phases are counted only in the tests that marked them */
+        for (uint8_t phase = 0; phase < TEST_PHASE_NUM; phase++) {
+
+            if (result->phase_time[phase] != 0) {
+                sums->phase_time[phase] = sums->phase_time[phase] + result->phase_time[phase];
+                sums->phase_num[phase]++;
+            }
+        }
+    } else if (result->preferments.data_match == OVER_TIME) {
+
+        sums->over_time_error_num++;
+
+    } else if (result->preferments.data_match == HAL_RETURN_ERROR) {
+
+        sums->return_error_num++;
+
+    } else if (result->preferments.data_match == ERROR_IT) {
+
+        sums->interrupt_error_num++;
+
+    } else if (result->preferments.data_match == LOST) {
+
+        sums->lost_num++;
+
+    } else if (result->preferments.data_match == MISMATCH) {
+
+        sums->mismatch_num++;
+        if (result->preferments.bit_errors > 0
+            && (sums->bit_errors == 0 || result->preferments.first_error < sums->first_error)) {
+            sums->first_error = result->preferments.first_error;
+        }
+        sums->bit_errors = sums->bit_errors + result->preferments.bit_errors;
+
+        for (uint8_t bit = 0; bit < BITS_IN_BYTE; bit++) {
+
+            sums->flip_to_one_num[bit] += (result->preferments.flip_to_one >> bit) & 1;
+            sums->flip_to_zero_num[bit] += (result->preferments.flip_to_zero >> bit) & 1;
+        }
+
+        /* a shifted test flips bits all over the data, it says nothing about stuck bits */
+        if (result->preferments.bit_shift == BIT_SHIFT_LEFT) {
+            sums->shift_left_num++;
+        } else if (result->preferments.bit_shift == BIT_SHIFT_RIGHT) {
+            sums->shift_right_num++;
+        } else {
+            sums->all_to_one = sums->unshifted_num == 0 ? result->preferments.flip_to_one
+                                                        : sums->all_to_one & result->preferments.flip_to_one;
+            sums->all_to_zero = sums->unshifted_num == 0 ? result->preferments.flip_to_zero
+                                                         : sums->all_to_zero & result->preferments.flip_to_zero;
+            sums->unshifted_num++;
+        }
+        sums->any_to_one |= result->preferments.flip_to_one;
+        sums->any_to_zero |= result->preferments.flip_to_zero;
+    }
+
+    /* the data of the tests the card ran is compared bit by bit */
+    if ((test->test_request_pack.criteria == COMMUNICATION_criteria || test->test_request_pack.criteria == BUS_criteria)
+        && (result->preferments.data_match == NO_ERROR || result->preferments.data_match == MISMATCH)) {
+        sums->bits_compared = sums->bits_compared + test->test_request_pack.payload_size * BITS_IN_BYTE;
+    }
+
+    /* the frames of all the tests the card ran add up to one bus load, frame rate and latency */
+    if (result->bus.frames > 0 && result->bus.bitrate > 0) {
+
+        sums->bus_frames += result->bus.frames;
+        sums->bus_bits += result->bus.bus_bits;
+        sums->bus_time += result->bus.bus_time;
+        sums->bus_seconds += (double)result->bus.bus_time / result->bus.bitrate;
+        sums->frame_latency += result->bus.latency_sum;
+        if (result->bus.latency_max > sums->max_frame_latency) {
+            sums->max_frame_latency = result->bus.latency_max;
+        }
+    }
+
+    /* the card checks the data it streams, its bits are compared like the bits of the other tests */
+    if (result->stream.bytes > 0) {
+
+        sums->stream_bytes += result->stream.bytes;
+        sums->stream_error_blocks += result->stream.error_blocks;
+        sums->bits_compared += (uint64_t)result->stream.bytes * BITS_IN_BYTE;
+        sums->bit_errors += result->stream.bit_errors;
+        sums->stream_time += result->stream.stream_time;
+    }
+
+    /* the analog samples of all the tests the card ran add up to one best fit line */
+    if (result->preferments.analog.samples > 0) {
+
+        sums->analog_samples += result->preferments.analog.samples;
+        sums->out_of_tolerance += result->preferments.analog.out_of_tolerance;
+        if (abs(result->preferments.analog.max_error) > abs(sums->max_error)) {
+            sums->max_error = result->preferments.analog.max_error;
+        }
+        sums->sum_code += (double)result->preferments.analog.sum_code;
+        sums->sum_code_sq += (double)result->preferments.analog.sum_code_sq;
+        sums->sum_error += (double)result->preferments.analog.sum_error;
+        sums->sum_code_error += (double)result->preferments.analog.sum_code_error;
+        sums->sum_error_sq += (double)result->preferments.analog.sum_error_sq;
+    }
+}
+
+/**
+ * \brief           count the results of one test and average its times
+ * \param[in]       test_in: test and the sums of its results
+ * \param[out]      summary: summary of the test results
+ */
+static void
+summarize_test(const test_recurses_t* test_in, test_summary_t* summary) {
+
+    const result_sums_t* sums = &test_in->sums; /* sums of the test results */
+    double samples;                             /* number of analog samples */
+    double denominator;                         /* spread of the dac codes, 0 if all the codes are the same */
+
+    memset(summary, 0, sizeof(*summary));
+    summary->test = &test_in->test_request_pack;
+    summary->iterations = test_in->iteration_num;
+    summary->latency = &test_in->latency;
+    summary->linearity = test_in->linearity;
+
+    summary->success_num = sums->success_num;
+    summary->over_time_error_num = sums->over_time_error_num;
+    summary->return_error_num = sums->return_error_num;
+    summary->interrupt_error_num = sums->interrupt_error_num;
+    summary->lost_num = sums->lost_num;
+    summary->mismatch_num = sums->mismatch_num;
+    memcpy(summary->phase_num, sums->phase_num, sizeof(summary->phase_num));
+    summary->bits_compared = sums->bits_compared;
+    summary->bit_errors = sums->bit_errors;
+    summary->first_error = sums->first_error;
+    memcpy(summary->flip_to_one_num, sums->flip_to_one_num, sizeof(summary->flip_to_one_num));
+    memcpy(summary->flip_to_zero_num, sums->flip_to_zero_num, sizeof(summary->flip_to_zero_num));
+    summary->shift_left_num = sums->shift_left_num;
+    summary->shift_right_num = sums->shift_right_num;
+    summary->analog_samples = sums->analog_samples;
+    summary->out_of_tolerance = sums->out_of_tolerance;
+    summary->max_error = sums->max_error;
+    summary->bus_frames = sums->bus_frames;
+    summary->max_frame_latency = sums->max_frame_latency;
+    summary->stream_bytes = sums->stream_bytes;
+    summary->stream_error_blocks = sums->stream_error_blocks;
+
+    /* least squares fit of the errors, adc code - dac code = offset + gain error * dac code.
+       the noise is the rms of the errors around the line */
+    if (summary->analog_samples > 0) {
+
+        samples = (double)summary->analog_samples;
+        denominator = samples * sums->sum_code_sq - sums->sum_code * sums->sum_code;
+        if (denominator > 0) {
+            summary->gain_error = (samples * sums->sum_code_error - sums->sum_code * sums->sum_error) / denominator;
+        }
+        summary->offset = (sums->sum_error - summary->gain_error * sums->sum_code) / samples;
+        summary->noise = sqrt(fmax(0, (sums->sum_error_sq - summary->offset * sums->sum_error
+                                       - summary->gain_error * sums->sum_code_error)
+                                      / (summary->analog_samples > 2 ? samples - 2 : samples)));
+    }
+
+    if (summary->bus_frames > 0) {
+
+        summary->avr_frame_latency = sums->frame_latency / summary->bus_frames;
+        if (sums->bus_time > 0) {
+            summary->frames_per_sec = summary->bus_frames / sums->bus_seconds;
+            summary->bus_load = (double)sums->bus_bits / sums->bus_time;
+        }
+    }
+
+    /* the bytes of all the streams over their time add up to one throughput */
+    if (sums->stream_time > 0) {
+        summary->stream_mb_per_sec =
+            (double)summary->stream_bytes / BYTES_IN_MB / ((double)sums->stream_time / NS_IN_SEC);
+    }
+
+    if (sums->unshifted_num > 0) {
+        summary->stuck_high = sums->all_to_one & ~sums->any_to_zero;
+        summary->stuck_low = sums->all_to_zero & ~sums->any_to_one;
+    }
+
+    /* if ther ware success devid the sum of time elapsed by number of success, else put marco NO_SUCCESS */
+    if (summary->success_num > 0) {
+        summary->avr_time_elapsed = sums->time_elapsed / summary->success_num;
+        summary->avr_card_time = sums->card_time / summary->success_num;
+    } else {
+        summary->avr_time_elapsed = NO_SUCCESS;
+        summary->avr_card_time = NO_SUCCESS;
+    }
+
+    for (uint8_t phase = 0; phase < TEST_PHASE_NUM; phase++) {
+
+        if (summary->phase_num[phase] > 0) {
+            summary->avr_phase_time[phase] = sums->phase_time[phase] / summary->phase_num[phase];
+        }
+    }
+}
 
 /**
  * \brief           generate result's file from unit test result's, "test_recurses_t" array
- * \note            this function should be only after unit test is finished
+ * \note            this function should be only after unit test is finished.
+ *                  a results file is written for each format selected, text, json lines and csv
  * \param[in]       result_list_in: list of test and their results 
  * \param[in]       length: number of test's
  * \param[in]       card: card name and id   
+ * \param[in]       config: RESULT_FORMAT_ flags of the results files to write, test data pattern and seed
  * \param[out]      error:error massage
  */
 uint8_t
-generate_result_file(test_recurses_t* result_list_in, uint16_t length, card_name_and_id_t* card) {
+generate_result_file(test_recurses_t* result_list_in, uint16_t length, card_name_and_id_t* card,
+                     const unit_test_config_t* config) {
 
     FILE* fptr;                                     /* result output file pointer  */
-    uint8_t txt_transfer_buffer[TXT_TRANSFER_SIZE]; /* buffer fore generating result text */
-    uint8_t number_of_success_tx_rx;                /* number of perineal test success */
-    uint16_t avr_time_elapsed;                      /* average test time elapsed */
-    uint8_t over_time_error_num;                    /* over time error number */
-    uint8_t return_error_num;                       /* HAL function returned error, error number */
-    uint8_t interrupt_error_num;                    /* callback error , error number */
-    uint32_t sum_of_time_elapsed;                   /* sum of single peripheral tests  time elapsed */
+    uint8_t txt_transfer_buffer[TXT_TRANSFER_SIZE]; /* buffer fore generating the file name */
+    test_summary_t summary;                         /* results of one test */
+    const result_sink_t* sink;                      /* format of the results file written */
     int check;                                      /* function return error check  */
 
-    /* generating the name of the file, include card name end uniq id  */
-    sprintf((char*)txt_transfer_buffer,
-            "unit test results of card: %s UID:  %" PRIu32 "  ::  %" PRIu32 "  ::  %" PRIu32 ".txt",
-            card->board_part_number, card->id[0], card->id[1], card->id[2]);
+    for (uint8_t sink_index = 0; sink_index < result_sink_num; sink_index++) {
+
+        sink = &result_sink_list[sink_index];
+        if ((config->result_formats & sink->format) == 0) {
+            continue;
+        }
+
+        /* generating the name of the file, include card name end uniq id  */
+        sprintf((char*)txt_transfer_buffer,
+                "unit test results of card: %s UID:  %" PRIu32 "  ::  %" PRIu32 "  ::  %" PRIu32 ".%s",
+                card->board_part_number, card->id[0], card->id[1], card->id[2], sink->extension);
+
+        /* opening or creating result file */
+        fptr = fopen((char*)txt_transfer_buffer, "w");
+        if (fptr == NULL) {
+
+            return GF_ERROR;
+        }
+
+        if (sink->begin != NULL) {
+            sink->begin(fptr);
+        }
+
+        /* writing in to results file the results of all the tests */
+        for (uint16_t test_index = 0; test_index < length; test_index++) {
 
-    /* opening or creating result file */
-    fptr = fopen((char*)txt_transfer_buffer, "w");
-    if (fptr == NULL) {
+            summarize_test(&result_list_in[test_index], &summary);
+            summary.pattern = config->pattern;
+            summary.seed = config->seed;
+            summary.adc_tolerance = adc_tolerance_lsb(config);
+            summary.vref_mv = config->vref_mv;
+            sink->write_test(fptr, card, &summary);
+        }
 
-        return GF_ERROR;
+        /* close results file */
+        check = fclose(fptr);
+        if (check != 0) {
+            return GF_ERROR;
+        }
     }
 
-    /* generating and writing in to results file results text of all the tests */
+    /* the transfer curve of each sweep test, in a file of its own next to the results files */
     for (uint16_t test_index = 0; test_index < length; test_index++) {
 
-        /* initialising the counters to 0  */
-        number_of_success_tx_rx = 0;
-        sum_of_time_elapsed = 0;
-        over_time_error_num = 0;
-        return_error_num = 0;
-        interrupt_error_num = 0;
+        if (result_list_in[test_index].linearity == NULL) {
+            continue;
+        }
+
+        sprintf((char*)txt_transfer_buffer,
+                "unit test transfer curve of card: %s UID:  %" PRIu32 "  ::  %" PRIu32 "  ::  %" PRIu32 " test %u.csv",
+                card->board_part_number, card->id[0], card->id[1], card->id[2], (unsigned int)test_index);
 
-        /* going to a single peripheral tests an counting the results */
-        for (uint8_t test_iteration = 0; test_iteration < sizeof(result_list_in->test_results_array)
-                                                              / sizeof(result_list_in->test_results_array[0]);
-             test_iteration++) {
+        fptr = fopen((char*)txt_transfer_buffer, "w");
+        if (fptr == NULL) {
 
-            if (result_list_in[test_index].test_results_array[test_iteration].preferments.data_match == NO_ERROR) {
-                number_of_success_tx_rx++;
+            return GF_ERROR;
+        }
+
+        linearity_write_curve(result_list_in[test_index].linearity, fptr);
+
+        check = fclose(fptr);
+        if (check != 0) {
+            return GF_ERROR;
+        }
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           or the bytes of a word together
+ * \param[in]       word: word to fold
+ * \param[out]      return: bit positions set in any byte of the word
+ */
+static uint8_t
+fold_bytes(uint64_t word) {
+
+    word |= word >> 32;
+    word |= word >> 16;
+    word |= word >> 8;
+
+    return (uint8_t)word;
+}
 
-                sum_of_time_elapsed = sum_of_time_elapsed
-                                      + result_list_in[test_index].test_results_array[test_iteration].time_elapsed;
-            } else if (result_list_in[test_index].test_results_array[test_iteration].preferments.data_match
-                       == OVER_TIME) {
+/**
+ * \brief           check if the data received is the data sent shifted by one bit
+ * \note            the bit shifted out of the data, and the bit shifted in, are not compared
+ * \param[in]       received: data received
+ * \param[in]       sent: data sent
+ * \param[in]       size: size of the data
+ * \param[out]      return: bit_shift_t
+ */
+static uint8_t
+bit_shift_check(const uint8_t* received, const uint8_t* sent, uint16_t size) {
 
-                over_time_error_num++;
+    uint8_t left = (size > 1);  /* the data matches the data sent shifted to the left */
+    uint8_t right = (size > 1); /* the data matches the data sent shifted to the right */
 
-            } else if (result_list_in[test_index].test_results_array[test_iteration].preferments.data_match
-                       == HAL_RETURN_ERROR) {
+    for (uint16_t i = 0; i + 1 < size && (left || right); i++) {
 
-                return_error_num++;
+        left = left && received[i] == (uint8_t)((sent[i] << 1) | (sent[i + 1] >> 7));
+        right = right && received[i + 1] == (uint8_t)((sent[i + 1] >> 1) | (sent[i] << 7));
+    }
 
-            } else if (result_list_in[test_index].test_results_array[test_iteration].preferments.data_match
-                       == ERROR_IT) {
+    return left ? BIT_SHIFT_LEFT : (right ? BIT_SHIFT_RIGHT : BIT_SHIFT_NONE);
+}
 
-                interrupt_error_num++;
+/**
+ * \brief           count the bits received different from the bits sent, and find where and how they differ
+ * \note            compares a 64 bit word at a time, the xor of the words are the bits that flipped
+ * \param[out]      result_out: bit errors of the test
+ * \param[in]       received: data received
+ * \param[in]       sent: data sent
+ * \param[in]       size: size of the data
+ */
+static void
+bit_error_check(test_preferments_results_t* result_out, const uint8_t* received, const uint8_t* sent,
+                uint16_t size) {
+
+    uint64_t received_word; /* word of the data received */
+    uint64_t sent_word;     /* word of the data sent */
+    uint64_t diff;          /* bits of the word that flipped */
+    uint64_t to_one = 0;    /* bits that flipped from 0 to 1 */
+    uint64_t to_zero = 0;   /* bits that flipped from 1 to 0 */
+    uint16_t offset = 0;    /* offset of the word compared */
+    uint8_t word_size;      /* size of the word compared, smaller at the end of the data */
+
+    while (offset < size) {
+
+        word_size = ((size_t)(size - offset) >= sizeof(uint64_t)) ? sizeof(uint64_t) : (uint8_t)(size - offset);
+        received_word = 0;
+        sent_word = 0;
+        memcpy(&received_word, &received[offset], word_size);
+        memcpy(&sent_word, &sent[offset], word_size);
+
+        diff = received_word ^ sent_word;
+        if (diff != 0) {
+
+            if (result_out->bit_errors == 0) {
+
+                result_out->first_error = offset;
+                while (received[result_out->first_error] == sent[result_out->first_error]) {
+                    result_out->first_error++;
+                }
             }
-        }
 
-        /* if ther ware success devid the sum of time elapsed by number of success, else put marco NO_SUCCESS */
-        if (number_of_success_tx_rx > 0) {
-            avr_time_elapsed = sum_of_time_elapsed / number_of_success_tx_rx;
-        } else {
-            avr_time_elapsed = NO_SUCCESS;
+            result_out->bit_errors += (uint32_t)__builtin_popcountll(diff);
+            to_one |= diff & received_word;
+            to_zero |= diff & sent_word;
         }
-        /* generate result text for a single perineal  */
-        sprintf(
-            (char*)txt_transfer_buffer,
-            "test %s data match = %u/%u.  average time elapsed =  %6.3fms. over time error = %u/%u. error interrupt = "
-            "%u/%u. HAL return error = %u/%u.\n\n ",
-            &result_list_in[test_index].test_request_pack.test_name[1], (unsigned int)NUM_OF_CHECKS,
-            number_of_success_tx_rx, (float)avr_time_elapsed / US_TO_MS, (unsigned int)NUM_OF_CHECKS,
-            over_time_error_num, (unsigned int)NUM_OF_CHECKS, interrupt_error_num, (unsigned int)NUM_OF_CHECKS,
-            return_error_num);
 
-        /* write to file result text for a single perineal  */
-        fputs((char*)txt_transfer_buffer, fptr);
+        offset += word_size;
     }
 
-    /* close results file */
-    check = fclose(fptr);
-    if (check != 0) {
-        return GF_ERROR;
+    result_out->flip_to_one = fold_bytes(to_one);
+    result_out->flip_to_zero = fold_bytes(to_zero);
+    result_out->bit_shift = bit_shift_check(received, sent, size);
+}
+
+/**
+ * \brief           add up the errors of the analog samples of a test, and count the samples out of tolerance
+ * \param[out]      result_out: analog errors of the test
+ * \param[in]       received: ADC_SAMPLE_SIZE bytes little endian adc codes received
+ * \param[in]       sent: ADC_SAMPLE_SIZE bytes little endian dac codes sent
+ * \param[in]       size: size of the data
+ * \param[in]       tolerance: largest error in LSB of a successful sample
+ */
+static void
+analog_check(test_preferments_results_t* result_out, const uint8_t* received, const uint8_t* sent, uint16_t size,
+             uint16_t tolerance) {
+
+    analog_sums_t* sums = &result_out->analog; /* analog sums of the test */
+    int32_t dac_code;                          /* code sent to the dac */
+    int32_t error;                             /* adc code - dac code */
+
+    for (uint16_t offset = 0; offset + ADC_SAMPLE_SIZE <= size; offset += ADC_SAMPLE_SIZE) {
+
+        dac_code = (sent[offset] | (sent[offset + 1] << 8)) & ADC_CODE_MAX;
+        error = ((received[offset] | (received[offset + 1] << 8)) & ADC_CODE_MAX) - dac_code;
+
+        sums->samples++;
+        sums->sum_error += error;
+        sums->sum_code += (uint32_t)dac_code;
+        sums->sum_code_sq += (uint64_t)dac_code * (uint64_t)dac_code;
+        sums->sum_code_error += (int64_t)dac_code * error;
+        sums->sum_error_sq += (uint64_t)((int64_t)error * error);
+
+        if (abs(error) > abs(sums->max_error)) {
+            sums->max_error = (int16_t)error;
+        }
+        if (abs(error) > tolerance) {
+            sums->out_of_tolerance++;
+        }
     }
 
-    return ERROR_OK;
+    result_out->data_match = (sums->samples > 0 && sums->out_of_tolerance == 0) ? NO_ERROR : MISMATCH;
+}
+
+/**
+ * \brief           largest analog error of a successful analog sample in LSB
+ * \param[in]       config: analog tolerance, in LSB or in mV of the reference voltage
+ * \param[out]      return: tolerance in LSB
+ */
+uint16_t
+adc_tolerance_lsb(const unit_test_config_t* config) {
+
+    if (!config->adc_tolerance_mv) {
+        return config->adc_tolerance;
+    }
+
+    return (uint16_t)(((uint32_t)config->adc_tolerance * (ADC_CODE_MAX + 1) + config->vref_mv / 2) / config->vref_mv);
 }
 
 /**
@@ -139,19 +554,23 @@ generate_result_file(test_recurses_t* result_list_in, uint16_t length, card_name
  * \param[in]       buffer_compare1: buffer 1 to compare with buffer 2 
  * \param[in]       buffer_compare1: buffer 2 to compare with buffer 1    
  * \param[in]       sizeof_buffers:  size of buffers to be compared    
+ * \param[in]       adc_tolerance:  largest analog error in LSB of a successful analog sample
  */
 void
 preferments_check(test_preferments_results_t* result_out, uint8_t tast_criteria, const uint8_t* buffer_compare1,
-                  const uint8_t* buffer_compare2, uint16_t sizeof_buffers) {
+                  const uint8_t* buffer_compare2, uint16_t sizeof_buffers, uint16_t adc_tolerance) {
 
     /* compere results by test criteria */
     switch (tast_criteria) {
 
         case COMMUNICATION_criteria:
+        case BUS_criteria:
 
+            /* most tests match, the bit errors are looked for only in the tests that do not */
             if (memcmp(buffer_compare2, buffer_compare1, sizeof_buffers) != 0) {
 
                 result_out->data_match = MISMATCH;
+                bit_error_check(result_out, buffer_compare1, buffer_compare2, sizeof_buffers);
 
             } else {
                 result_out->data_match = NO_ERROR;
@@ -161,11 +580,23 @@ preferments_check(test_preferments_results_t* result_out, uint8_t tast_criteria,
 
         case ADC_criteria:
 
-            if (buffer_compare2[0] >= buffer_compare1[0] - ADC_SUCCESS_ERROR_RANGE
-                && buffer_compare2[0] <= buffer_compare1[0] + ADC_SUCCESS_ERROR_RANGE) {
+            /* every sample needs to be within the tolerance of its dac code */
+            analog_check(result_out, buffer_compare1, buffer_compare2, sizeof_buffers, adc_tolerance);
 
-                result_out->data_match = MISMATCH;
+            break;
 
+        case STREAM_criteria:
+
+            /* the card checked the data it streamed, it replied an error if a bit did not match */
+            result_out->data_match = NO_ERROR;
+
+            break;
+
+        case LINEARITY_criteria:
+
+            /* the card sends back the chunk of the sweep it ran, the adc codes are analysed with the whole sweep */
+            if (memcmp(buffer_compare2, buffer_compare1, sizeof(sweep_request_t)) != 0) {
+                result_out->data_match = MISMATCH;
             } else {
                 result_out->data_match = NO_ERROR;
             }
@@ -207,13 +638,117 @@ create_app_init_socket(unit_test_pack_t* handel_in) {
     /* initialise socket fildes */
     memset(&handel_in->addr, '\0', sizeof(handel_in->addr));
     handel_in->addr.sin_family = AF_INET;
-    handel_in->addr.sin_port = htons(APP_INIT_PORT);
-    handel_in->addr.sin_addr.s_addr = inet_addr(STM_IP);
+    handel_in->addr.sin_port = htons(handel_in->config.app_init_port);
+    handel_in->addr.sin_addr.s_addr = inet_addr(handel_in->config.stm_ip);
     handel_in->addr_size = sizeof(handel_in->addr);
 
     return ERROR_OK;
 }
 
+/**
+ * \brief           time to waite for a reply after a number of retries, the timeout doubles on each retry
+ * \param[in]       timeout_ms: time to waite for the first reply
+ * \param[in]       retry: number of times the request was sent again
+ * \param[out]      return: time to waite in ms
+ */
+static uint32_t
+retry_timeout_ms(uint32_t timeout_ms, uint8_t retry) {
+
+    uint32_t timeout = timeout_ms; /* timeout after "retry" retries */
+
+    while (retry-- > 0 && timeout < MAX_TIMEOUT_MS) {
+        timeout *= 2;
+    }
+
+    return timeout < MAX_TIMEOUT_MS ? timeout : MAX_TIMEOUT_MS;
+}
+
+/**
+ * \brief           time of a clock counting up from an unspecified start, not changed by ntp or settimeofday
+ * \param[out]      return: time in ns
+ */
+uint64_t
+monotonic_time_ns(void) {
+
+    struct timespec now; /* current time */
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+
+    return (uint64_t)now.tv_sec * NS_IN_SEC + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * \brief           convert card cycle counter cycles to time
+ * \param[in]       cycles: card cycles
+ * \param[in]       clock_hz: clock of the card cycle counter, 0 if the card does not time the tests
+ * \param[out]      return: time in ns, 0 if the card does not time the tests
+ */
+static uint64_t
+cycles_to_ns(uint32_t cycles, uint32_t clock_hz) {
+
+    if (clock_hz == 0) {
+        return 0;
+    }
+
+    return (uint64_t)cycles * NS_IN_SEC / clock_hz;
+}
+
+/**
+ * \brief           send the app initialisation commend to the stm card and receive its reply
+ * \note            if no reply of the expected size arrives in time the commend is sent again,
+ *                  waiting twice as long each time, up to the configured number of retries
+ * \param[in]       handel_in: library structure with the commend and the resources to communicate with card
+ * \param[out]      reply: buffer receiving the reply
+ * \param[in]       reply_size: expected reply size
+ * \param[out]      error:error massage
+ */
+static uint8_t
+app_init_transaction(unit_test_pack_t* handel_in, void* reply, size_t reply_size) {
+
+    ssize_t check;               /* check function return error */
+    struct pollfd reply_wait;    /* waits for the reply until the timeout */
+    uint8_t stale[MAX_BUF_SIZE]; /* late replies of earlier tries are dropped in to this buffer */
+
+    reply_wait.fd = handel_in->sockfd;
+    reply_wait.events = POLLIN;
+
+    for (uint8_t retry = 0; retry <= handel_in->config.retries; retry++) {
+
+        /* drop late replies of the earlier tries, so they are not taken as the reply of this try */
+        while (retry > 0 && recv(handel_in->sockfd, stale, sizeof(stale), MSG_DONTWAIT) > 0) {}
+
+        check = sendto(handel_in->sockfd, (void*)&handel_in->commend, sizeof(handel_in->commend), 0,
+                       (struct sockaddr*)&handel_in->addr, sizeof(handel_in->addr));
+        if (check == -1) {
+
+            return FAILED_TO_SEND_MASSAGE;
+        }
+
+        check = poll(&reply_wait, 1, (int)retry_timeout_ms(handel_in->config.timeout_ms, retry));
+        if (check == -1 && errno != EINTR) {
+
+            return FAILED_TO_RECEIVE_MASSAGE;
+        }
+
+        if (check <= 0) {
+            continue;
+        }
+
+        check = recvfrom(handel_in->sockfd, reply, reply_size, 0, (struct sockaddr*)&handel_in->addr,
+                         &handel_in->addr_size);
+        if (check == -1) {
+
+            return FAILED_TO_RECEIVE_MASSAGE;
+        }
+
+        if ((size_t)check == reply_size) {
+            return ERROR_OK;
+        }
+    }
+
+    return REPLY_TIMEOUT;
+}
+
 /**
  * \brief           requesting stm card name and uniq id, from stm card
  * \note            the function arrange in this library file in the same order that they need to be called
@@ -224,25 +759,57 @@ create_app_init_socket(unit_test_pack_t* handel_in) {
 uint8_t
 request_card_id(unit_test_pack_t* handel_in) {
 
-    int check; /* check function return error */
+    uint8_t check; /* check function return error */
 
-    /* request card name and id from stm card */
-    check = sendto(handel_in->sockfd, (void*)&handel_in->commend, sizeof(handel_in->commend), 0,
-                   (struct sockaddr*)&handel_in->addr, sizeof(handel_in->addr));
-    if (check == -1) {
+    /* request and receive card name and id from stm card */
+    check = app_init_transaction(handel_in, &handel_in->card_id_in, sizeof(handel_in->card_id_in));
+    if (check != ERROR_OK) {
 
-        return FAILED_TO_SEND_MASSAGE;
+        return check;
     }
-    /* receive card name and id from stm card */
-    check = recvfrom(handel_in->sockfd, (void*)&handel_in->card_id_in, sizeof(handel_in->card_id_in), 0,
-                     (struct sockaddr*)&handel_in->addr, &handel_in->addr_size);
-    if (check == -1) {
 
-        return FAILED_TO_RECEIVE_MASSAGE;
+    /* copy  card uniq id to be used later when communicating with card */
+    memcpy(handel_in->commend.id, handel_in->card_id_in.id, sizeof(handel_in->card_id_in.id));
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           requesting stm card name, uniq id, test list size, number of testing tasks,
+ *                  protocol version and capabilities from stm card, in one round trip
+ * \note            replaces request_card_id and request_test_list_size.
+ *                  the function arrange in this library file in the same order that they need to be called
+ *                  do not call this function befor privies are called
+ * \param[in]       handel_in: library structure with the with the resources to communicate with card
+ * \param[out]      error:error massage
+ */
+uint8_t
+request_card_hello(unit_test_pack_t* handel_in) {
+
+    uint8_t check; /* check function return error */
+
+    /* request and receive card information from stm card */
+    handel_in->commend.type = HELLO_REQUEST;
+    check = app_init_transaction(handel_in, &handel_in->hello, sizeof(handel_in->hello));
+    if (check != ERROR_OK) {
+
+        return check;
     }
 
-    /* copy  card uniq id to be used later when communicating with card */
+    /* the card needs to speak the same protocol */
+    if (handel_in->hello.protocol_version != PROTOCOL_VERSION
+        || (handel_in->hello.features & (FEATURE_LIST_BULK | FEATURE_SEQUENCE))
+               != (FEATURE_LIST_BULK | FEATURE_SEQUENCE)) {
+
+        fprintf(stderr, "card %s protocol version %u, app protocol version %u\n", handel_in->config.stm_ip,
+                (unsigned int)handel_in->hello.protocol_version, (unsigned int)PROTOCOL_VERSION);
+        return PROTOCOL_ERROR;
+    }
+
+    /* copy card name and uniq id to be used later when communicating with card */
+    handel_in->card_id_in = handel_in->hello.card;
     memcpy(handel_in->commend.id, handel_in->card_id_in.id, sizeof(handel_in->card_id_in.id));
+    handel_in->list_len = handel_in->hello.pc_test_list_size;
 
     return ERROR_OK;
 }
@@ -258,6 +825,7 @@ uint8_t
 print_card_name_and_id(unit_test_pack_t* handel_in) {
 
     printf("card part number: %s\n", handel_in->card_id_in.board_part_number);
+    printf("card firmware build: %.*s\n", FIRMWARE_BUILD_SIZE, handel_in->hello.firmware_build);
     printf("card UID %" PRIu32 "  ::  %" PRIu32 "  ::  %" PRIu32 " \n", handel_in->card_id_in.id[0],
            handel_in->card_id_in.id[1], handel_in->card_id_in.id[2]);
 
@@ -274,23 +842,14 @@ print_card_name_and_id(unit_test_pack_t* handel_in) {
 uint8_t
 request_test_list_size(unit_test_pack_t* handel_in) {
 
-    int check; /* check function return error */
+    uint8_t check; /* check function return error */
 
-    /* request number of tests to be run, from stm card */
+    /* request and receive number of tests to be run, from stm card */
     handel_in->commend.type = LIST_SIZE_REQUEST;
-    check = sendto(handel_in->sockfd, (void*)&handel_in->commend, sizeof(handel_in->commend), 0,
-                   (struct sockaddr*)&handel_in->addr, sizeof(handel_in->addr));
-    if (check == -1) {
+    check = app_init_transaction(handel_in, &handel_in->list_len, sizeof(handel_in->list_len));
+    if (check != ERROR_OK) {
 
-        return FAILED_TO_SEND_MASSAGE;
-    }
-
-    /* receive number of tests to be run, from stm card */
-    check = recvfrom(handel_in->sockfd, (void*)&handel_in->list_len, sizeof(handel_in->list_len), 0,
-                     (struct sockaddr*)&handel_in->addr, &handel_in->addr_size);
-    if (check == -1) {
-
-        return FAILED_TO_RECEIVE_MASSAGE;
+        return check;
     }
 
     return ERROR_OK;
@@ -307,7 +866,7 @@ request_test_list_size(unit_test_pack_t* handel_in) {
 uint8_t
 allocate_test_list_mem(unit_test_pack_t* handel_in) {
 
-    handel_in->test_raw_results_list = (test_recurses_t*)malloc(sizeof(test_recurses_t) * handel_in->list_len);
+    handel_in->test_raw_results_list = (test_recurses_t*)calloc(handel_in->list_len, sizeof(test_recurses_t));
     if (handel_in->test_raw_results_list == NULL) {
         return MALLOC_FAILED;
     }
@@ -318,7 +877,8 @@ allocate_test_list_mem(unit_test_pack_t* handel_in) {
 /**
  * \brief           fills the "test_recurses_t" test list with test name's and settings received from stm card under test
  * \note            the function arrange in this library file in the same order that they need to be called
- *                  do not call this function befor privies are called
+ *                  do not call this function befor privies are called.
+ *                  the list is read in chunks of up to LIST_BULK_MAX_MEMBERS tests, one round trip for each chunk
  * \param[in]       handel_in: library structure with the pointer that point to "test_recurses_t" list 
  *                  and also the socket resources, required to communicate with stm card
  * \param[out]      error:error massage
@@ -326,39 +886,128 @@ allocate_test_list_mem(unit_test_pack_t* handel_in) {
 uint8_t
 read_and_fill_test_list_from_stm(unit_test_pack_t* handel_in) {
 
-    int check; /* check function return error */
+    uint8_t check;                /* check function return error */
+    list_bulk_reply_t bulk_reply; /* test list chunk received from stm card */
+    uint16_t member_num;          /* number of tests expected in the chunk */
     handel_in->commend.type =
-        LIST_MEMBER_REQUEST;   /* initialising app test init commend, type segment, with request a test member */
+        LIST_BULK_REQUEST;     /* initialising app test init commend, type segment, with request a test list chunk */
     handel_in->thread_num = 0; /* set to 0 struct member holding the number  testing thread to be run */
 
     /* requesting and receiving tests information from stm card */
-    for (uint16_t i = 0; i < handel_in->list_len; i++) {
+    for (uint16_t i = 0; i < handel_in->list_len; i += member_num) {
 
-        handel_in->commend.list_index = i; /* requesting member "i" from the list */
+        handel_in->commend.list_index = i; /* requesting the chunk starting at member "i" of the list */
 
-        /* request test to be run, from stm card */
-        check = sendto(handel_in->sockfd, (void*)&handel_in->commend, sizeof(handel_in->commend), 0,
-                       (struct sockaddr*)&handel_in->addr, sizeof(handel_in->addr));
-        if (check == -1) {
-            return FAILED_TO_SEND_MASSAGE;
+        member_num = handel_in->list_len - i;
+        if (member_num > LIST_BULK_MAX_MEMBERS) {
+            member_num = LIST_BULK_MAX_MEMBERS;
         }
 
-        /* receive test to be run, from stm card */
-        check = recvfrom(handel_in->sockfd, (void*)&handel_in->test_raw_results_list[i].test_request_pack,
-                         sizeof(linux_app_test_setting_t), 0, (struct sockaddr*)&handel_in->addr,
-                         &handel_in->addr_size);
-        if (check == -1) {
+        /* request and receive tests to be run, from stm card */
+        check = app_init_transaction(handel_in, &bulk_reply,
+                                     offsetof(list_bulk_reply_t, member_list)
+                                         + member_num * sizeof(linux_app_test_setting_t));
+        if (check != ERROR_OK) {
+
+            return check;
+        }
+
+        if (bulk_reply.first_index != i || bulk_reply.member_num != member_num) {
 
             return FAILED_TO_RECEIVE_MASSAGE;
         }
 
-        /* count number of thread's every time the name of test begin with "#"
-         (indicating the lest test belonging to task (or thread on pc app side) )*/
-        if (handel_in->test_raw_results_list[i].test_request_pack.test_name[0] == '#') {
-            handel_in->thread_num++;
+        for (uint16_t member = 0; member < member_num; member++) {
+
+            handel_in->test_raw_results_list[i + member].test_request_pack = bulk_reply.member_list[member];
+
+            /* each test declares its data size, it needs to fit in a test request and be tested by the card */
+            if (bulk_reply.member_list[member].payload_size < MIN_BUF_LEN
+                || bulk_reply.member_list[member].payload_size > MAX_BUF_LEN
+                || (handel_in->hello.protocol_version != 0
+                    && (bulk_reply.member_list[member].payload_size < handel_in->hello.min_payload_size
+                        || bulk_reply.member_list[member].payload_size > handel_in->hello.max_payload_size))) {
+
+                return PROTOCOL_ERROR;
+            }
+
+            /* count number of thread's every time the name of test begin with "#"
+             (indicating the lest test belonging to task (or thread on pc app side) )*/
+            if (bulk_reply.member_list[member].test_name[0] == '#') {
+                handel_in->thread_num++;
+            }
         }
     }
 
+    /* the card said in the hello how many testing tasks it runs */
+    if (handel_in->hello.protocol_version != 0 && handel_in->thread_num != handel_in->hello.test_list_size) {
+
+        return PROTOCOL_ERROR;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           set the number of iterations of each test and empty its result sums, and allocate the transfer
+ *                  curve of the sweep tests.
+ *                  a test named in the configuration test_iterations_list runs its own number of iterations,
+ *                  the others the configured iterations or, in adaptive mode, min_iterations up to max_iterations
+ * \note            the function arrange in this library file in the same order that they need to be called
+ *                  do not call this function befor privies are called
+ * \param[in]       handel_in: library structure with the test list read from the card
+ * \param[out]      error:error massage
+ */
+uint8_t
+allocate_test_results_mem(unit_test_pack_t* handel_in) {
+
+    test_recurses_t* test; /* test initialised */
+    uint16_t chunk_codes;  /* dac codes of a chunk of a sweep test */
+
+    for (uint16_t test_index = 0; test_index < handel_in->list_len; test_index++) {
+
+        test = &handel_in->test_raw_results_list[test_index];
+
+        if (handel_in->config.adaptive) {
+            test->iteration_min = handel_in->config.min_iterations;
+            test->iteration_max = handel_in->config.max_iterations;
+        } else {
+            test->iteration_min = handel_in->config.iterations;
+            test->iteration_max = handel_in->config.iterations;
+        }
+
+        /* the names are compared without the '#' or ' ' the card puts in front of them, like in the results files */
+        for (uint8_t i = 0; i < handel_in->config.test_iterations_num; i++) {
+
+            if (strncmp(handel_in->config.test_iterations_list[i].test_name,
+                        (const char*)&test->test_request_pack.test_name[1], test_name_SIZE - 1)
+                == 0) {
+                test->iteration_min = handel_in->config.test_iterations_list[i].iterations;
+                test->iteration_max = handel_in->config.test_iterations_list[i].iterations;
+            }
+        }
+
+        /* a sweep test runs each chunk of the sweep once, whatever the number of iterations */
+        if (test->test_request_pack.criteria == LINEARITY_criteria) {
+
+            if (test->test_request_pack.payload_size < sizeof(sweep_request_t) + LINEARITY_ADC_NUM * sizeof(uint16_t)) {
+                return PROTOCOL_ERROR;
+            }
+
+            test->linearity = (linearity_t*)malloc(sizeof(linearity_t));
+            if (test->linearity == NULL) {
+                return MALLOC_FAILED;
+            }
+            linearity_init(test->linearity, handel_in->config.sweep_step, handel_in->config.sweep_average);
+
+            chunk_codes = sweep_chunk_codes(test->test_request_pack.payload_size);
+            test->iteration_min = (sweep_code_num(handel_in->config.sweep_step) + chunk_codes - 1) / chunk_codes;
+            test->iteration_max = test->iteration_min;
+        }
+
+        memset(&test->sums, 0, sizeof(test->sums));
+    }
+
     return ERROR_OK;
 }
 
@@ -384,9 +1033,15 @@ allocating_testing_threads_handles(unit_test_pack_t* handel_in) {
     }
 
     handel_in->testing_thread_attr = (pthread_attr_t*)malloc(sizeof(pthread_attr_t) * handel_in->thread_num);
-    if (handel_in->thread_handel_list == NULL) {
+    if (handel_in->testing_thread_attr == NULL) {
         return MALLOC_FAILED;
     }
+
+    /* mark thread sockets as not created yet, so they are not closed if the test stops before creating them */
+    for (uint16_t i = 0; i < handel_in->thread_num; i++) {
+        handel_in->test_thread_input_list[i].thread_socket.task_port_socket_fd = -1;
+    }
+
     return ERROR_OK;
 }
 
@@ -421,6 +1076,36 @@ initialising_testing_threads_input(unit_test_pack_t* handel_in) {
 
         /* init the start address of the tests */
         handel_in->test_thread_input_list[thread_handle_num].first_test_addr = temp_ptr;
+        handel_in->test_thread_input_list[thread_handle_num].first_test_index =
+            (uint16_t)(temp_ptr - handel_in->test_raw_results_list);
+
+        /* all tests are run, and their results are not journaled, unless the journal is opened */
+        handel_in->test_thread_input_list[thread_handle_num].first_test = 0;
+        handel_in->test_thread_input_list[thread_handle_num].result_queue = NULL;
+        handel_in->test_thread_input_list[thread_handle_num].result = ERROR_OK;
+        handel_in->test_thread_input_list[thread_handle_num].precision = handel_in->config.precision;
+        handel_in->test_thread_input_list[thread_handle_num].adc_tolerance = adc_tolerance_lsb(&handel_in->config);
+
+        /* every thread sends its own data, repeated by running again with the same seed */
+        payload_init(&handel_in->test_thread_input_list[thread_handle_num].payload, handel_in->config.pattern,
+                     handel_in->config.seed, thread_handle_num);
+
+        /* copy card uniq id, in order for the test requests of the thread to be received by this card */
+        memcpy(handel_in->test_thread_input_list[thread_handle_num].card_id, handel_in->commend.id,
+               sizeof(handel_in->commend.id));
+
+        /* number of test requests the thread keeps in flight, and how long it waits for their replies.
+           no more requests are sent then the card can queue */
+        handel_in->test_thread_input_list[thread_handle_num].window = handel_in->config.window;
+        if (handel_in->hello.protocol_version != 0
+            && handel_in->config.window > (uint16_t)handel_in->hello.request_queue_size + 1) {
+
+            handel_in->test_thread_input_list[thread_handle_num].window = handel_in->hello.request_queue_size + 1;
+        }
+        handel_in->test_thread_input_list[thread_handle_num].timeout_ms = handel_in->config.timeout_ms;
+        handel_in->test_thread_input_list[thread_handle_num].retries = handel_in->config.retries;
+        handel_in->test_thread_input_list[thread_handle_num].cycle_clock_hz =
+            (handel_in->hello.features & FEATURE_CYCLE_COUNT) ? handel_in->hello.cycle_clock_hz : 0;
 
         /* creating socket for thread */
         handel_in->test_thread_input_list[thread_handle_num].thread_socket.task_port_socket_fd = socket(AF_INET,
@@ -433,12 +1118,16 @@ initialising_testing_threads_input(unit_test_pack_t* handel_in) {
         memset(&handel_in->test_thread_input_list[thread_handle_num].thread_socket.addr, '\0', sizeof(handel_in->addr));
         handel_in->test_thread_input_list[thread_handle_num].thread_socket.addr.sin_family = AF_INET;
 
-        /* setting socket port value to the thread number offset by  SERVER_OFFSET_PORT*/
-        handel_in->test_thread_input_list[thread_handle_num].thread_socket.addr.sin_port = htons(SERVER_OFFSET_PORT
-                                                                                                 + thread_handle_num);
-        handel_in->test_thread_input_list[thread_handle_num].thread_socket.addr.sin_addr.s_addr = inet_addr(STM_IP);
+        /* setting socket port value to the thread number offset by the configured server offset port */
+        handel_in->test_thread_input_list[thread_handle_num].thread_socket.addr.sin_port = htons(
+            handel_in->config.server_offset_port + thread_handle_num);
+        handel_in->test_thread_input_list[thread_handle_num].thread_socket.addr.sin_addr.s_addr = inet_addr(
+            handel_in->config.stm_ip);
         handel_in->test_thread_input_list[thread_handle_num].thread_socket.addr_size = sizeof(struct sockaddr_in);
 
+        /* no test requests in flight until the thread tests are started */
+        test_stream_reset(&handel_in->test_thread_input_list[thread_handle_num]);
+
         /* initializing the next thread  tests start address */
         temp_ptr = &temp_ptr[index];
     }
@@ -501,6 +1190,11 @@ creating_and_joining_testing_threads(unit_test_pack_t* handel_in) {
 
                 return THREAD_CREATE_FAILED;
             }
+
+            /* a thread stopped by a send or receive error fails the card, its other tasks are not run */
+            if (handel_in->test_thread_input_list[thread_create_index].result != ERROR_OK) {
+                return handel_in->test_thread_input_list[thread_create_index].result;
+            }
         }
     }
 
@@ -533,6 +1227,14 @@ creating_and_joining_testing_threads(unit_test_pack_t* handel_in) {
         }
     }
 
+    /* the first send or receive error of a thread fails the card */
+    for (uint16_t thread_index = 0; thread_index < handel_in->thread_num; thread_index++) {
+
+        if (handel_in->test_thread_input_list[thread_index].result != ERROR_OK) {
+            return handel_in->test_thread_input_list[thread_index].result;
+        }
+    }
+
     return ERROR_OK;
 }
 
@@ -546,12 +1248,20 @@ creating_and_joining_testing_threads(unit_test_pack_t* handel_in) {
 void
 close_test_threads_sockets(unit_test_pack_t* handel_in) {
 
-    for (uint16_t thread_socket = 0; thread_socket < handel_in->thread_num; thread_socket++) {
+    if (handel_in->test_thread_input_list != NULL) {
+
+        for (uint16_t thread_socket = 0; thread_socket < handel_in->thread_num; thread_socket++) {
 
-        close(handel_in->test_thread_input_list[thread_socket].thread_socket.task_port_socket_fd);
+            if (handel_in->test_thread_input_list[thread_socket].thread_socket.task_port_socket_fd != -1) {
+                close(handel_in->test_thread_input_list[thread_socket].thread_socket.task_port_socket_fd);
+            }
+        }
     }
 
-    close(handel_in->sockfd);
+    if (handel_in->sockfd != -1) {
+        close(handel_in->sockfd);
+        handel_in->sockfd = -1;
+    }
 }
 
 /**
@@ -564,6 +1274,10 @@ close_test_threads_sockets(unit_test_pack_t* handel_in) {
 void
 free_allocated_recurses(unit_test_pack_t* handel_in) {
 
+    for (uint16_t i = 0; handel_in->test_raw_results_list != NULL && i < handel_in->list_len; i++) {
+        free(handel_in->test_raw_results_list[i].linearity);
+    }
+
     free(handel_in->test_thread_input_list);
     handel_in->test_thread_input_list = NULL;
 
@@ -576,3 +1290,392 @@ free_allocated_recurses(unit_test_pack_t* handel_in) {
     free(handel_in->testing_thread_attr);
     handel_in->testing_thread_attr = NULL;
 }
+
+/**
+ * \brief           check if the results of a test converged, in adaptive mode
+ * \note            the 95% confidence interval of the average time elapsed needs to be within +-precision% of it,
+ *                  and the interval of the failure rate within +-precision%. both are compared squared,
+ *                  so no square root is needed
+ * \param[in]       test: test and its results
+ * \param[in]       precision: precision in percent
+ * \param[out]      return: 1 if the results converged, 0 otherwise
+ */
+static uint8_t
+test_converged(const test_recurses_t* test, uint8_t precision) {
+
+    double iterations = test->iteration_num; /* number of results */
+    double tolerance = precision / 100.0;    /* precision as a fraction */
+    double failure_rate;                     /* fraction of the iterations that failed */
+    double variance;                         /* variance of the time elapsed of the successful iterations */
+
+    if (test->iteration_num == 0) {
+        return 0;
+    }
+
+    /* normal approximation of the failure rate interval. a test with no failures converges on its first results */
+    failure_rate = (iterations - test->latency.count) / iterations;
+    if (CONFIDENCE_Z * CONFIDENCE_Z * failure_rate * (1.0 - failure_rate) / iterations > tolerance * tolerance) {
+        return 0;
+    }
+
+    /* interval of the average time elapsed */
+    if (test->latency.count > 1) {
+
+        variance = test->latency.m2 / (test->latency.count - 1);
+        if (CONFIDENCE_Z * CONFIDENCE_Z * variance / test->latency.count
+            > tolerance * tolerance * test->latency.mean * test->latency.mean) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * \brief           queue the test done record of a test for the journal, once no more iterations are requested
+ *                  and all the iterations requested have a result
+ * \param[in]       stream: testing thread input
+ * \param[in]       test_number: test index from the thread first test
+ */
+static void
+test_stream_test_done(tasting_thread_pack_t* stream, uint8_t test_number) {
+
+    test_recurses_t* test = &stream->first_test_addr[test_number]; /* test checked */
+
+    if (test->sending_done && test->iteration_num == test->iteration_sent) {
+        journal_push_test_done(stream->result_queue, stream->first_test_index + test_number, test->iteration_num);
+    }
+}
+
+/**
+ * \brief           start a testing thread tests from the first test and first iteration
+ * \note            a test stream is the tests of one stm testing task. each test request is numbered
+ *                  by its sequence number, and up to "window" requests are in flight on the task port.
+ *                  both the testing threads and the event loop run tests with the test_stream functions
+ * \param[in]       stream: testing thread input, with the tests to run and the socket
+ */
+void
+test_stream_reset(tasting_thread_pack_t* stream) {
+
+    test_recurses_t* test; /* test emptied */
+
+    if (stream->window == 0 || stream->window > MAX_REQUEST_WINDOW) {
+        stream->window = 1;
+    }
+
+    /* the tests resumed from the journal already have their results */
+    stream->next_sequence = 0;
+    stream->next_test = stream->first_test;
+    stream->in_flight = 0;
+
+    /* empty the results and time elapsed statistics of the tests to run */
+    for (uint8_t i = stream->first_test; i < stream->number_of_test; i++) {
+
+        test = &stream->first_test_addr[i];
+        test->iteration_sent = 0;
+        test->iteration_num = 0;
+        test->sending_done = 0;
+        memset(&test->sums, 0, sizeof(test->sums));
+        latency_stats_init(&test->latency);
+    }
+
+    /* copy card uniq id to transmit buffers, in order for the test requests to be recived  by stm card  */
+    for (uint8_t i = 0; i < stream->window; i++) {
+
+        memcpy(stream->slot_list[i].tx_pocket.id, stream->card_id, sizeof(stream->slot_list[i].tx_pocket.id));
+        stream->slot_list[i].in_flight = 0;
+    }
+}
+
+/**
+ * \brief           check if all the tests and iterations of a test stream were run
+ * \param[in]       stream: testing thread input
+ * \param[out]      return: 1 if all tests finished, 0 otherwise
+ */
+uint8_t
+test_stream_done(const tasting_thread_pack_t* stream) {
+
+    return stream->next_test >= stream->number_of_test && stream->in_flight == 0;
+}
+
+/**
+ * \brief           send test requests of a test stream to the stm card, until "window" requests are in flight
+ * \note            the card runs the requests one after the other in the order they are received,
+ *                  so it does not wait for the network between tests.
+ *                  a test is requested iteration_max times, or in adaptive mode until its results converge
+ *                  after iteration_min iterations
+ * \param[in]       stream: testing thread input
+ * \param[out]      error:error massage
+ */
+uint8_t
+test_stream_fill(tasting_thread_pack_t* stream) {
+
+    ssize_t check;             /* return error check */
+    test_request_slot_t* slot; /* slot of the request sent */
+    test_recurses_t* test;     /* test requested */
+
+    while (stream->next_test < stream->number_of_test) {
+
+        test = &stream->first_test_addr[stream->next_test];
+
+        /* move to the next test, the results of the requests in flight are still stored */
+        if (test->iteration_sent >= test->iteration_max
+            || (test->iteration_sent >= test->iteration_min && test->iteration_num >= test->iteration_min
+                && test_converged(test, stream->precision))) {
+
+            test->sending_done = 1;
+            test_stream_test_done(stream, stream->next_test);
+            stream->next_test++;
+            continue;
+        }
+
+        /* the slot is free once the reply of the request sent "window" requests ago was received */
+        slot = &stream->slot_list[stream->next_sequence % stream->window];
+        if (slot->in_flight) {
+            break;
+        }
+
+        slot->test = stream->next_test;
+        slot->iteration = test->iteration_sent;
+        slot->tx_pocket.request = stream->next_test; /* test number to be run */
+        slot->tx_pocket.sequence = (uint16_t)stream->next_sequence;
+        slot->tx_pocket.data_len = test->test_request_pack.payload_size; /* test data size */
+
+        /* generate the test data to check peripheral, a sweep test asks for the next chunk of the sweep */
+        if (test->test_request_pack.criteria == LINEARITY_criteria) {
+
+            sweep_request_fill(test, slot->iteration, slot->tx_pocket.data);
+
+        } else {
+
+            payload_fill(&stream->payload, slot->tx_pocket.data, slot->tx_pocket.data_len);
+        }
+
+        /* the samples of an analog test are 12 bit dac codes */
+        if (test->test_request_pack.criteria == ADC_criteria) {
+
+            for (uint16_t i = 1; i < slot->tx_pocket.data_len; i += ADC_SAMPLE_SIZE) {
+                slot->tx_pocket.data[i] &= ADC_CODE_MAX >> 8;
+            }
+        }
+
+        slot->tx_pocket.error_report = MISMATCH;
+
+        /* take the time of the beginning of the test, before the request leaves the socket */
+        slot->send_time = monotonic_time_ns();
+        slot->first_send_time = slot->send_time;
+
+        /* request from stm card to ran a peripheral test on data and the send the data tested back */
+        check = sendto(stream->thread_socket.task_port_socket_fd, (void*)&slot->tx_pocket,
+                       TEST_PACKAGE_HEADER_SIZE + slot->tx_pocket.data_len, 0,
+                       (struct sockaddr*)&stream->thread_socket.addr, sizeof(stream->thread_socket.addr));
+        if (check == -1) {
+
+            return FAILED_TO_SEND_MASSAGE;
+        }
+
+        slot->in_flight = 1;
+        slot->retries = 0;
+        stream->in_flight++;
+        stream->next_sequence++;
+        test->iteration_sent++;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           receive one reply of a test request in flight and store the test result
+ * \note            replies not matching a request in flight, duplicated or too late, are dropped
+ * \param[in]       stream: testing thread input
+ * \param[in]       flags: recvfrom flags, MSG_DONTWAIT to return NO_MASSAGE_WAITING instead of blocking
+ * \param[out]      error:error massage
+ */
+uint8_t
+test_stream_receive(tasting_thread_pack_t* stream, int flags) {
+
+    ssize_t check;                    /* return error check */
+    unit_tasting_package_t rx_pocket; /* udp receive buffer */
+    uint64_t receive_time;            /* monotonic time in ns the reply was received */
+    test_request_slot_t* slot = NULL; /* slot of the request the reply belongs to */
+    test_recurses_t* test;            /* test the reply belongs to */
+    single_test_result_t result;      /* result of the iteration the reply belongs to */
+
+    /* receive from stm data tested  */
+    check = recvfrom(stream->thread_socket.task_port_socket_fd, (void*)&rx_pocket, sizeof(rx_pocket), flags,
+                     (struct sockaddr*)&stream->thread_socket.addr, &stream->thread_socket.addr_size);
+    if (check == -1) {
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return NO_MASSAGE_WAITING;
+        }
+
+        return FAILED_TO_RECEIVE_MASSAGE;
+    }
+
+    receive_time = monotonic_time_ns();
+
+    if (check < (ssize_t)TEST_PACKAGE_HEADER_SIZE
+        || check != (ssize_t)(TEST_PACKAGE_HEADER_SIZE + rx_pocket.data_len)) {
+        return ERROR_OK;
+    }
+
+    /* only the low 16 bits of the sequence are sent, so the reply is matched against the few requests in flight */
+    for (uint8_t i = 0; i < stream->window; i++) {
+
+        if (stream->slot_list[i].in_flight && stream->slot_list[i].tx_pocket.sequence == rx_pocket.sequence
+            && stream->slot_list[i].tx_pocket.data_len == rx_pocket.data_len) {
+            slot = &stream->slot_list[i];
+            break;
+        }
+    }
+
+    if (slot == NULL) {
+        return ERROR_OK;
+    }
+
+    test = &stream->first_test_addr[slot->test];
+    memset(&result, 0, sizeof(result));
+
+    /* compute and store test time elapsed, and the part of it the card spent running the test function.
+       the reply may be the one of an earlier try, so the time is measured from the first try */
+    result.time_elapsed = receive_time - slot->first_send_time;
+    result.card_time = cycles_to_ns(rx_pocket.test_cycles, stream->cycle_clock_hz);
+    for (uint8_t i = 0; i < TEST_PHASE_NUM; i++) {
+
+        result.phase_time[i] = cycles_to_ns(rx_pocket.phase_cycles[i], stream->cycle_clock_hz);
+    }
+
+    /* the frame latencies are card cycles, the bus times are bit times of the bus */
+    result.bus.frames = rx_pocket.bus.frames;
+    result.bus.bus_bits = rx_pocket.bus.bus_bits;
+    result.bus.bus_time = rx_pocket.bus.bus_time;
+    result.bus.bitrate = rx_pocket.bus.bitrate;
+    result.bus.latency_sum = cycles_to_ns(rx_pocket.bus.latency_sum, stream->cycle_clock_hz);
+    result.bus.latency_max = cycles_to_ns(rx_pocket.bus.latency_max, stream->cycle_clock_hz);
+    result.stream.bytes = rx_pocket.stream.bytes;
+    result.stream.bit_errors = rx_pocket.stream.bit_errors;
+    result.stream.error_blocks = rx_pocket.stream.error_blocks;
+    result.stream.stream_time = cycles_to_ns(rx_pocket.stream.stream_cycles, stream->cycle_clock_hz);
+
+    /* evaluating test result */
+    if (rx_pocket.error_report != NO_ERROR) {
+
+        result.preferments.data_match = rx_pocket.error_report;
+
+    } else {
+
+        preferments_check(&result.preferments, test->test_request_pack.criteria, rx_pocket.data,
+                          slot->tx_pocket.data, slot->tx_pocket.data_len, stream->adc_tolerance);
+    }
+
+    /* the statistics are updated as the replies arrive, so they do not need the results of every iteration */
+    test_result_add(test, &result);
+    if (result.preferments.data_match == NO_ERROR && test->linearity != NULL) {
+        sweep_store(test->linearity, rx_pocket.data);
+    }
+
+    /* the result is written to the journal by the journal writer, the test does not waite for the disk */
+    journal_push(stream->result_queue, stream->first_test_index + slot->test, slot->iteration, &result);
+
+    slot->in_flight = 0;
+    stream->in_flight--;
+    test->iteration_num++;
+    test_stream_test_done(stream, slot->test);
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           send again the test requests with no reply in time, or count them as LOST after all retries
+ * \note            a request sent again keeps its sequence number and data, so a late reply of an earlier try
+ *                  is accepted like the reply of the last try. only send_time moves, the time elapsed of the
+ *                  iteration is still measured from first_send_time
+ * \param[in]       stream: testing thread input
+ * \param[out]      error:error massage
+ */
+uint8_t
+test_stream_expire(tasting_thread_pack_t* stream) {
+
+    ssize_t check;               /* return error check */
+    uint64_t now;                /* current time in ns */
+    test_request_slot_t* slot;   /* slot checked */
+    test_recurses_t* test;       /* test of a lost request */
+    single_test_result_t result; /* result of a lost request */
+
+    now = monotonic_time_ns();
+
+    for (uint8_t i = 0; i < stream->window; i++) {
+
+        slot = &stream->slot_list[i];
+        if (!slot->in_flight
+            || now - slot->send_time < (uint64_t)retry_timeout_ms(stream->timeout_ms, slot->retries) * NS_IN_MS) {
+            continue;
+        }
+
+        if (slot->retries < stream->retries) {
+
+            slot->send_time = monotonic_time_ns();
+            check = sendto(stream->thread_socket.task_port_socket_fd, (void*)&slot->tx_pocket,
+                           TEST_PACKAGE_HEADER_SIZE + slot->tx_pocket.data_len, 0,
+                           (struct sockaddr*)&stream->thread_socket.addr, sizeof(stream->thread_socket.addr));
+            if (check == -1) {
+
+                return FAILED_TO_SEND_MASSAGE;
+            }
+
+            slot->retries++;
+            continue;
+        }
+
+        /* no reply, also after all the retries */
+        test = &stream->first_test_addr[slot->test];
+        memset(&result, 0, sizeof(result));
+        result.preferments.data_match = LOST;
+        test_result_add(test, &result);
+
+        journal_push(stream->result_queue, stream->first_test_index + slot->test, slot->iteration, &result);
+
+        slot->in_flight = 0;
+        stream->in_flight--;
+        test->iteration_num++;
+        test_stream_test_done(stream, slot->test);
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * \brief           time until the first test request in flight needs to be sent again or counted as LOST
+ * \param[in]       stream: testing thread input
+ * \param[out]      return: time in ms, 0 if a request is already late, -1 if no request is in flight
+ */
+int
+test_stream_timeout_ms(const tasting_thread_pack_t* stream) {
+
+    uint64_t now;       /* current time in ns */
+    int64_t left_ns;    /* time left for a request */
+    int64_t first = -1; /* shortest time left */
+
+    now = monotonic_time_ns();
+
+    for (uint8_t i = 0; i < stream->window; i++) {
+
+        if (!stream->slot_list[i].in_flight) {
+            continue;
+        }
+
+        left_ns = (int64_t)retry_timeout_ms(stream->timeout_ms, stream->slot_list[i].retries) * NS_IN_MS
+                  - (int64_t)(now - stream->slot_list[i].send_time);
+        if (left_ns < 0) {
+            left_ns = 0;
+        }
+
+        if (first == -1 || left_ns < first) {
+            first = left_ns;
+        }
+    }
+
+    /* round up, so the waite does not end just before the deadline */
+    return first == -1 ? -1 : (int)((first + NS_IN_MS - 1) / NS_IN_MS);
+}
@@ -37,8 +37,11 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <limits.h>
+#include <math.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <pthread.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -48,6 +51,9 @@
 #include <sys/types.h>
 #include <time.h>
 #include <unistd.h>
+#include "latency_stats.h"
+#include "linearity.h"
+#include "payload.h"
 /**
  * \brief    size of test name array       
  * \hideinitializer
@@ -55,13 +61,19 @@
 #define test_name_SIZE           100
 
 /**
- * \brief    test data buff size      
+ * \brief    biggest test data size, a test request still fits in one ethernet mtu
  * \hideinitializer
  */
-#define MAX_BUF_LEN              100
+#define MAX_BUF_LEN              1400
 
 /**
- * \brief          test's first port increment for each task 
+ * \brief    smallest test data size
+ * \hideinitializer
+ */
+#define MIN_BUF_LEN              1
+
+/**
+ * \brief          default test's first port increment for each task 
  * \hideinitializer
  */
 #define SERVER_OFFSET_PORT       50007
@@ -79,7 +91,7 @@
 #define TEST_RUNNING             1
 
 /**
- * \brief                    app initialisation task port
+ * \brief                    default app initialisation task port
  * \hideinitializer
  */
 #define APP_INIT_PORT            50006
@@ -101,6 +113,12 @@
  * \hideinitializer
  */
 #define ID_SIZE                  3
+
+/**
+ * \brief                     size of the firmware build string of the card hello
+ * \hideinitializer
+ */
+#define FIRMWARE_BUILD_SIZE      32
 /**
  * \brief                     request board uniq id
  * \hideinitializer
@@ -120,10 +138,98 @@
 #define LIST_MEMBER_REQUEST      2
 
 /**
- * \brief                      number of test iterations
+ * \brief                      request as many test list members as fit in one datagram, from list_index on
  * \hideinitializer
  */
-#define NUM_OF_CHECKS            60
+#define LIST_BULK_REQUEST        3
+
+/**
+ * \brief                      test list members sent in one LIST_BULK_REQUEST reply,
+ *                             as many as fit in an ethernet mtu (1472 bytes of udp payload)
+ * \hideinitializer
+ */
+#define LIST_BULK_MAX_MEMBERS    14
+
+/**
+ * \brief                      request card id, list sizes, protocol version and capabilities in one reply
+ * \hideinitializer
+ */
+#define HELLO_REQUEST            4
+
+/**
+ * \brief                      version of the unit test protocol, sent in the hello reply.
+ *                             incremented on every change of the protocol structs
+ * \hideinitializer
+ */
+#define PROTOCOL_VERSION         8
+
+/**
+ * \brief                      hello feature, the card answers LIST_BULK_REQUEST
+ * \hideinitializer
+ */
+#define FEATURE_LIST_BULK        0x01
+
+/**
+ * \brief                      hello feature, the card sends back the test request sequence number
+ * \hideinitializer
+ */
+#define FEATURE_SEQUENCE         0x02
+
+/**
+ * \brief                      hello feature, the card queues test requests sent while a test is running
+ * \hideinitializer
+ */
+#define FEATURE_REQUEST_QUEUE    0x04
+
+/**
+ * \brief                      hello feature, the card times the tests with its cycle counter
+ * \hideinitializer
+ */
+#define FEATURE_CYCLE_COUNT      0x08
+
+/**
+ * \brief                      default number of test iterations
+ * \hideinitializer
+ */
+#define DEFAULT_ITERATIONS       60
+
+/**
+ * \brief                     maximum number of iterations of a test
+ * \hideinitializer
+ */
+#define MAX_ITERATIONS           1000000
+
+/**
+ * \brief                     default smallest number of iterations of a test in adaptive mode
+ * \hideinitializer
+ */
+#define DEFAULT_MIN_ITERATIONS   20
+
+/**
+ * \brief                     default biggest number of iterations of a test in adaptive mode
+ * \hideinitializer
+ */
+#define DEFAULT_MAX_ITERATIONS   1000
+
+/**
+ * \brief                     default adaptive mode precision in percent. a test stops once the 95% confidence
+ *                            interval of its average time elapsed is within +-precision% of it, and the interval
+ *                            of its failure rate within +-precision%
+ * \hideinitializer
+ */
+#define DEFAULT_PRECISION        5
+
+/**
+ * \brief                     normal distribution quantile of the adaptive mode confidence intervals, 95%
+ * \hideinitializer
+ */
+#define CONFIDENCE_Z             1.96
+
+/**
+ * \brief                     maximum number of tests with their own number of iterations
+ * \hideinitializer
+ */
+#define MAX_TEST_ITERATIONS      16
 
 /**
  * \brief                     communication evaluation criteria
@@ -138,10 +244,81 @@
 #define ADC_criteria             1
 
 /**
- * \brief                     analog criteria error range still considered successful
+ * \brief                     dac to adc linearity sweep evaluation criteria, the test data is a sweep_request_t
+ *                            followed by the sums of the adc codes the card converted
  * \hideinitializer
  */
-#define ADC_SUCCESS_ERROR_RANGE  200
+#define LINEARITY_criteria       2
+
+/**
+ * \brief                     frame bus evaluation criteria, the test data is compared like a COMMUNICATION_criteria
+ *                            test and the reply carries the bus statistics of the frames that moved it
+ * \hideinitializer
+ */
+#define BUS_criteria             3
+
+/**
+ * \brief                     stream evaluation criteria, the card streams the test data over its peripheral pair for
+ *                            the stream time of the test, checks it as it comes in and replies the stream statistics
+ * \hideinitializer
+ */
+#define STREAM_criteria          4
+
+/**
+ * \brief                     most adc samples the card sums at each dac code of a sweep, the sum fits 16 bits
+ * \hideinitializer
+ */
+#define SWEEP_MAX_AVERAGE        16
+
+/**
+ * \brief                     default dac codes between the codes of a sweep, 1 sweeps all the codes
+ * \hideinitializer
+ */
+#define DEFAULT_SWEEP_STEP       1
+
+/**
+ * \brief                     default adc samples summed at each dac code of a sweep
+ * \hideinitializer
+ */
+#define DEFAULT_SWEEP_AVERAGE    4
+
+/**
+ * \brief                     bytes of one analog sample in the test data of an ADC_criteria test,
+ *                            a little endian dac code sent and the adc code sent back in its place
+ * \hideinitializer
+ */
+#define ADC_SAMPLE_SIZE          2
+
+/**
+ * \brief                     biggest 12 bit dac and adc code
+ * \hideinitializer
+ */
+#define ADC_CODE_MAX             4095
+
+/**
+ * \brief                     default largest difference in LSB between the adc code and the dac code of a sample
+ *                            still considered successful
+ * \hideinitializer
+ */
+#define DEFAULT_ADC_TOLERANCE    20
+
+/**
+ * \brief                     default adc and dac reference voltage in mV, the full scale of the codes
+ * \hideinitializer
+ */
+#define DEFAULT_VREF_MV          3300
+
+/**
+ * \brief                     default results history file, in the directory the results files are written to
+ * \hideinitializer
+ */
+#define DEFAULT_HISTORY_FILE     "unit test history.bin"
+
+/**
+ * \brief                     size of the results history file name
+ * \hideinitializer
+ */
+#define HISTORY_PATH_SIZE        256
 
 /**
  * \brief                     test success
@@ -162,11 +339,90 @@
 #define TXT_TRANSFER_SIZE        1000
 
 /**
- * \brief                     stm card under test ip address
+ * \brief                     default stm card under test ip address
  * \hideinitializer
  */
 #define STM_IP                   "192.168.8.2"
 
+/**
+ * \brief                     size of buffer holding an ip address string
+ * \hideinitializer
+ */
+#define IP_ADDR_SIZE             INET_ADDRSTRLEN
+
+/**
+ * \brief                     tests run by a thread for each testing task
+ * \hideinitializer
+ */
+#define ENGINE_THREADS           0
+
+/**
+ * \brief                     tests of all testing tasks run by event loop threads, multiplexing the task sockets
+ * \hideinitializer
+ */
+#define ENGINE_EPOLL             1
+
+/**
+ * \brief                     results file format, one sentence of text for each test
+ * \hideinitializer
+ */
+#define RESULT_FORMAT_TEXT       0x01
+
+/**
+ * \brief                     results file format, one json object on a line for each test
+ * \hideinitializer
+ */
+#define RESULT_FORMAT_JSONL      0x02
+
+/**
+ * \brief                     results file format, one csv line for each test after a header line
+ * \hideinitializer
+ */
+#define RESULT_FORMAT_CSV        0x04
+
+/**
+ * \brief                     maximum number of event loop threads
+ * \hideinitializer
+ */
+#define MAX_EVENT_THREADS        64
+
+/**
+ * \brief                     maximum number of test requests in flight for each testing task.
+ *                            the card queues TEST_REQUEST_QUEUE_SIZE (4) requests while testing one
+ * \hideinitializer
+ */
+#define MAX_REQUEST_WINDOW       5
+
+/**
+ * \brief                     default time to waite for a reply before sending the request again, in ms
+ * \hideinitializer
+ */
+#define DEFAULT_TIMEOUT_MS       500
+
+/**
+ * \brief                     longest time to waite for a reply, the timeout doubles on each retry up to it, in ms
+ * \hideinitializer
+ */
+#define MAX_TIMEOUT_MS           60000
+
+/**
+ * \brief                     default number of times a request is sent again before it counts as lost
+ * \hideinitializer
+ */
+#define DEFAULT_RETRIES          3
+
+/**
+ * \brief                     maximum number of times a request is sent again
+ * \hideinitializer
+ */
+#define MAX_RETRIES              10
+
+/**
+ * \brief                     maximum number of cards tested simultaneously by one application
+ * \hideinitializer
+ */
+#define MAX_CARDS                256
+
 /**
  * \brief                     testing thread stack size
  * \hideinitializer
@@ -192,10 +448,40 @@
 #define IT_MODE                  1
 
 /**
- * \brief                     divided by to convert us to ms
+ * \brief                     divided by to convert ns to ms
+ * \hideinitializer
+ */
+#define NS_TO_MS                 1000000.0
+
+/**
+ * \brief                     ns in a ms
+ * \hideinitializer
+ */
+#define NS_IN_MS                 1000000
+
+/**
+ * \brief                     ns in a second
+ * \hideinitializer
+ */
+#define NS_IN_SEC                1000000000
+
+/**
+ * \brief                     bytes in a MB, of the stream throughput
  * \hideinitializer
  */
-#define US_TO_MS                 1000.0
+#define BYTES_IN_MB              1000000
+
+/**
+ * \brief          highest number fitting in a byte
+ * \hideinitializer 
+ */
+#define UINT8_T_RANGE            0XFF
+
+/**
+ * \brief                     bits in a byte, the bit positions of the bit error histograms
+ * \hideinitializer
+ */
+#define BITS_IN_BYTE             8
 
 /**
  * \brief     return marcos to indicate error's     
@@ -210,7 +496,15 @@ typedef enum lib_error_massages {
     THREAD_CREATE_FAILED,              /*!< failed to create a thread   */
     THREAD_ATTR_INIT_FAILED,           /*!< thread_attr_init failed   */
     THREAD_ATTR_SET_STACK_SIZE_FAILED, /*!< thread_attr set failed */
-    GF_ERROR                           /*!< failed to generate results file */
+    GF_ERROR,                          /*!< failed to generate results file */
+    CONFIG_ERROR,                      /*!< bad command line argument or configuration file */
+    NO_MASSAGE_WAITING,                /*!< non blocking receive found no udp pocket waiting */
+    EVENT_LOOP_FAILED,                 /*!< failed to create or waite on the event loop epoll instance */
+    REPLY_TIMEOUT,                     /*!< the card did not reply, also after all the retries */
+    PROTOCOL_ERROR,                    /*!< card protocol version, payload sizes or test list do not match the app */
+    JOURNAL_FAILED,                    /*!< failed to create, read or write the results journal */
+    HISTORY_FAILED,                    /*!< failed to read or write the results history */
+    REGRESSION_FOUND                   /*!< the results regressed against the card history or its part number */
 } lib_error_massages_t;
 
 /**
@@ -222,10 +516,69 @@ typedef enum error_report {
     HAL_RETURN_ERROR, /*!< report cimsis peripheral function returned error */
     ERROR_IT,         /*!< report error interrupt has jump   */
     OVER_TIME,        /*!< report waited to long for peripheral to resume action */
-    MISMATCH          /*!< date received from stm card doesn't match to the data sent to it*/
+    MISMATCH,         /*!< date received from stm card doesn't match to the data sent to it*/
+    LOST              /*!< no reply from stm card, also after all the retries */
 
 } error_report_t;
 
+/**
+ * \brief           data received shifted by one bit from the data sent, the bits as sent on a serial line,
+ *                  most significant bit of the first byte first
+ */
+typedef enum bit_shift {
+
+    BIT_SHIFT_NONE,  /*!< the data is not shifted */
+    BIT_SHIFT_LEFT,  /*!< the data is received one bit early, the first bit sent was lost */
+    BIT_SHIFT_RIGHT  /*!< the data is received one bit late, a bit was added before the first bit sent */
+
+} bit_shift_t;
+
+/**
+ * \brief           phases of a test the card may time, relative to the start of the test function
+ */
+typedef enum test_phase {
+
+    TEST_PHASE_TX_START,  /*!< the test started the peripheral transfer */
+    TEST_PHASE_RX_DONE,   /*!< the receive complete interrupt */
+    TEST_PHASE_TASK_WAKE, /*!< the test task woke up after the interrupt */
+    TEST_PHASE_NUM        /*!< number of phases */
+
+} test_phase_t;
+
+/**
+ * \brief           statistics of the frames that moved the test data of a BUS_criteria test, 0 for other tests
+ */
+#pragma pack(push, 1)
+
+typedef struct bus_stats {
+
+    uint16_t frames;      /*!< frames received */
+    uint32_t bus_bits;    /*!< bits the frames took on the bus, with the stuff bits and the interframe space */
+    uint32_t bus_time;    /*!< bit times from the start of the first frame to the end of the last frame */
+    uint32_t bitrate;     /*!< bus bits per second */
+    uint32_t latency_sum; /*!< sum of the card cycles from queuing each frame to receiving it */
+    uint32_t latency_max; /*!< most card cycles from queuing a frame to receiving it */
+
+} bus_stats_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           statistics of the data streamed by a STREAM_criteria test, 0 for other tests
+ */
+#pragma pack(push, 1)
+
+typedef struct stream_stats {
+
+    uint32_t bytes;         /*!< bytes received and checked */
+    uint32_t bit_errors;    /*!< bits received different from the bits sent */
+    uint32_t error_blocks;  /*!< blocks checked with a bit error, a block is half the circular buffer or a transfer */
+    uint32_t stream_cycles; /*!< card cycles from the stream start to the last block checked */
+
+} stream_stats_t;
+
+#pragma pack(pop)
+
 /**
  * \brief           unit testing testing communication protocol struct
  */
@@ -233,21 +586,48 @@ typedef enum error_report {
 
 typedef struct uint_tasting_package {
 
-    uint32_t id[ID_SIZE];      /*!< holds stm mcu uniq id */
-    uint8_t request;           /*!< holds app request what test in a task belong to a particular port to run. */
-    uint8_t data[MAX_BUF_LEN]; /*!< data for testing */
-    uint8_t error_report;      /*!< stm32 fill this variable with report about transmission errors */
+    uint32_t id[ID_SIZE];                  /*!< holds stm mcu uniq id */
+    uint8_t request;                       /*!< holds app request what test in a task belong to a particular port
+                                                to run. */
+    uint16_t sequence;                     /*!< app request number, sent back by the card to match the reply */
+    uint8_t error_report;                  /*!< stm32 fill this variable with report about transmission errors */
+    uint16_t data_len;                     /*!< number of data bytes used, only they are sent */
+    uint32_t test_cycles;                  /*!< card cycles the test function ran, filled by the card */
+    uint32_t phase_cycles[TEST_PHASE_NUM]; /*!< card cycles from the test start to each phase the test marked,
+                                                0 if not marked */
+    bus_stats_t bus;                       /*!< bus statistics of a BUS_criteria test, filled by the card */
+    stream_stats_t stream;                 /*!< stream statistics of a STREAM_criteria test, filled by the card */
+    uint8_t data[MAX_BUF_LEN];             /*!< data for testing */
 
 } unit_tasting_package_t;
 
 #pragma pack(pop)
 
 /**
- * \brief           holds task name and setting for linux testing app
- * \note            will be send to linux app to start the testing
- *                      
+ * \brief          size of a test request without its data, the datagram size is this plus data_len
+ * \hideinitializer
+ */
+#define TEST_PACKAGE_HEADER_SIZE offsetof(unit_tasting_package_t, data)
+
+/**
+ * \brief           first bytes of the test data of a LINEARITY_criteria test, one chunk of a dac sweep
+ * \note            the card sets the dac to each code of the chunk, and sums "average" samples of each of the
+ *                  adc_num adcs. the sums follow the header as uint16_t, code after code and adc after adc
  */
 #pragma pack(push, 1)
+
+typedef struct sweep_request {
+
+    uint16_t first_code; /*!< first dac code of the chunk */
+    uint16_t step;       /*!< dac codes between the codes of the chunk */
+    uint16_t code_num;   /*!< number of dac codes of the chunk */
+    uint8_t average;     /*!< adc samples summed at each dac code, up to SWEEP_MAX_AVERAGE */
+    uint8_t adc_num;     /*!< adcs converting each dac code */
+
+} sweep_request_t;
+
+#pragma pack(pop)
+
 /**
  * \brief           holds task name and setting for linux testing app
  * \note            will be send to linux app to start the testing
@@ -260,10 +640,27 @@ typedef struct linux_app_test_setting {
     uint8_t test_name[test_name_SIZE]; /*!< name of test */
     uint8_t criteria;                  /*!< how to masseur the test successes */
     uint8_t pulling_or_it; /*!< telling pc if test is in pulling mode(run separately) or it mode(run simultaneously) for accurate timing */
+    uint16_t payload_size;             /*!< test data size, MIN_BUF_LEN up to MAX_BUF_LEN */
 } linux_app_test_setting_t;
 
 #pragma pack(pop)
 
+/**
+ * \brief           reply to LIST_BULK_REQUEST, a chunk of the test list
+ * \note            only member_num members are sent, bigger lists are read chunk after chunk
+ */
+#pragma pack(push, 1)
+
+typedef struct list_bulk_reply {
+
+    uint16_t first_index;                                        /*!< list index of the first member sent */
+    uint8_t member_num;                                          /*!< number of members sent */
+    linux_app_test_setting_t member_list[LIST_BULK_MAX_MEMBERS]; /*!< test list members */
+
+} list_bulk_reply_t;
+
+#pragma pack(pop)
+
 /**
  * \brief           unit test system. app test initialisation communication  protocol struct
  * \note            app get from the card, card information and tests information
@@ -292,34 +689,186 @@ typedef struct card_name_and_id {
 
 } card_name_and_id_t;
 
+#pragma pack(pop)
+
 /**
- * \brief            data matching preferments
+ * \brief            reply to HELLO_REQUEST. everything the app needs before testing, in one round trip
  */
+#pragma pack(push, 1)
+
+typedef struct card_hello {
+
+    card_name_and_id_t card;                  /*!< card name and uniq id */
+    uint16_t protocol_version;                /*!< PROTOCOL_VERSION of the card */
+    uint16_t pc_test_list_size;               /*!< number of tests */
+    uint16_t test_list_size;                  /*!< number of testing tasks */
+    uint16_t min_payload_size;                /*!< smallest test data size the card tests */
+    uint16_t max_payload_size;                /*!< biggest test data size the card tests */
+    uint8_t request_queue_size;               /*!< test requests the card queues for each task while a test is
+                                                   running */
+    uint32_t features;                        /*!< FEATURE_ flags of the card */
+    uint32_t cycle_clock_hz;                  /*!< clock of the card cycle counter, test_cycles / cycle_clock_hz is
+                                                   the time */
+    char firmware_build[FIRMWARE_BUILD_SIZE]; /*!< firmware build of the card, may not end with '\0' */
+
+} card_hello_t;
+
 #pragma pack(pop)
 
+/**
+ * \brief            sums of the analog samples of a test, the errors are adc code - dac code in LSB.
+ *                   the sums of many tests add up to the best fit line of the adc codes over the dac codes
+ */
+typedef struct analog_sums {
+
+    uint16_t samples;          /*!< samples converted */
+    uint16_t out_of_tolerance; /*!< samples with an error bigger then the tolerance */
+    int16_t max_error;         /*!< error of the sample furthest from its dac code */
+    int32_t sum_error;         /*!< sum of the errors */
+    uint32_t sum_code;         /*!< sum of the dac codes */
+    uint64_t sum_code_sq;      /*!< sum of the dac codes squared */
+    int64_t sum_code_error;    /*!< sum of the dac codes times the errors */
+    uint64_t sum_error_sq;     /*!< sum of the errors squared */
+
+} analog_sums_t;
+
+/**
+ * \brief            data matching preferments
+ */
 typedef struct test_preferments_results {
 
-    uint8_t data_match; /*!< data matching preferments */
+    uint8_t data_match;   /*!< data matching preferments */
+    uint32_t bit_errors;  /*!< bits received different from the bits sent */
+    uint16_t first_error; /*!< offset of the first byte received different from the byte sent, if bit_errors */
+    uint8_t flip_to_one;  /*!< bit positions that flipped from 0 to 1 in any byte */
+    uint8_t flip_to_zero; /*!< bit positions that flipped from 1 to 0 in any byte */
+    uint8_t bit_shift;    /*!< bit_shift_t, the data received is the data sent shifted by one bit */
+    analog_sums_t analog; /*!< analog errors of an ADC_criteria test */
 
 } test_preferments_results_t;
 
+/**
+ * \brief            number of iterations of one test, set by name in the configuration
+ */
+typedef struct test_iterations {
+
+    char test_name[test_name_SIZE]; /*!< name of the test */
+    uint32_t iterations;            /*!< number of iterations, also in adaptive mode */
+
+} test_iterations_t;
+
+/**
+ * \brief            bus statistics of a BUS_criteria test, the frame latencies in ns
+ */
+#pragma pack(push, 1)
+
+typedef struct bus_result {
+
+    uint16_t frames;      /*!< frames received */
+    uint32_t bus_bits;    /*!< bits the frames took on the bus, with the stuff bits and the interframe space */
+    uint32_t bus_time;    /*!< bit times from the start of the first frame to the end of the last frame */
+    uint32_t bitrate;     /*!< bus bits per second */
+    uint64_t latency_sum; /*!< sum of the times from queuing each frame to receiving it, in ns */
+    uint64_t latency_max; /*!< longest time from queuing a frame to receiving it, in ns */
+
+} bus_result_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief            stream statistics of a STREAM_criteria test, the stream time in ns
+ */
+#pragma pack(push, 1)
+
+typedef struct stream_result {
+
+    uint32_t bytes;        /*!< bytes received and checked by the card */
+    uint32_t bit_errors;   /*!< bits received different from the bits sent */
+    uint32_t error_blocks; /*!< blocks checked with a bit error */
+    uint64_t stream_time;  /*!< time from the stream start to the last block checked, in ns */
+
+} stream_result_t;
+
+#pragma pack(pop)
+
 /**
  * \brief            test results.
  */
 typedef struct single_test_result {
 
     test_preferments_results_t preferments; /*!< data matching preferments */
-    uint16_t time_elapsed;                  /*!< test time elapsed */
+    uint64_t time_elapsed;                  /*!< test time elapsed in ns */
+    uint64_t card_time;                     /*!< time in ns the card ran the test function, 0 if not timed */
+    uint64_t phase_time[TEST_PHASE_NUM];    /*!< time in ns from the test start to each phase, 0 if not marked */
+    bus_result_t bus;                       /*!< bus statistics of a BUS_criteria test, 0 for other tests */
+    stream_result_t stream;                 /*!< stream statistics of a STREAM_criteria test, 0 for other tests */
 
 } single_test_result_t;
 
+/**
+ * \brief            sums of the results of a test, each result is added as it arrives.
+ *                   the memory of a test does not grow with its number of iterations
+ */
+typedef struct result_sums {
+
+    uint32_t success_num;                    /*!< tests with data match */
+    uint32_t over_time_error_num;            /*!< tests with over time error */
+    uint32_t interrupt_error_num;            /*!< tests with error interrupt */
+    uint32_t return_error_num;               /*!< tests with HAL return error */
+    uint32_t lost_num;                       /*!< test requests with no reply, also after retries */
+    uint32_t mismatch_num;                   /*!< tests with data mismatch */
+    uint64_t time_elapsed;                   /*!< sum of the time elapsed of the successful tests in ns */
+    uint64_t card_time;                      /*!< sum of the time the card ran the successful tests in ns */
+    uint64_t phase_time[TEST_PHASE_NUM];     /*!< sum of the time to each phase in ns, of the tests that marked it */
+    uint32_t phase_num[TEST_PHASE_NUM];      /*!< successful tests that marked each phase */
+    uint64_t bits_compared;                  /*!< bits of the tests with data compared bit by bit */
+    uint64_t bit_errors;                     /*!< bits received different from the bits sent */
+    uint16_t first_error;                    /*!< earliest byte received different from the byte sent, if bit_errors */
+    uint32_t flip_to_one_num[BITS_IN_BYTE];  /*!< mismatch tests with each bit position flipped from 0 to 1 */
+    uint32_t flip_to_zero_num[BITS_IN_BYTE]; /*!< mismatch tests with each bit position flipped from 1 to 0 */
+    uint32_t shift_left_num;                 /*!< mismatch tests with the data received one bit early */
+    uint32_t shift_right_num;                /*!< mismatch tests with the data received one bit late */
+    uint32_t unshifted_num;                  /*!< mismatch tests not shifted */
+    uint8_t all_to_one;                      /*!< bits flipped to 1 in every mismatch test not shifted */
+    uint8_t all_to_zero;                     /*!< bits flipped to 0 in every mismatch test not shifted */
+    uint8_t any_to_one;                      /*!< bits flipped to 1 in any mismatch test */
+    uint8_t any_to_zero;                     /*!< bits flipped to 0 in any mismatch test */
+    uint64_t analog_samples;                 /*!< analog samples converted */
+    uint64_t out_of_tolerance;               /*!< analog samples with an error bigger then the tolerance */
+    int16_t max_error;                       /*!< analog error of the sample furthest from its dac code */
+    double sum_code;                         /*!< sum of the dac codes of the analog samples */
+    double sum_code_sq;                      /*!< sum of the dac codes squared */
+    double sum_error;                        /*!< sum of the analog errors, adc code - dac code */
+    double sum_code_error;                   /*!< sum of the dac codes times the errors */
+    double sum_error_sq;                     /*!< sum of the errors squared */
+    uint64_t bus_frames;                     /*!< frames received over the bus */
+    uint64_t bus_bits;                       /*!< bits the frames took on the bus */
+    uint64_t bus_time;                       /*!< bit times of the bus tests */
+    double bus_seconds;                      /*!< time of the bus tests on the bus in seconds */
+    uint64_t frame_latency;                  /*!< sum of the frame latencies in ns */
+    uint64_t max_frame_latency;              /*!< longest frame latency in ns */
+    uint64_t stream_bytes;                   /*!< bytes streamed and checked by the card */
+    uint64_t stream_error_blocks;            /*!< blocks streamed with a bit error */
+    uint64_t stream_time;                    /*!< sum of the stream times in ns */
+
+} result_sums_t;
+
 /**
  * \brief            data structure for test.storing test information and results
  */
 typedef struct test_recurses {
 
-    linux_app_test_setting_t test_request_pack;             /*!< test information */
-    single_test_result_t test_results_array[NUM_OF_CHECKS]; /*!< test results */
+    linux_app_test_setting_t test_request_pack; /*!< test information */
+    result_sums_t sums;                         /*!< sums of the test results, the results themselves are only
+                                                     written to the journal */
+    uint32_t iteration_min;                     /*!< smallest number of iterations */
+    uint32_t iteration_max;                     /*!< biggest number of iterations, iteration_min if not adaptive */
+    uint32_t iteration_sent;                    /*!< number of iterations requested from the card */
+    uint32_t iteration_num;                     /*!< number of iterations with a result */
+    uint8_t sending_done;                       /*!< no more iterations are requested */
+    latency_stats_t latency;                    /*!< time elapsed statistics of the successful tests */
+    linearity_t* linearity;                     /*!< transfer curve of a LINEARITY_criteria test, NULL for other
+                                                     tests. dynamicly allocated */
 
 } test_recurses_t;
 
@@ -334,6 +883,23 @@ typedef struct socket_handle {
 
 } socket_handle_t;
 
+/**
+ * \brief            test request sent to the card and waiting for its reply
+ */
+typedef struct test_request_slot {
+
+    unit_tasting_package_t tx_pocket; /*!< test request sent, compared with the reply */
+    uint64_t first_send_time;         /*!< monotonic time in ns the test request was first sent, the test time
+                                           elapsed is measured from it also when the request was sent again */
+    uint64_t send_time;               /*!< monotonic time in ns the test request was last sent, the reply timeout
+                                           runs from it */
+    uint8_t in_flight;                /*!< the test request was sent and its reply is not received yet */
+    uint8_t retries;                  /*!< number of times the test request was sent again */
+    uint8_t test;                     /*!< test of the request, index from the thread first test */
+    uint32_t iteration;               /*!< iteration of the test */
+
+} test_request_slot_t;
+
 /**
  * \brief            data structure sent to thread containing all thread instruction
  *                   and variables to store test results.
@@ -344,10 +910,88 @@ typedef struct tasting_thread_pack {
         first_test_addr;    /*!< holds thread test list address offset. the first peripheral test to be executed  */
     uint8_t number_of_test; /*!< number of tests for thread  to run, 
                                       starting from the test at "first_test_addr" and incrementing */
-    socket_handle_t thread_socket; /*!< thread socket(for communicating with stm) variables */
+    uint16_t first_test_index;        /*!< index of the test at "first_test_addr" in the card test list */
+    socket_handle_t thread_socket;    /*!< thread socket(for communicating with stm) variables */
+    uint32_t card_id[ID_SIZE];        /*!< uniq id of the card the thread is testing, sent with every test request */
+    uint8_t window;                   /*!< maximum number of test requests in flight, up to MAX_REQUEST_WINDOW */
+    uint32_t next_sequence;           /*!< sequence number of the next test request to send, next_sequence % window
+                                           is its slot. its low 16 bits are sent */
+    uint8_t first_test;               /*!< test the thread starts from, the tests before it were resumed
+                                           from the journal */
+    uint8_t next_test;                /*!< test the next test requests are sent for */
+    uint8_t precision;                /*!< adaptive mode precision in percent */
+    uint16_t adc_tolerance;           /*!< largest analog error in LSB of a successful analog sample */
+    uint8_t in_flight;                /*!< number of test requests waiting for a reply */
+    uint16_t timeout_ms;              /*!< time to waite for a reply before sending the request again */
+    uint8_t retries;                  /*!< number of times a request is sent again before it counts as LOST */
+    uint32_t cycle_clock_hz;          /*!< clock of the card cycle counter, 0 if the card does not time the tests */
+    struct result_queue* result_queue; /*!< queue of the results for the journal writer, NULL if not journaled */
+    uint8_t result;                    /*!< ERROR_OK, or the send or receive error that stopped the thread tests */
+    test_request_slot_t slot_list[MAX_REQUEST_WINDOW]; /*!< requests in flight */
+    payload_generator_t payload;                       /*!< test data generator of the thread */
 
 } tasting_thread_pack_t;
 
+/**
+ * \brief            run time configuration, where to find the stm card under test
+ * \note             initialised by unit_test_config_init to the compiled in defaults
+ *                   and then changed from the command line or a configuration file
+ */
+typedef struct unit_test_config {
+
+    char stm_ip[IP_ADDR_SIZE];   /*!< stm card under test ip address */
+    uint16_t app_init_port;      /*!< card app initialisation task port */
+    uint16_t server_offset_port; /*!< card first testing task port, each task port is incremented by one */
+    uint8_t engine;              /*!< ENGINE_THREADS or ENGINE_EPOLL */
+    uint8_t event_threads;       /*!< number of event loop threads, when engine is ENGINE_EPOLL */
+    uint8_t window;              /*!< test requests in flight for each testing task, 1 waits for each reply */
+    uint16_t timeout_ms;         /*!< time to waite for a reply before sending the request again */
+    uint8_t retries;             /*!< number of times a request is sent again before giving up */
+    uint8_t result_formats;      /*!< RESULT_FORMAT_ flags, a results file is written in each format */
+    uint8_t journal;             /*!< write the results to a journal file while the tests run */
+    uint8_t resume;              /*!< skip the tests found in the journal file of a previous run */
+    uint32_t iterations;         /*!< number of iterations of each test, when not adaptive */
+    uint8_t adaptive;            /*!< each test runs until its results converge, between min and max iterations */
+    uint32_t min_iterations;     /*!< smallest number of iterations of a test in adaptive mode */
+    uint32_t max_iterations;     /*!< biggest number of iterations of a test in adaptive mode */
+    uint8_t precision;           /*!< adaptive mode precision in percent */
+    test_iterations_t test_iterations_list[MAX_TEST_ITERATIONS]; /*!< tests with their own number of iterations */
+    uint8_t test_iterations_num;                                 /*!< number of tests in test_iterations_list */
+    uint8_t pattern;             /*!< payload_pattern_t of the test data */
+    uint64_t seed;               /*!< seed of the test data, 0 picks one from the clock */
+    uint16_t adc_tolerance;      /*!< largest analog error of a successful analog sample, in LSB or in mV */
+    uint8_t adc_tolerance_mv;    /*!< adc_tolerance is in mV */
+    uint16_t vref_mv;            /*!< adc and dac reference voltage in mV */
+    uint16_t sweep_step;         /*!< dac codes between the codes of a linearity sweep */
+    uint8_t sweep_average;       /*!< adc samples summed at each dac code of a linearity sweep */
+    char history[HISTORY_PATH_SIZE]; /*!< results history file, empty for no history */
+    uint8_t regression_fail;         /*!< a regression found in the history fails the card, otherwise it is only
+                                          printed */
+
+} unit_test_config_t;
+
+/**
+ * \brief            address of one card to test, ports set to 0 are taken from the default configuration
+ */
+typedef struct card_target {
+
+    char stm_ip[IP_ADDR_SIZE];   /*!< card ip address */
+    uint16_t app_init_port;      /*!< card app initialisation task port, 0 for default */
+    uint16_t server_offset_port; /*!< card first testing task port, 0 for default */
+
+} card_target_t;
+
+/**
+ * \brief            run time configuration of the whole application, the cards to test and their settings
+ */
+typedef struct run_config {
+
+    unit_test_config_t card_default;    /*!< settings shared by all cards, and the card tested when none is listed */
+    card_target_t card_list[MAX_CARDS]; /*!< cards to test simultaneously */
+    uint16_t card_num;                  /*!< number of cards listed, 0 to test only the default card */
+
+} run_config_t;
+
 /**
  * \brief            main library structure, storing everting needed in order to use the library
  * \note             need to declared in order to use the library,
@@ -362,6 +1006,7 @@ typedef struct unit_test_pack {
     pthread_t*
         thread_handel_list; /*!< point to testing thread pthread_t,needed in order to create threads . dynamicly allocated */
     card_name_and_id_t card_id_in; /*!< holding card uniq id, received from stm card under test */
+    card_hello_t hello; /*!< card list sizes, protocol version and capabilities. zero if the card did not say hello */
     struct sockaddr_in addr; /*!< sockaddr_in for the init socket excepting card id test list and other information,
                                                     required for unit testing */
     int sockfd;              /*!< sockfd for the init socket excepting card id test list and other information,
@@ -376,19 +1021,26 @@ typedef struct unit_test_pack {
     void* (*testing_tread)(void*);       /*!< point to testing thread function (created by the library user) */
     pthread_attr_t* testing_thread_attr; /*!< point to testing thread pthread_attr_t,needed in order to configure, 
                                                     threads stack size.dynamicly allocated */
+    unit_test_config_t config;           /*!< card address and ports, set at run time */
+    struct journal* journal;             /*!< journal of the card results, NULL if the results are not journaled */
 } unit_test_pack_t;
 
 void preferments_check(test_preferments_results_t* result_out, uint8_t tast_criteria, const uint8_t* buffer_compare1,
-                       const uint8_t* buffer_compare2, uint16_t sizeof_buffers);
-uint8_t generate_result_file(test_recurses_t* result_list_in, uint16_t length, card_name_and_id_t* card);
+                       const uint8_t* buffer_compare2, uint16_t sizeof_buffers, uint16_t adc_tolerance);
+uint16_t adc_tolerance_lsb(const unit_test_config_t* config);
+void test_result_add(test_recurses_t* test, const single_test_result_t* result);
+uint8_t generate_result_file(test_recurses_t* result_list_in, uint16_t length, card_name_and_id_t* card,
+                             const unit_test_config_t* config);
 void testing_thread_function_init(unit_test_pack_t* handel_in, void* (*testing_tread_in)(void*));
 uint8_t create_app_init_socket(unit_test_pack_t* handel_in);
 uint8_t request_card_id(unit_test_pack_t* handel_in);
+uint8_t request_card_hello(unit_test_pack_t* handel_in);
 uint8_t print_card_name_and_id(unit_test_pack_t* handel_in);
 uint8_t request_test_list_size(unit_test_pack_t* handel_in);
 
 uint8_t allocate_test_list_mem(unit_test_pack_t* handel_in);
 uint8_t read_and_fill_test_list_from_stm(unit_test_pack_t* handel_in);
+uint8_t allocate_test_results_mem(unit_test_pack_t* handel_in);
 
 uint8_t allocating_testing_threads_handles(unit_test_pack_t* handel_in);
 
@@ -396,6 +1048,13 @@ uint8_t initialising_testing_threads_input(unit_test_pack_t* handel_in);
 
 uint8_t creating_and_joining_testing_threads(unit_test_pack_t* handel_in);
 void close_test_threads_sockets(unit_test_pack_t* handel_in);
+uint64_t monotonic_time_ns(void);
+void test_stream_reset(tasting_thread_pack_t* stream);
+uint8_t test_stream_done(const tasting_thread_pack_t* stream);
+uint8_t test_stream_fill(tasting_thread_pack_t* stream);
+uint8_t test_stream_receive(tasting_thread_pack_t* stream, int flags);
+uint8_t test_stream_expire(tasting_thread_pack_t* stream);
+int test_stream_timeout_ms(const tasting_thread_pack_t* stream);
 void free_allocated_recurses(unit_test_pack_t* handel_in);
 
 #endif /*  UNIT_TEST_LIB */
\ No newline at end of file
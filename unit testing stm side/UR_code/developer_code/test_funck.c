@@ -63,6 +63,12 @@ SemaphoreHandle_t* interrupt_sem){
  *                  at the last member of the thread. developer initialise the test_name with '#'
  *                  at the start.
  *                  the developer need to initialise test_name and result_evaluation_criteria
+ *                  and payload_size, the data bytes sent with each request of the test
+ *                  (MIN_BUF_LEN to MAX_BUF_LEN). the test data of an ADC_CRITERIA test is ADC_SAMPLE_SIZE
+ *                  bytes samples. the test data of a LINEARITY_CRITERIA test is a sweep_request_t followed by
+ *                  room for the sums of the chunk, 776 bytes sweep 128 dac codes a request. the test data of a
+ *                  BUS_CRITERIA test goes in CAN_FRAME_DATA bytes frames. a STREAM_CRITERIA test streams its test
+ *                  data for the stream time of its loopback test line, half the data in each transfer
  *                  members need to be filed by the order of the functions in  "stm_test_list_array"
  *                  array and by the order of the tests in the function.
  */
@@ -70,55 +76,178 @@ const linux_app_test_setting_t pc_test_list_array[] = {
 
     {.test_name = " uart1 TI rx uart2 TI tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
     {.test_name = "#uart2 TI rx uart1 TI tx ",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
 
     {.test_name = " uart4 TI rx uart5 TI tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
     {.test_name = " uart5 TI rx uart4 TI tx ",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
     {.test_name = " uart4 DMA rx uart5 DMA tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
-    {.test_name = "#uart5 DMA rx uart4 DMA tx",
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " uart5 DMA rx uart4 DMA tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#uart5 DMA circular rx uart4 DMA circular tx stream",
+     .results_evaluation_criteria = STREAM_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 256},
 
     {.test_name = " i2c1 TI rx i2c2 TI rx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
     {.test_name = " i2c2 TI rx i2c1 TI rx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
-    {.test_name = "#i2c1 DMA rx i2c2 TI rx",
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " i2c1 DMA rx i2c2 TI rx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#i2c1 DMA rx i2c2 IT tx stream",
+     .results_evaluation_criteria = STREAM_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 256},
 
     {.test_name = " spi1 TI rx spi2 TI tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
     {.test_name = " spi2 TI rx spi1 TI tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
     {.test_name = " spi1 DMA rx spi2 TI tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
     {.test_name = " spi2 DMA rx spi1 DMA tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
-    {.test_name = "#spi2 IT rx/tx spi1 it rx/tx",
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi2 IT rx/tx spi1 it rx/tx",
      .results_evaluation_criteria = COMMUNICATION_CRITERIA,
-     .pulling_or_it = IT_MODE},
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#spi1 DMA circular rx spi2 IT tx stream",
+     .results_evaluation_criteria = STREAM_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 1400},
 
-    {.test_name = " dec1 to adc1 ", .results_evaluation_criteria = ADC_CRITERIA, .pulling_or_it = PULLING_MODE},
-    {.test_name = " dec1 to adc2 ", .results_evaluation_criteria = ADC_CRITERIA, .pulling_or_it = PULLING_MODE},
-    {.test_name = "#dec1 to adc3 ", .results_evaluation_criteria = ADC_CRITERIA, .pulling_or_it = PULLING_MODE},
+    {.test_name = " dec1 to adc1 ",
+     .results_evaluation_criteria = ADC_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 64},
+    {.test_name = " dec1 to adc2 ",
+     .results_evaluation_criteria = ADC_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 64},
+    {.test_name = " dec1 to adc3 ",
+     .results_evaluation_criteria = ADC_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 64},
+    {.test_name = "#dac1 sweep adc1 adc2 adc3",
+     .results_evaluation_criteria = LINEARITY_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 776},
 
-    {.test_name = "#flash ", .results_evaluation_criteria = COMMUNICATION_CRITERIA, .pulling_or_it = PULLING_MODE},
+    {.test_name = "#flash ",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = PULLING_MODE,
+     .payload_size = 100},
+
+    {.test_name = " can1 rx can2 tx",
+     .results_evaluation_criteria = BUS_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 256},
+    {.test_name = "#can2 rx can1 tx",
+     .results_evaluation_criteria = BUS_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 256},
+
+    {.test_name = " uart7 IT rx uart8 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " uart8 IT rx uart7 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#uart8 DMA rx uart7 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+
+    {.test_name = " usart3 IT rx usart6 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " usart6 IT rx usart3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " usart3 IT rx usart6 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#usart6 DMA rx usart3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+
+    {.test_name = " spi4 IT rx spi3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi3 IT rx spi4 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi4 DMA rx spi3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi3 IT rx spi4 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi4 DMA rx spi5 poll tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " spi5 poll rx spi4 DMA tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#spi4 DMA circular rx spi3 IT tx stream",
+     .results_evaluation_criteria = STREAM_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 1400},
+
+    {.test_name = " i2c3 IT rx i2c4 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = " i2c4 IT rx i2c3 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
+    {.test_name = "#i2c3 DMA rx i2c4 IT tx",
+     .results_evaluation_criteria = COMMUNICATION_CRITERIA,
+     .pulling_or_it = IT_MODE,
+     .payload_size = 100},
 
 };
 
@@ -140,14 +269,84 @@ card_name_and_id_t this_card_name_and_id = {.board_part_number = "nucleo-f746zg"
  */
 test_func_t stm_test_list_array[] = {
 
-    [UART_1_2].task_ptr = UART_1_2_task,
-    [UART_4_5].task_ptr = UART_4_5_task,
-    [I2C_1_2].task_ptr = I2C_1_2_task,
-    [SPI_1_2].task_ptr = spi_1_2_task,
+    [UART_1_2].task_ptr = loopback_task,
+    [UART_4_5].task_ptr = loopback_task,
+    [I2C_1_2].task_ptr = loopback_task,
+    [SPI_1_2].task_ptr = loopback_task,
     [ADC_DAC].task_ptr = adc_1_2_3_dac1_task,
-    [FLASH_TEST].task_ptr = flash_task
+    [FLASH_TEST].task_ptr = flash_task,
+    [CAN_1_2].task_ptr = can_1_2_task,
+    [UART_7_8].task_ptr = loopback_task,
+    [UART_3_6].task_ptr = loopback_task,
+    [SPI_3_4_5].task_ptr = loopback_task,
+    [I2C_3_4].task_ptr = loopback_task
 
 };
+/**
+ * \brief           loopback tests of the tasks running loopback_task
+ * \note            developer need to write a line for each loopback test: task, bus, rx handle, tx handle,
+ *                  rx mode, tx mode, size, timeout in ms, stream time in ms and stream bytes. size 0 transfers
+ *                  the payload_size of the test.
+ *                  the lines of a task are in the order of its tests in "pc_test_list_array".
+ *                  a peripheral pair is tested by adding its lines, the hal callbacks find the test running on
+ *                  a peripheral by its registers address
+ *                  the tasks run at once, so the pairs of different tasks load the buses and dma controllers
+ *                  together. a peripheral with no interrupt enabled, spi5, runs its side by polling
+ *                  a single transfer test has stream time 0. a stream test line sets the stream time in ms and the
+ *                  bytes received that stop it sooner, 0 for no limit. its circular sides need a dma stream on the
+ *                  peripheral, the i2c hal has no circular transfer and an i2c stream re-arms its transfers
+ */
+const loopback_test_t loopback_test_list[] = {
+
+    {UART_1_2, LOOPBACK_UART, &huart1, &huart2, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_1_2, LOOPBACK_UART, &huart2, &huart1, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+
+    {UART_4_5, LOOPBACK_UART, &huart4, &huart5, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_4_5, LOOPBACK_UART, &huart5, &huart4, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_4_5, LOOPBACK_UART, &huart4, &huart5, LOOPBACK_DMA, LOOPBACK_DMA, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_4_5, LOOPBACK_UART, &huart5, &huart4, LOOPBACK_DMA, LOOPBACK_DMA, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_4_5, LOOPBACK_UART, &huart5, &huart4, LOOPBACK_CIRCULAR, LOOPBACK_CIRCULAR, 0, TIME_ELAPSED_ERROR, 200, 0},
+
+    {I2C_1_2, LOOPBACK_I2C, &hi2c1, &hi2c2, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {I2C_1_2, LOOPBACK_I2C, &hi2c2, &hi2c1, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {I2C_1_2, LOOPBACK_I2C, &hi2c1, &hi2c2, LOOPBACK_DMA, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {I2C_1_2, LOOPBACK_I2C, &hi2c1, &hi2c2, LOOPBACK_DMA, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 100, 0},
+
+    {SPI_1_2, LOOPBACK_SPI, &hspi1, &hspi2, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_1_2, LOOPBACK_SPI, &hspi2, &hspi1, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_1_2, LOOPBACK_SPI, &hspi1, &hspi2, LOOPBACK_DMA, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_1_2, LOOPBACK_SPI, &hspi2, &hspi1, LOOPBACK_DMA, LOOPBACK_DMA, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_1_2, LOOPBACK_SPI_EXCHANGE, &hspi1, &hspi2, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_1_2, LOOPBACK_SPI, &hspi1, &hspi2, LOOPBACK_CIRCULAR, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 100, 0},
+
+    {UART_7_8, LOOPBACK_UART, &huart7, &huart8, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_7_8, LOOPBACK_UART, &huart8, &huart7, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_7_8, LOOPBACK_UART, &huart8, &huart7, LOOPBACK_DMA, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+
+    {UART_3_6, LOOPBACK_UART, &huart3, &huart6, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_3_6, LOOPBACK_UART, &huart6, &huart3, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_3_6, LOOPBACK_UART, &huart3, &huart6, LOOPBACK_IT, LOOPBACK_DMA, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {UART_3_6, LOOPBACK_UART, &huart6, &huart3, LOOPBACK_DMA, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+
+    {SPI_3_4_5, LOOPBACK_SPI, &hspi4, &hspi3, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_3_4_5, LOOPBACK_SPI, &hspi3, &hspi4, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_3_4_5, LOOPBACK_SPI, &hspi4, &hspi3, LOOPBACK_DMA, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_3_4_5, LOOPBACK_SPI, &hspi3, &hspi4, LOOPBACK_IT, LOOPBACK_DMA, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_3_4_5, LOOPBACK_SPI, &hspi4, &hspi5, LOOPBACK_DMA, LOOPBACK_POLL, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_3_4_5, LOOPBACK_SPI, &hspi5, &hspi4, LOOPBACK_POLL, LOOPBACK_DMA, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {SPI_3_4_5, LOOPBACK_SPI, &hspi4, &hspi3, LOOPBACK_CIRCULAR, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 100, 262144},
+
+    {I2C_3_4, LOOPBACK_I2C, &hi2c3, &hi2c4, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {I2C_3_4, LOOPBACK_I2C, &hi2c4, &hi2c3, LOOPBACK_IT, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+    {I2C_3_4, LOOPBACK_I2C, &hi2c3, &hi2c4, LOOPBACK_DMA, LOOPBACK_IT, 0, TIME_ELAPSED_ERROR, 0, 0},
+
+};
+
+/**
+ * \brief           number of loopback tests
+ */
+const uint16_t loopback_test_list_size = sizeof(loopback_test_list) / sizeof(loopback_test_t);
+
 /**
  * \brief           Holds number of tasks
  *                  
@@ -36,9 +36,11 @@
 
 #include "main_ur.h"
 
+#include "can_test.h"
 #include "dac_adc_test.h"
 #include "flash_test.h"
 #include "i2c_test.h"
+#include "loopback_test.h"
 #include "spi_test.h"
 #include "uart_test.h"
 
@@ -47,12 +49,17 @@
  */
 typedef enum test_task_list {
 
-    UART_1_2, /*!< test uart 1 and 2 */
-    UART_4_5, /*!< test uart 4 and 5 */
-    I2C_1_2,  /*!< test i2c 1 and 2 */
-    SPI_1_2,  /*!< test spi 1 and 2 */
-    ADC_DAC,  /*!< test adc anc dac */
+    UART_1_2,  /*!< test uart 1 and 2 */
+    UART_4_5,  /*!< test uart 4 and 5 */
+    I2C_1_2,   /*!< test i2c 1 and 2 */
+    SPI_1_2,   /*!< test spi 1 and 2 */
+    ADC_DAC,   /*!< test adc anc dac */
 	FLASH_TEST,     /*!< test flash */
+    CAN_1_2,   /*!< test can 1 and 2 */
+    UART_7_8,  /*!< test uart 7 and 8 */
+    UART_3_6,  /*!< test usart 3 and 6 */
+    SPI_3_4_5, /*!< test spi 3, 4 and 5, spi 4 is the slave of spi 3 and spi 5 */
+    I2C_3_4,   /*!< test i2c 3 and 4 */
 
 } test_task_list_t;
 
@@ -0,0 +1,105 @@
+/**
+ * \file            can_test.h
+ * \brief           can1 to can2 frame bus test inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef DEVELOPER_CODE_CAN_TEST_H_
+#define DEVELOPER_CODE_CAN_TEST_H_
+
+#include "main_ur.h"
+
+/**
+ * \brief                     standard id of the first frame of a test, frame i has CAN_TEST_FIRST_ID + i.
+ *                            the mailboxes send the lowest id first, the frames go in order
+ * \hideinitializer
+ */
+#define CAN_TEST_FIRST_ID         0x100
+
+/**
+ * \brief                     test data bytes of a frame, the last frame carries the bytes left
+ * \hideinitializer
+ */
+#define CAN_FRAME_DATA            8
+
+/**
+ * \brief                     most frames of a test, MAX_BUF_LEN bytes of test data
+ * \hideinitializer
+ */
+#define CAN_TEST_MAX_FRAMES       ((MAX_BUF_LEN + CAN_FRAME_DATA - 1) / CAN_FRAME_DATA)
+
+/**
+ * \brief                     bits of a frame after its crc, not stuffed. crc delimiter, ack slot and delimiter,
+ *                            end of frame and the interframe space
+ * \hideinitializer
+ */
+#define CAN_FRAME_TAIL_BITS       13
+
+/**
+ * \brief                     can crc polynomial, x^15 + x^14 + x^10 + x^8 + x^7 + x^4 + x^3 + 1
+ * \hideinitializer
+ */
+#define CAN_CRC_POLYNOMIAL        0x4599
+
+/**
+ * \brief                     equal bits in a row after which the transmitter stuffs a bit of the other level
+ * \hideinitializer
+ */
+#define CAN_STUFF_RUN             5
+
+/**
+ * \brief           a can test running, found by the hal callbacks
+ */
+typedef struct can_run {
+
+    test_func_t* task;                           /*!< task running the test, its semaphore and test request */
+    CAN_HandleTypeDef* rx;                       /*!< can receiving the frames */
+    CAN_HandleTypeDef* tx;                       /*!< can transmitting the frames */
+    uint8_t* data;                               /*!< test data, transmitted and received in its place */
+    uint16_t size;                               /*!< bytes of test data */
+    uint16_t frames;                             /*!< frames of the test data */
+    volatile uint16_t queued;                    /*!< frames put in a transmit mailbox */
+    volatile uint16_t received;                  /*!< frames received */
+    volatile uint8_t active;                     /*!< the test waits for its frames, the callbacks ignore late
+                                                      frames once it is cleared */
+    uint32_t queued_cycles[CAN_TEST_MAX_FRAMES]; /*!< cycle counter when each frame was put in a mailbox */
+    uint16_t timestamp[CAN_TEST_MAX_FRAMES];     /*!< receiver can timer, in bit times, at the start of each frame */
+    uint32_t latency_sum;                        /*!< sum of the cycles from queuing each frame to receiving it */
+    uint32_t latency_max;                        /*!< most cycles from queuing a frame to receiving it */
+
+} can_run_t;
+
+extern CAN_HandleTypeDef hcan1;
+extern CAN_HandleTypeDef hcan2;
+
+void can_1_2_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem, uint8_t test_select,
+                  uint8_t* error_report);
+
+#endif /* DEVELOPER_CODE_CAN_TEST_H_ */
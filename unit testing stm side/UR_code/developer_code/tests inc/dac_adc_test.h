@@ -36,6 +36,12 @@
 
 #include "main_ur.h"
 
+/**
+ * \brief                     adcs converting the dac output in a linearity sweep, adc1 adc2 and adc3
+ * \hideinitializer
+ */
+#define SWEEP_ADC_NUM 3
+
 extern ADC_HandleTypeDef hadc1;
 extern ADC_HandleTypeDef hadc2;
 extern ADC_HandleTypeDef hadc3;
@@ -43,7 +43,4 @@ extern DMA_HandleTypeDef hdma_i2c1_rx;
 extern DMA_HandleTypeDef hdma_i2c3_rx;
 extern DMA_HandleTypeDef hdma_i2c4_rx;
 
-void I2C_1_2_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem, uint8_t test_select,
-                  uint8_t* error_report);
-
 #endif /* DEVELOPER_CODE_I2C_TEST_H_ */
@@ -0,0 +1,124 @@
+/**
+ * \file            loopback_test.h
+ * \brief           peripheral loopback tests declared as a table, run by one engine inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef DEVELOPER_CODE_LOOPBACK_TEST_H_
+#define DEVELOPER_CODE_LOOPBACK_TEST_H_
+
+#include "main_ur.h"
+
+/**
+ * \brief                     route table index of a peripheral, its registers offset from PERIPH_BASE in 1KB.
+ *                            the uart, spi and i2c registers of the stm32f7 are 1KB apart
+ * \hideinitializer
+ */
+#define LOOPBACK_ROUTE_INDEX(instance) (((uintptr_t)(instance) - PERIPH_BASE) >> 10)
+
+/**
+ * \brief                     route table size, the APB1 and APB2 peripherals up to PERIPH_BASE + 0x17000
+ * \hideinitializer
+ */
+#define LOOPBACK_ROUTE_SIZE       0x5C
+
+/**
+ * \brief                     address of the i2c slave of a loopback test
+ * \hideinitializer
+ */
+#define LOOPBACK_I2C_ADDRESS      0
+
+/**
+ * \brief           bus of a loopback test, selects the hal functions the engine calls
+ */
+typedef enum loopback_bus {
+
+    LOOPBACK_UART,         /*!< the rx uart receives what the tx uart transmits */
+    LOOPBACK_SPI,          /*!< the rx spi receives what the tx spi transmits */
+    LOOPBACK_SPI_EXCHANGE, /*!< full duplex, each spi transmits half the data and receives the other half */
+    LOOPBACK_I2C           /*!< the rx i2c is the master receiving, the tx i2c the slave transmitting */
+
+} loopback_bus_t;
+
+/**
+ * \brief           how one side of a loopback test runs its transfer
+ */
+typedef enum loopback_mode {
+
+    LOOPBACK_POLL,    /*!< blocking hal call. the side not polled starts first, only one side of a test may poll */
+    LOOPBACK_IT,      /*!< interrupt transfer */
+    LOOPBACK_DMA,     /*!< dma transfer */
+    LOOPBACK_CIRCULAR /*!< circular dma transfer of a stream, runs until the stream stops. uart and spi only */
+
+} loopback_mode_t;
+
+/**
+ * \brief           one loopback test, a line of loopback_test_list
+ * \note            the tests of a task are the lines of its task, in order. the test request selects one
+ */
+typedef struct loopback_test {
+
+    uint8_t task;          /*!< test_task_list_t of the task running the test */
+    uint8_t bus;           /*!< loopback_bus_t */
+    void* rx_handle;       /*!< handle of the receiving peripheral */
+    void* tx_handle;       /*!< handle of the transmitting peripheral */
+    uint8_t rx_mode;       /*!< loopback_mode_t of the receive */
+    uint8_t tx_mode;       /*!< loopback_mode_t of the transmit */
+    uint16_t size;         /*!< bytes transferred, 0 for the data length of the request */
+    uint16_t timeout;      /*!< longest wait for the transfer, in ms */
+    uint16_t stream_ms;    /*!< time the test streams the data, in ms. 0 for a single transfer test */
+    uint32_t stream_bytes; /*!< bytes received that stop the stream before its time, 0 for no limit */
+
+} loopback_test_t;
+
+/**
+ * \brief           a loopback test running, found by the hal callbacks in the route table
+ */
+typedef struct loopback_run {
+
+    test_func_t* task;           /*!< task running the test, its semaphore and test request */
+    volatile uint8_t pending;    /*!< transfer completions the test still waits for */
+    const loopback_test_t* test; /*!< stream test running, NULL for a single transfer test */
+    uint8_t* tx_data;            /*!< data the stream transmits */
+    uint8_t* rx_data;            /*!< buffer the stream receives in */
+    uint16_t size;               /*!< bytes of each stream transfer */
+    volatile uint8_t streaming;  /*!< the re-armed sides of the stream start again, cleared to stop the stream */
+    volatile uint8_t round;      /*!< re-armed sides of the stream still transferring */
+    uint32_t start_cycles;       /*!< card cycles at the stream start */
+
+} loopback_run_t;
+
+extern const loopback_test_t loopback_test_list[];
+extern const uint16_t loopback_test_list_size;
+
+void loopback_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem, uint8_t test_select,
+                   uint8_t* error_report);
+
+#endif /* DEVELOPER_CODE_LOOPBACK_TEST_H_ */
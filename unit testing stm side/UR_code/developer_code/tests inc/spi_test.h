@@ -47,21 +47,7 @@ extern DMA_HandleTypeDef hdma_spi1_tx;
 
 extern DMA_HandleTypeDef hdma_spi3_rx;
 extern DMA_HandleTypeDef hdma_spi4_rx;
+extern DMA_HandleTypeDef hdma_spi4_tx;
 extern DMA_HandleTypeDef hdma_spi5_rx;
 
-/**
- * \brief                     one peripheral already finished transaction
- * \hideinitializer
- */
-#define ONE_PERIPHERAL_FINISH 1
-
-/**
- * \brief                     no peripheral  finish transaction
- * \hideinitializer
- */
-#define NO_PERIPHERAL_FINISH  0
-
-void spi_1_2_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem, uint8_t test_select,
-                  uint8_t* error_report);
-
 #endif /* DEVELOPER_CODE_SPI_TEST_H_ */
@@ -0,0 +1,454 @@
+/**
+ * \file            can_test.c
+ * \brief           can1 to can2 frame bus test src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include "can_test.h"
+#include "extern_template_variables.h"
+#include "test_funck.h"
+
+/**
+ * \brief           can test running, set while the test waits for its frames
+ */
+static can_run_t* volatile can_running;
+
+/**
+ * \brief           the cans are set up for the frame tests
+ */
+static uint8_t can_ready;
+
+/**
+ * \brief           frame bits counted so far, the crc and the bit stuffing of a frame
+ */
+typedef struct can_bit_count {
+
+    uint32_t bits; /* bits on the bus, with the stuff bits */
+    uint16_t crc;  /* crc of the bits pushed with crc */
+    uint8_t level; /* level of the last bit on the bus */
+    uint8_t run;   /* bits of that level in a row */
+
+} can_bit_count_t;
+
+/**
+ * \brief           push bits of a frame, most significant bit first, counting the stuff bits
+ * \param[in]       count: frame bits counted so far
+ * \param[in]       value: bits to push, in the low bit_num bits
+ * \param[in]       bit_num: number of bits
+ * \param[in]       crc: the bits are covered by the crc
+ */
+static void
+can_bits_push(can_bit_count_t* count, uint32_t value, uint8_t bit_num, uint8_t crc) {
+
+    uint8_t level; /* level of the bit pushed */
+
+    while (bit_num-- > 0) {
+
+        level = (value >> bit_num) & 1;
+
+        if (crc) {
+            count->crc = ((count->crc << 1) ^ ((level ^ (count->crc >> 14)) & 1 ? CAN_CRC_POLYNOMIAL : 0)) & 0x7FFF;
+        }
+
+        /* after CAN_STUFF_RUN equal bits the transmitter stuffs a bit of the other level, it begins the next run */
+        count->bits++;
+        if (count->run > 0 && level == count->level) {
+            count->run++;
+        } else {
+            count->level = level;
+            count->run = 1;
+        }
+        if (count->run == CAN_STUFF_RUN) {
+            count->bits++;
+            count->level = !level;
+            count->run = 1;
+        }
+    }
+}
+
+/**
+ * \brief           bits a standard data frame takes on the bus
+ * \note            start of frame to the crc are stuffed, the bits after the crc are not
+ * \param[in]       id: standard id
+ * \param[in]       data: frame data
+ * \param[in]       dlc: data bytes
+ * \param[out]      return: frame bits, with the stuff bits and the interframe space
+ */
+static uint32_t
+can_frame_bits(uint32_t id, const uint8_t* data, uint8_t dlc) {
+
+    can_bit_count_t count = {0}; /* frame bits counted */
+
+    /* start of frame, id, rtr, ide, r0 and dlc */
+    can_bits_push(&count, 0, 1, 1);
+    can_bits_push(&count, id, 11, 1);
+    can_bits_push(&count, 0, 3, 1);
+    can_bits_push(&count, dlc, 4, 1);
+
+    for (uint8_t i = 0; i < dlc; i++) {
+        can_bits_push(&count, data[i], 8, 1);
+    }
+
+    can_bits_push(&count, count.crc, 15, 0);
+
+    return count.bits + CAN_FRAME_TAIL_BITS;
+}
+
+/**
+ * \brief           bus bits per second of a can, from its bit timing
+ * \param[in]       hcan: can handle
+ * \param[out]      return: bitrate
+ */
+static uint32_t
+can_bitrate(const CAN_HandleTypeDef* hcan) {
+
+    uint32_t quanta; /* time quanta of a bit, the sync segment and the two bit segments */
+
+    quanta = 1 + ((hcan->Init.TimeSeg1 >> CAN_BTR_TS1_Pos) + 1) + ((hcan->Init.TimeSeg2 >> CAN_BTR_TS2_Pos) + 1);
+
+    return HAL_RCC_GetPCLK1Freq() / (hcan->Init.Prescaler * quanta);
+}
+
+/**
+ * \brief           set up a can for the frame tests, once
+ * \note            time triggered mode timestamps the frames received with the can timer, counting bit times.
+ *                  can2 filters start at bank 14, both cans accept every frame in fifo 0
+ * \param[in]       hcan: can handle
+ * \param[in]       filter_bank: first filter bank of the can
+ * \param[out]      return: hal status
+ */
+static HAL_StatusTypeDef
+can_setup(CAN_HandleTypeDef* hcan, uint32_t filter_bank) {
+
+    CAN_FilterTypeDef filter = {0}; /* accept every frame */
+    HAL_StatusTypeDef status;       /* error return check */
+
+    hcan->Init.TimeTriggeredMode = ENABLE;
+    status = HAL_CAN_Init(hcan);
+
+    if (status == HAL_OK) {
+
+        filter.FilterBank = filter_bank;
+        filter.FilterMode = CAN_FILTERMODE_IDMASK;
+        filter.FilterScale = CAN_FILTERSCALE_32BIT;
+        filter.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+        filter.FilterActivation = CAN_FILTER_ENABLE;
+        filter.SlaveStartFilterBank = 14;
+        status = HAL_CAN_ConfigFilter(hcan, &filter);
+    }
+    if (status == HAL_OK) {
+        status = HAL_CAN_Start(hcan);
+    }
+    if (status == HAL_OK) {
+        status = HAL_CAN_ActivateNotification(hcan, CAN_IT_TX_MAILBOX_EMPTY | CAN_IT_RX_FIFO0_MSG_PENDING
+                                                        | CAN_IT_ERROR | CAN_IT_BUSOFF | CAN_IT_LAST_ERROR_CODE);
+    }
+
+    return status;
+}
+
+/**
+ * \brief           test data bytes of a frame of a test
+ * \param[in]       run: test running
+ * \param[in]       frame: frame of the test
+ * \param[out]      return: CAN_FRAME_DATA, or the bytes left for the last frame
+ */
+static uint8_t
+can_frame_size(const can_run_t* run, uint16_t frame) {
+
+    uint16_t left = run->size - frame * CAN_FRAME_DATA; /* test data bytes from the frame on */
+
+    return left < CAN_FRAME_DATA ? left : CAN_FRAME_DATA;
+}
+
+/**
+ * \brief           put the next frames of a test in the free transmit mailboxes
+ * \note            called by the test task in a critical section and by the transmit complete callbacks
+ * \param[in]       run: test running
+ * \param[out]      return: hal status
+ */
+static HAL_StatusTypeDef
+can_queue(can_run_t* run) {
+
+    CAN_TxHeaderTypeDef header = {0}; /* header of the frame */
+    uint32_t mailbox;                 /* mailbox the frame was put in */
+
+    header.IDE = CAN_ID_STD;
+    header.RTR = CAN_RTR_DATA;
+    header.TransmitGlobalTime = DISABLE;
+
+    while (run->queued < run->frames && HAL_CAN_GetTxMailboxesFreeLevel(run->tx) > 0) {
+
+        header.StdId = CAN_TEST_FIRST_ID + run->queued;
+        header.DLC = can_frame_size(run, run->queued);
+
+        run->queued_cycles[run->queued] = cycle_counter_read();
+        if (HAL_CAN_AddTxMessage(run->tx, &header, &run->data[run->queued * CAN_FRAME_DATA], &mailbox) != HAL_OK) {
+            return HAL_ERROR;
+        }
+        run->queued++;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * \brief           bus statistics of the frames of a test, from the frames sent and the receiver timestamps
+ * \note            the bus time is the time from the start of the first frame to the start of the last frame,
+ *                  in the 16 bit can timer of the receiver, and the bits of the last frame
+ * \param[in]       run: test that received all its frames
+ * \param[out]      bus: bus statistics of the test
+ */
+static void
+can_bus_stats(const can_run_t* run, bus_stats_t* bus) {
+
+    uint32_t bits; /* bits of a frame */
+
+    bus->frames = run->received;
+    bus->bitrate = can_bitrate(run->rx);
+    bus->latency_sum = run->latency_sum;
+    bus->latency_max = run->latency_max;
+
+    for (uint16_t frame = 0; frame < run->frames; frame++) {
+
+        bits = can_frame_bits(CAN_TEST_FIRST_ID + frame, &run->data[frame * CAN_FRAME_DATA],
+                              can_frame_size(run, frame));
+        bus->bus_bits += bits;
+
+        if (frame > 0) {
+            bus->bus_time += (uint16_t)(run->timestamp[frame] - run->timestamp[frame - 1]);
+        }
+        if (frame == run->frames - 1) {
+            bus->bus_time += bits;
+        }
+    }
+}
+
+/**
+ * \brief           can1 and can2 frame test, the test data goes as a sequence of frames from one can to the other
+ *                  the function will be called by "testing_thread"
+ * \note            the frames are queued in the three transmit mailboxes, each transmit complete interrupt queues
+ *                  the next. the receive fifo interrupt puts each frame in its place by its id. the reply carries
+ *                  the frames/s, bus load and frame latency statistics in its bus_stats_t.
+ *                  the can timers of can1 and can2 are not synchronised, so the latency from queuing a frame to
+ *                  receiving it is timed with the cycle counter, and the bus time with the receiver timestamps
+ * \param[in]       data: data received from testing app vie udp the test hardware
+ *                  to do a data match compare
+ * \param[in]       sizeof_data: size of data
+ * \param[in]       interrupt_sem: semaphore of the task, "&stm_test_list_array[task].q"
+ * \param[in]       test_select: 0 can1 receives from can2, 1 can2 receives from can1
+ * \param[in]       error_report: report to pc about test error
+ */
+void
+can_1_2_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem, uint8_t test_select,
+             uint8_t* error_report) {
+
+    /* testing_thread passes the semaphore of the test_func_t of the task */
+    test_func_t* task = (test_func_t*)((uint8_t*)interrupt_sem - offsetof(test_func_t, q));
+    static can_run_t run;     /* test running, found by the hal callbacks */
+    HAL_StatusTypeDef status; /* error return check */
+    *error_report = NO_ERROR; /* initalized to  NO_ERROR if an error is accruing it will change it */
+
+    if (!can_ready) {
+
+        if (can_setup(&hcan1, 0) != HAL_OK || can_setup(&hcan2, 14) != HAL_OK) {
+
+            *error_report = HAL_RETURN_ERROR;
+            return;
+        }
+        can_ready = 1;
+    }
+
+    if (test_select > 1) {
+
+        *error_report = HAL_RETURN_ERROR;
+        return;
+    }
+
+    memset(&run, 0, sizeof(run));
+    run.task = task;
+    run.rx = test_select == 0 ? &hcan1 : &hcan2;
+    run.tx = test_select == 0 ? &hcan2 : &hcan1;
+    run.data = data;
+    run.size = sizeof_data;
+    run.frames = (sizeof_data + CAN_FRAME_DATA - 1) / CAN_FRAME_DATA;
+
+    /* a callback of an earlier test after it finished leaves the semaphore given */
+    xSemaphoreTake(*interrupt_sem, 0);
+
+    run.active = 1;
+    can_running = &run;
+
+    /* the transmit complete interrupts queue the frames after the first mailboxes */
+    TEST_PHASE_MARK(&task->taskX_pack.pocket, TEST_PHASE_TX_START);
+    taskENTER_CRITICAL();
+    status = can_queue(&run);
+    taskEXIT_CRITICAL();
+
+    if (status != HAL_OK) {
+
+        *error_report = HAL_RETURN_ERROR;
+
+    } else if (xSemaphoreTake(*interrupt_sem, pdMS_TO_TICKS(TIME_ELAPSED_ERROR)) == pdTRUE) {
+
+        TEST_PHASE_MARK(&task->taskX_pack.pocket, TEST_PHASE_TASK_WAKE);
+
+    } else {
+
+        *error_report = OVER_TIME;
+    }
+
+    /* frames still in the mailboxes are aborted, the frames coming late are ignored */
+    run.active = 0;
+    can_running = NULL;
+    if (*error_report == NO_ERROR && run.received == run.frames) {
+
+        can_bus_stats(&run, &task->taskX_pack.pocket.bus);
+
+    } else {
+
+        HAL_CAN_AbortTxRequest(run.tx, CAN_TX_MAILBOX0 | CAN_TX_MAILBOX1 | CAN_TX_MAILBOX2);
+        if (*error_report == NO_ERROR) {
+            *error_report = OVER_TIME;
+        }
+    }
+}
+
+/**
+ * \brief           release the semaphore of the test running
+ * \param[in]       run: test running
+ */
+static void
+can_release(can_run_t* run) {
+
+    BaseType_t woken = pdFALSE; /* the test task was woken */
+
+    run->active = 0;
+    xSemaphoreGiveFromISR(run->task->q, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * \brief           a transmit mailbox of a can sent its frame, queue the next frames of the test
+ * \param[in]       hcan: can handle
+ */
+static void
+can_tx_complete(CAN_HandleTypeDef* hcan) {
+
+    can_run_t* run = can_running; /* test running */
+
+    if (run == NULL || !run->active || hcan != run->tx) {
+        return;
+    }
+
+    if (can_queue(run) != HAL_OK) {
+
+        run->task->taskX_pack.pocket.error_report = HAL_RETURN_ERROR;
+        can_release(run);
+    }
+}
+
+/* peripheral isr callback function`s begin */
+
+void
+HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef* hcan) {
+
+    can_tx_complete(hcan);
+}
+
+void
+HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef* hcan) {
+
+    can_tx_complete(hcan);
+}
+
+void
+HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef* hcan) {
+
+    can_tx_complete(hcan);
+}
+
+void
+HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan) {
+
+    can_run_t* run = can_running;  /* test running */
+    CAN_RxHeaderTypeDef header;    /* header of the frame received */
+    uint8_t frame[CAN_FRAME_DATA]; /* data of the frame received */
+    uint32_t latency;              /* cycles from queuing the frame to receiving it */
+    uint16_t index;                /* frame of the test */
+
+    /* the fifo is emptied also when no test waits, so a late frame does not hold the interrupt */
+    while (HAL_CAN_GetRxFifoFillLevel(hcan, CAN_RX_FIFO0) > 0) {
+
+        if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &header, frame) != HAL_OK) {
+            return;
+        }
+        if (run == NULL || !run->active || hcan != run->rx || header.IDE != CAN_ID_STD) {
+            continue;
+        }
+
+        index = header.StdId - CAN_TEST_FIRST_ID;
+        if (header.StdId < CAN_TEST_FIRST_ID || index >= run->queued || header.DLC != can_frame_size(run, index)) {
+            continue;
+        }
+
+        memcpy(&run->data[index * CAN_FRAME_DATA], frame, header.DLC);
+        run->timestamp[index] = (uint16_t)header.Timestamp;
+
+        latency = cycle_counter_read() - run->queued_cycles[index];
+        run->latency_sum += latency;
+        if (latency > run->latency_max) {
+            run->latency_max = latency;
+        }
+
+        if (++run->received == run->frames) {
+
+            TEST_PHASE_MARK(&run->task->taskX_pack.pocket, TEST_PHASE_RX_DONE);
+            can_release(run);
+        }
+    }
+}
+
+void
+HAL_CAN_ErrorCallback(CAN_HandleTypeDef* hcan) {
+
+    can_run_t* run = can_running; /* test running */
+
+    HAL_CAN_ResetError(hcan);
+
+    if (run == NULL || !run->active || (hcan != run->rx && hcan != run->tx)) {
+        return;
+    }
+
+    run->task->taskX_pack.pocket.error_report = ERROR_IT;
+    can_release(run);
+}
+
+/* peripheral isr callback function end */
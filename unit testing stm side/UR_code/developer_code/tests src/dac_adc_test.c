@@ -36,11 +36,165 @@
 #include "main_ur.h"
 #include "test_funck.h"
 
+/**
+ * \brief           convert the dac output with an adc
+ * \param[in]       hadc: adc the dac output is connected to
+ * \param[out]      code: adc code converted
+ * \param[in]       error_report: report to pc about test error, set only on an error
+ * \param[out]      return: HAL_OK, or the HAL error
+ */
+static HAL_StatusTypeDef
+adc_convert(ADC_HandleTypeDef* hadc, uint16_t* code, uint8_t* error_report) {
+
+    HAL_StatusTypeDef status; /* error return check */
+
+    status = HAL_ADC_Start(hadc);
+    if (status == HAL_OK) {
+        status = HAL_ADC_PollForConversion(hadc, TIME_ELAPSED_ERROR);
+    }
+    if (status == HAL_TIMEOUT) {
+        *error_report = OVER_TIME;
+        return status;
+    }
+    if (status != HAL_OK) {
+        *error_report = HAL_RETURN_ERROR;
+        return status;
+    }
+
+    *code = (uint16_t)HAL_ADC_GetValue(hadc);
+    return HAL_OK;
+}
+
+/**
+ * \brief           drive each sample of the test data out of the dac and convert it with an adc
+ * \note            the first conversion after the dac output steps is thrown away, the dac output is still settling
+ * \param[in]       hadc: adc the dac output is connected to
+ * \param[in]       data: ADC_SAMPLE_SIZE bytes little endian dac codes, replaced by the adc codes converted
+ * \param[in]       sizeof_data: size of data
+ * \param[in]       error_report: report to pc about test error
+ */
+static void
+dac_to_adc(ADC_HandleTypeDef* hadc, uint8_t* data, uint16_t sizeof_data, uint8_t* error_report) {
+
+    HAL_StatusTypeDef status; /* error return check */
+    uint16_t code;            /* dac code of the sample, then the adc code */
+
+    status = HAL_DAC_Start(&hdac, DAC1_CHANNEL_1);
+    if (status != HAL_OK) {
+        *error_report = HAL_RETURN_ERROR;
+        return;
+    }
+
+    for (uint16_t offset = 0; offset + ADC_SAMPLE_SIZE <= sizeof_data; offset += ADC_SAMPLE_SIZE) {
+
+        code = (uint16_t)(data[offset] | (data[offset + 1] << 8)) & ADC_CODE_MAX;
+
+        /* peripheral transmit testing data  */
+        status = HAL_DAC_SetValue(&hdac, DAC1_CHANNEL_1, DAC_ALIGN_12B_R, code);
+        if (status != HAL_OK) {
+            *error_report = HAL_RETURN_ERROR;
+            return;
+        }
+
+        /* peripheral receive testing data, the second conversion is kept */
+        for (uint8_t conversion = 0; conversion < 2; conversion++) {
+
+            if (adc_convert(hadc, &code, error_report) != HAL_OK) {
+                return;
+            }
+        }
+
+        data[offset] = (uint8_t)code;
+        data[offset + 1] = (uint8_t)(code >> 8);
+    }
+
+    HAL_ADC_Stop(hadc);
+}
+
+/**
+ * \brief           sweep the dac over the codes of a chunk of a linearity sweep, and sum the codes each adc converts
+ * \note            the first conversion of each adc after the dac output steps is thrown away, like dac_to_adc.
+ *                  a request the card can not run, bad average, step, adcs or sums that do not fit the test data,
+ *                  is reported as HAL_RETURN_ERROR
+ * \param[in]       data: a sweep_request_t, followed by room for the uint16_t sums, code after code and adc after adc
+ * \param[in]       sizeof_data: size of data
+ * \param[in]       error_report: report to pc about test error
+ */
+static void
+dac_sweep(uint8_t* data, uint16_t sizeof_data, uint8_t* error_report) {
+
+    ADC_HandleTypeDef* const adc_list[SWEEP_ADC_NUM] = {&hadc1, &hadc2, &hadc3}; /* adcs the dac output is on */
+    sweep_request_t request;  /* chunk of the sweep to run */
+    HAL_StatusTypeDef status; /* error return check */
+    uint16_t code;            /* adc code converted */
+    uint16_t sum;             /* sum of the adc codes of one adc at one dac code */
+    uint8_t* sum_ptr;         /* place of the next sum in the test data */
+
+    if (sizeof_data < sizeof(request)) {
+        *error_report = HAL_RETURN_ERROR;
+        return;
+    }
+    memcpy(&request, data, sizeof(request));
+
+    if (request.average == 0 || request.average > SWEEP_MAX_AVERAGE || request.step == 0
+        || request.adc_num != SWEEP_ADC_NUM
+        || sizeof(request) + (uint32_t)request.code_num * request.adc_num * sizeof(sum) > sizeof_data
+        || (request.code_num > 0
+            && request.first_code + (uint32_t)(request.code_num - 1) * request.step > ADC_CODE_MAX)) {
+        *error_report = HAL_RETURN_ERROR;
+        return;
+    }
+
+    status = HAL_DAC_Start(&hdac, DAC1_CHANNEL_1);
+    if (status != HAL_OK) {
+        *error_report = HAL_RETURN_ERROR;
+        return;
+    }
+
+    sum_ptr = &data[sizeof(request)];
+
+    for (uint16_t code_index = 0; code_index < request.code_num; code_index++) {
+
+        /* peripheral transmit the next code of the sweep */
+        status = HAL_DAC_SetValue(&hdac, DAC1_CHANNEL_1, DAC_ALIGN_12B_R,
+                                  (uint32_t)(request.first_code + code_index * request.step));
+        if (status != HAL_OK) {
+            *error_report = HAL_RETURN_ERROR;
+            return;
+        }
+
+        for (uint8_t adc = 0; adc < SWEEP_ADC_NUM; adc++) {
+
+            /* thrown away, the dac output is still settling */
+            if (adc_convert(adc_list[adc], &code, error_report) != HAL_OK) {
+                return;
+            }
+
+            sum = 0;
+            for (uint8_t sample = 0; sample < request.average; sample++) {
+
+                if (adc_convert(adc_list[adc], &code, error_report) != HAL_OK) {
+                    return;
+                }
+                sum += code;
+            }
+
+            sum_ptr[0] = (uint8_t)sum;
+            sum_ptr[1] = (uint8_t)(sum >> 8);
+            sum_ptr += sizeof(sum);
+        }
+    }
+
+    for (uint8_t adc = 0; adc < SWEEP_ADC_NUM; adc++) {
+        HAL_ADC_Stop(adc_list[adc]);
+    }
+}
+
 /**
  * \brief           testing dac adc1 adc2 and adc3 adc peripherals
  *                  the function will be called by "testing_thread"
  * \param[in]       data: data received from testing app vie udp the test hardware
- *                  to do a data match compare
+ *                  to do a data match compare. ADC_SAMPLE_SIZE bytes dac codes, replaced by the adc codes
  * \param[in]       sizeof_data: size of data
  * \param[in]       interrupt_sem: semaphore in case you need to waite for an interrupt
  * \param[in]       test_select: select what test in the function to run
@@ -50,60 +204,28 @@ void
 adc_1_2_3_dac1_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem, uint8_t test_select,
                     uint8_t* error_report) {
 
-    HAL_StatusTypeDef status; /* error return check */
     *error_report = NO_ERROR; /* initalized to  NO_ERROR if an error is accruing it will change it */
     /* run task test requested by pc */
     switch (test_select) {
 
         case 0: /* dec1 to adc1 */
 
-            HAL_DAC_Start(&hdac, DAC1_CHANNEL_1);
-
-            /* peripheral transmit testing data  */
-            status = HAL_DAC_SetValue(&hdac, DAC1_CHANNEL_1, DAC_ALIGN_12B_R, data[0]);
-            if (status != HAL_OK) {
-                *error_report = HAL_RETURN_ERROR;
-                return;
-            }
-
-            /* peripheral receive testing data  */
-            HAL_ADC_Start(&hadc1);
-            data[0] = HAL_ADC_GetValue(&hadc1);
-
+            dac_to_adc(&hadc1, data, sizeof_data, error_report);
             break;
 
         case 1: /* dec1 to adc2 */
 
-            HAL_DAC_Start(&hdac, DAC1_CHANNEL_1);
-
-            /* peripheral transmit testing data  */
-            status = HAL_DAC_SetValue(&hdac, DAC1_CHANNEL_1, DAC_ALIGN_12B_R, data[0]);
-            if (status != HAL_OK) {
-                *error_report = HAL_RETURN_ERROR;
-                return;
-            }
-
-            /* peripheral receive testing data  */
-            HAL_ADC_Start(&hadc2);
-            data[0] = HAL_ADC_GetValue(&hadc2);
-
+            dac_to_adc(&hadc2, data, sizeof_data, error_report);
             break;
 
         case 2: /* dec1 to adc3 */
 
-            HAL_DAC_Start(&hdac, DAC1_CHANNEL_1);
-
-            /* peripheral transmit testing data  */
-            status = HAL_DAC_SetValue(&hdac, DAC1_CHANNEL_1, DAC_ALIGN_12B_R, data[0]);
-            if (status != HAL_OK) {
-                *error_report = HAL_RETURN_ERROR;
-                return;
-            }
+            dac_to_adc(&hadc3, data, sizeof_data, error_report);
+            break;
 
-            /* peripheral receive testing data  */
-            HAL_ADC_Start(&hadc3);
-            data[0] = HAL_ADC_GetValue(&hadc3);
+        case 3: /* dac1 sweep adc1 adc2 adc3 */
 
+            dac_sweep(data, sizeof_data, error_report);
             break;
 
         default: break;
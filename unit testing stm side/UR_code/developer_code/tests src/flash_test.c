@@ -81,7 +81,7 @@ flash_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem
             }
 
             /* write to flash */
-            for (uint8_t j = 0; j < sizeof_data / sizeof(uint32_t); j++) {
+            for (uint16_t j = 0; j < sizeof_data / sizeof(uint32_t); j++) {
 
                 status = HAL_FLASH_Program_IT(FLASH_TYPEPROGRAM_WORD, FLASH_ADDR + j * sizeof(uint32_t),
                                               *(uint32_t*)(data + j * sizeof(uint32_t)));
@@ -99,7 +99,7 @@ flash_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem
             }
 
             /* read from flash */
-            for (uint8_t j = 0; j < sizeof_data / sizeof(uint32_t); j++) {
+            for (uint16_t j = 0; j < sizeof_data / sizeof(uint32_t); j++) {
 
                 *((uint32_t*)(data + j * sizeof(uint32_t))) = *((uint32_t*)(FLASH_ADDR + j * sizeof(uint32_t)));
             }
@@ -140,7 +140,7 @@ HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue) {
 
     unit_tasting_package_t* cast;
 
-    cast = stm_test_list_array[FLASH_TEST].taskX_pack.p->payload;
+    cast = &stm_test_list_array[FLASH_TEST].taskX_pack.pocket;
 
     cast->error_report = ERROR_IT;
 
@@ -0,0 +1,804 @@
+/**
+ * \file            loopback_test.c
+ * \brief           peripheral loopback tests declared as a table, run by one engine src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include "loopback_test.h"
+#include "extern_template_variables.h"
+#include "test_funck.h"
+
+/**
+ * \brief           loopback test running on each peripheral, by LOOPBACK_ROUTE_INDEX of its registers address.
+ *                  set while the test runs, the hal callbacks find their test in one lookup
+ */
+static loopback_run_t* volatile loopback_route[LOOPBACK_ROUTE_SIZE];
+
+/**
+ * \brief           registers address of the peripheral of a handle
+ * \param[in]       bus: loopback_bus_t of the handle
+ * \param[in]       handle: peripheral handle
+ * \param[out]      return: registers address
+ */
+static void*
+loopback_instance(uint8_t bus, void* handle) {
+
+    switch (bus) {
+
+        case LOOPBACK_UART: return ((UART_HandleTypeDef*)handle)->Instance;
+        case LOOPBACK_SPI:
+        case LOOPBACK_SPI_EXCHANGE: return ((SPI_HandleTypeDef*)handle)->Instance;
+        case LOOPBACK_I2C: return ((I2C_HandleTypeDef*)handle)->Instance;
+        default: return NULL;
+    }
+}
+
+/**
+ * \brief           start one side of a uart loopback test
+ * \param[in]       huart: uart handle
+ * \param[in]       rx: 1 to receive, 0 to transmit
+ * \param[in]       mode: loopback_mode_t
+ * \param[in]       data: test data
+ * \param[in]       size: bytes transferred
+ * \param[in]       timeout: longest blocking call, in ms
+ * \param[out]      return: hal status
+ */
+static HAL_StatusTypeDef
+loopback_uart_start(UART_HandleTypeDef* huart, uint8_t rx, uint8_t mode, uint8_t* data, uint16_t size,
+                    uint32_t timeout) {
+
+    switch (mode) {
+
+        case LOOPBACK_POLL:
+            return rx ? HAL_UART_Receive(huart, data, size, timeout) : HAL_UART_Transmit(huart, data, size, timeout);
+        case LOOPBACK_IT: return rx ? HAL_UART_Receive_IT(huart, data, size) : HAL_UART_Transmit_IT(huart, data, size);
+
+        /* a circular transfer is a dma transfer, its dma stream set DMA_CIRCULAR by loopback_dma_mode */
+        case LOOPBACK_DMA:
+        case LOOPBACK_CIRCULAR:
+            return rx ? HAL_UART_Receive_DMA(huart, data, size) : HAL_UART_Transmit_DMA(huart, data, size);
+        default: return HAL_ERROR;
+    }
+}
+
+/**
+ * \brief           start one side of a spi loopback test
+ * \param[in]       hspi: spi handle
+ * \param[in]       rx: 1 to receive, 0 to transmit
+ * \param[in]       mode: loopback_mode_t
+ * \param[in]       data: test data
+ * \param[in]       size: bytes transferred
+ * \param[in]       timeout: longest blocking call, in ms
+ * \param[out]      return: hal status
+ */
+static HAL_StatusTypeDef
+loopback_spi_start(SPI_HandleTypeDef* hspi, uint8_t rx, uint8_t mode, uint8_t* data, uint16_t size, uint32_t timeout) {
+
+    switch (mode) {
+
+        case LOOPBACK_POLL:
+            return rx ? HAL_SPI_Receive(hspi, data, size, timeout) : HAL_SPI_Transmit(hspi, data, size, timeout);
+        case LOOPBACK_IT: return rx ? HAL_SPI_Receive_IT(hspi, data, size) : HAL_SPI_Transmit_IT(hspi, data, size);
+        case LOOPBACK_DMA:
+        case LOOPBACK_CIRCULAR:
+            return rx ? HAL_SPI_Receive_DMA(hspi, data, size) : HAL_SPI_Transmit_DMA(hspi, data, size);
+        default: return HAL_ERROR;
+    }
+}
+
+/**
+ * \brief           start one side of a full duplex spi loopback test
+ * \param[in]       hspi: spi handle
+ * \param[in]       mode: loopback_mode_t
+ * \param[in]       tx_data: data transmitted
+ * \param[in]       rx_data: buffer of the data received
+ * \param[in]       size: bytes transmitted and received
+ * \param[in]       timeout: longest blocking call, in ms
+ * \param[out]      return: hal status
+ */
+static HAL_StatusTypeDef
+loopback_spi_exchange_start(SPI_HandleTypeDef* hspi, uint8_t mode, uint8_t* tx_data, uint8_t* rx_data, uint16_t size,
+                            uint32_t timeout) {
+
+    switch (mode) {
+
+        case LOOPBACK_POLL: return HAL_SPI_TransmitReceive(hspi, tx_data, rx_data, size, timeout);
+        case LOOPBACK_IT: return HAL_SPI_TransmitReceive_IT(hspi, tx_data, rx_data, size);
+        case LOOPBACK_DMA: return HAL_SPI_TransmitReceive_DMA(hspi, tx_data, rx_data, size);
+        default: return HAL_ERROR;
+    }
+}
+
+/**
+ * \brief           start one side of an i2c loopback test, the receive is the master and the transmit the slave
+ * \param[in]       hi2c: i2c handle
+ * \param[in]       rx: 1 to receive, 0 to transmit
+ * \param[in]       mode: loopback_mode_t
+ * \param[in]       data: test data
+ * \param[in]       size: bytes transferred
+ * \param[in]       timeout: longest blocking call, in ms
+ * \param[out]      return: hal status
+ */
+static HAL_StatusTypeDef
+loopback_i2c_start(I2C_HandleTypeDef* hi2c, uint8_t rx, uint8_t mode, uint8_t* data, uint16_t size, uint32_t timeout) {
+
+    switch (mode) {
+
+        case LOOPBACK_POLL:
+            return rx ? HAL_I2C_Master_Receive(hi2c, LOOPBACK_I2C_ADDRESS, data, size, timeout)
+                      : HAL_I2C_Slave_Transmit(hi2c, data, size, timeout);
+        case LOOPBACK_IT:
+            return rx ? HAL_I2C_Master_Receive_IT(hi2c, LOOPBACK_I2C_ADDRESS, data, size)
+                      : HAL_I2C_Slave_Transmit_IT(hi2c, data, size);
+        case LOOPBACK_DMA:
+            return rx ? HAL_I2C_Master_Receive_DMA(hi2c, LOOPBACK_I2C_ADDRESS, data, size)
+                      : HAL_I2C_Slave_Transmit_DMA(hi2c, data, size);
+        default: return HAL_ERROR;
+    }
+}
+
+/**
+ * \brief           start one side of a loopback test
+ * \param[in]       test: loopback test
+ * \param[in]       rx: 1 for the receiving side, 0 for the transmitting side
+ * \param[in]       data: test data
+ * \param[in]       size: bytes transferred, of each side of a full duplex test
+ * \param[out]      return: hal status
+ */
+static HAL_StatusTypeDef
+loopback_start(const loopback_test_t* test, uint8_t rx, uint8_t* data, uint16_t size) {
+
+    void* handle = rx ? test->rx_handle : test->tx_handle; /* peripheral of the side */
+    uint8_t mode = rx ? test->rx_mode : test->tx_mode;     /* loopback_mode_t of the side */
+
+    switch (test->bus) {
+
+        case LOOPBACK_UART: return loopback_uart_start(handle, rx, mode, data, size, test->timeout);
+        case LOOPBACK_SPI: return loopback_spi_start(handle, rx, mode, data, size, test->timeout);
+
+        /* each side receives in the half of the buffer the other side transmits from */
+        case LOOPBACK_SPI_EXCHANGE:
+            return rx ? loopback_spi_exchange_start(handle, mode, data, data + size, size, test->timeout)
+                      : loopback_spi_exchange_start(handle, mode, data + size, data, size, test->timeout);
+
+        case LOOPBACK_I2C: return loopback_i2c_start(handle, rx, mode, data, size, test->timeout);
+        default: return HAL_ERROR;
+    }
+}
+
+/**
+ * \brief           abort the transfer of one side of a loopback test, and waite for the abort complete callback
+ * \note            a polled side returned from its blocking call, it has nothing to abort
+ * \param[in]       test: loopback test
+ * \param[in]       rx: 1 for the receiving side, 0 for the transmitting side
+ * \param[in]       interrupt_sem: semaphore of the task, given by the abort complete callback
+ */
+static void
+loopback_abort(const loopback_test_t* test, uint8_t rx, SemaphoreHandle_t interrupt_sem) {
+
+    void* handle = rx ? test->rx_handle : test->tx_handle; /* peripheral of the side */
+    HAL_StatusTypeDef status;                              /* abort return check */
+
+    if ((rx ? test->rx_mode : test->tx_mode) == LOOPBACK_POLL) {
+        return;
+    }
+
+    switch (test->bus) {
+
+        case LOOPBACK_UART: status = HAL_UART_Abort_IT(handle); break;
+        case LOOPBACK_SPI:
+        case LOOPBACK_SPI_EXCHANGE: status = HAL_SPI_Abort_IT(handle); break;
+
+        /* an i2c slave is not aborted by the master abort, no callback follows */
+        case LOOPBACK_I2C: status = HAL_I2C_Master_Abort_IT(handle, LOOPBACK_I2C_ADDRESS); break;
+        default: status = HAL_ERROR; break;
+    }
+
+    if (status == HAL_OK) {
+        xSemaphoreTake(interrupt_sem, pdMS_TO_TICKS(test->timeout));
+    }
+}
+
+/**
+ * \brief           dma handle of one side of a loopback test
+ * \param[in]       test: loopback test
+ * \param[in]       rx: 1 for the receiving side, 0 for the transmitting side
+ * \param[out]      return: dma handle, NULL if the side has no dma stream or its bus no circular transfer
+ */
+static DMA_HandleTypeDef*
+loopback_dma(const loopback_test_t* test, uint8_t rx) {
+
+    void* handle = rx ? test->rx_handle : test->tx_handle; /* peripheral of the side */
+
+    switch (test->bus) {
+
+        case LOOPBACK_UART:
+            return rx ? ((UART_HandleTypeDef*)handle)->hdmarx : ((UART_HandleTypeDef*)handle)->hdmatx;
+        case LOOPBACK_SPI: return rx ? ((SPI_HandleTypeDef*)handle)->hdmarx : ((SPI_HandleTypeDef*)handle)->hdmatx;
+
+        /* the hal i2c transfers have no circular mode, an i2c stream re-arms its transfers */
+        default: return NULL;
+    }
+}
+
+/**
+ * \brief           set the dma mode of the circular sides of a stream test
+ * \note            cube configures the dma streams DMA_NORMAL, a stream sets its circular sides DMA_CIRCULAR while it
+ *                  runs and back DMA_NORMAL for the single transfer tests
+ * \param[in]       test: loopback test
+ * \param[in]       mode: DMA_CIRCULAR or DMA_NORMAL
+ * \param[out]      return: hal status
+ */
+static HAL_StatusTypeDef
+loopback_dma_mode(const loopback_test_t* test, uint32_t mode) {
+
+    DMA_HandleTypeDef* hdma;           /* dma stream of a circular side */
+    HAL_StatusTypeDef status = HAL_OK; /* error return check */
+
+    for (uint8_t rx = 0; rx < 2; rx++) {
+
+        if ((rx ? test->rx_mode : test->tx_mode) != LOOPBACK_CIRCULAR) {
+            continue;
+        }
+        if ((hdma = loopback_dma(test, rx)) == NULL) {
+
+            status = HAL_ERROR;
+            continue;
+        }
+
+        hdma->Init.Mode = mode;
+        if (HAL_DMA_Init(hdma) != HAL_OK) {
+            status = HAL_ERROR;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * \brief           stop the circular side of a stream test, it runs until stopped
+ * \param[in]       test: loopback test
+ * \param[in]       rx: 1 for the receiving side, 0 for the transmitting side
+ */
+static void
+loopback_circular_stop(const loopback_test_t* test, uint8_t rx) {
+
+    void* handle = rx ? test->rx_handle : test->tx_handle; /* peripheral of the side */
+
+    if ((rx ? test->rx_mode : test->tx_mode) != LOOPBACK_CIRCULAR) {
+        return;
+    }
+
+    switch (test->bus) {
+
+        case LOOPBACK_UART: HAL_UART_DMAStop(handle); break;
+        case LOOPBACK_SPI: HAL_SPI_DMAStop(handle); break;
+        default: break;
+    }
+}
+
+/**
+ * \brief           run a stream test, the data goes round until the stream time or byte count and the receive
+ *                  callbacks check it as it comes in
+ * \note            the stream transmits the first half of the test data and receives in the second half. a circular
+ *                  side runs one dma transfer over and over, the receive checks each half of its buffer in the half
+ *                  and full transfer callbacks. the other sides are re-armed, both start again once both completed,
+ *                  so a master clocks a slave circular receive a whole buffer at a time. the stream stops after the
+ *                  re-armed sides complete their last transfer
+ * \param[in]       run: test running, in the route table
+ * \param[in]       data: test data
+ * \param[in]       size: bytes of each transfer
+ * \param[in]       interrupt_sem: semaphore of the task, given once the stream stops
+ * \param[out]      return: error_report_t, MISMATCH if a bit was received different from the bit sent
+ */
+static uint8_t
+loopback_stream(loopback_run_t* run, uint8_t* data, uint16_t size, SemaphoreHandle_t interrupt_sem) {
+
+    const loopback_test_t* test = run->test;                        /* stream test */
+    unit_tasting_package_t* pocket = &run->task->taskX_pack.pocket; /* test request, holding the stream stats */
+    uint8_t drain;                                                  /* re-armed sides still transferring when stopped */
+
+    if (test->bus == LOOPBACK_SPI_EXCHANGE || test->rx_mode == LOOPBACK_POLL || test->tx_mode == LOOPBACK_POLL
+        || size < 2 || loopback_dma_mode(test, DMA_CIRCULAR) != HAL_OK) {
+
+        loopback_dma_mode(test, DMA_NORMAL);
+        return HAL_RETURN_ERROR;
+    }
+
+    run->tx_data = data;
+    run->rx_data = data + size;
+    run->size = size;
+    run->round = (test->rx_mode != LOOPBACK_CIRCULAR) + (test->tx_mode != LOOPBACK_CIRCULAR);
+    run->streaming = 1;
+    run->start_cycles = cycle_counter_read();
+
+    /* the receive starts first, so it takes the first byte transmitted */
+    if (loopback_start(test, 1, run->rx_data, size) != HAL_OK) {
+
+        pocket->error_report = HAL_RETURN_ERROR;
+
+    } else {
+
+        TEST_PHASE_MARK(pocket, TEST_PHASE_TX_START);
+        if (loopback_start(test, 0, run->tx_data, size) != HAL_OK) {
+            pocket->error_report = HAL_RETURN_ERROR;
+        } else {
+
+            /* the semaphore is given early by the byte count or an error callback */
+            xSemaphoreTake(interrupt_sem, pdMS_TO_TICKS(test->stream_ms));
+        }
+    }
+
+    /* the re-armed sides complete the transfers started, then the callbacks give the semaphore */
+    taskENTER_CRITICAL();
+    run->streaming = 0;
+    drain = run->round != 0;
+    taskEXIT_CRITICAL();
+
+    if (pocket->error_report == NO_ERROR && drain
+        && xSemaphoreTake(interrupt_sem, pdMS_TO_TICKS(test->timeout)) != pdTRUE) {
+        pocket->error_report = OVER_TIME;
+    }
+
+    if (pocket->error_report == NO_ERROR) {
+
+        TEST_PHASE_MARK(pocket, TEST_PHASE_TASK_WAKE);
+        loopback_circular_stop(test, 0);
+        loopback_circular_stop(test, 1);
+
+    } else {
+
+        loopback_abort(test, 1, interrupt_sem);
+        loopback_abort(test, 0, interrupt_sem);
+    }
+
+    loopback_dma_mode(test, DMA_NORMAL);
+
+    if (pocket->error_report != NO_ERROR) {
+        return pocket->error_report;
+    }
+    if (pocket->stream.bytes == 0) {
+        return OVER_TIME;
+    }
+    return pocket->stream.bit_errors != 0 ? MISMATCH : NO_ERROR;
+}
+
+/**
+ * \brief           find the loopback test a test request of a task selects
+ * \note            scans the table once for each test request, the hal callbacks use the route table
+ * \param[in]       task: test_task_list_t of the task
+ * \param[in]       test_select: test of the task requested
+ * \param[out]      return: loopback test, NULL if the task has no such test
+ */
+static const loopback_test_t*
+loopback_find(uint8_t task, uint8_t test_select) {
+
+    for (uint16_t i = 0; i < loopback_test_list_size; i++) {
+
+        if (loopback_test_list[i].task != task) {
+            continue;
+        }
+        if (test_select == 0) {
+            return &loopback_test_list[i];
+        }
+        test_select--;
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief           loopback test function of every loopback task, runs the loopback_test_list line of the request
+ *                  the function will be called by "testing_thread"
+ * \note            the side not polled starts first, then the transmit is marked TEST_PHASE_TX_START. the test
+ *                  waits for the completion of both sides not polled, a side failing or not completing in time
+ *                  aborts them
+ * \param[in]       data: data received from testing app vie udp the test hardware
+ *                  to do a data match compare
+ * \param[in]       sizeof_data: size of data
+ * \param[in]       interrupt_sem: semaphore of the task, "&stm_test_list_array[task].q"
+ * \param[in]       test_select: select what test of the task to run
+ * \param[in]       error_report: report to pc about test error
+ */
+void
+loopback_task(uint8_t* data, uint16_t sizeof_data, SemaphoreHandle_t* interrupt_sem, uint8_t test_select,
+              uint8_t* error_report) {
+
+    /* testing_thread passes the semaphore of the test_func_t of the task */
+    test_func_t* task = (test_func_t*)((uint8_t*)interrupt_sem - offsetof(test_func_t, q));
+    const loopback_test_t* test = loopback_find((uint8_t)(task - stm_test_list_array), test_select);
+    loopback_run_t run = {.task = task}; /* test running, found by the hal callbacks */
+    uintptr_t rx_index;                  /* route table index of the receiving peripheral */
+    uintptr_t tx_index;                  /* route table index of the transmitting peripheral */
+    uint16_t size = sizeof_data;         /* bytes transferred by each side */
+    uint8_t rx_first;                    /* the receive starts first */
+    HAL_StatusTypeDef status;            /* error return check */
+    *error_report = NO_ERROR;            /* initalized to  NO_ERROR if an error is accruing it will change it */
+
+    if (test == NULL || (test->rx_mode == LOOPBACK_POLL && test->tx_mode == LOOPBACK_POLL)) {
+
+        *error_report = HAL_RETURN_ERROR;
+        return;
+    }
+
+    rx_index = LOOPBACK_ROUTE_INDEX(loopback_instance(test->bus, test->rx_handle));
+    tx_index = LOOPBACK_ROUTE_INDEX(loopback_instance(test->bus, test->tx_handle));
+    if (rx_index >= LOOPBACK_ROUTE_SIZE || tx_index >= LOOPBACK_ROUTE_SIZE) {
+
+        *error_report = HAL_RETURN_ERROR;
+        return;
+    }
+
+    if (test->size != 0 && test->size < size) {
+        size = test->size;
+    }
+    if (test->bus == LOOPBACK_SPI_EXCHANGE) {
+        size /= 2;
+    }
+
+    /* a callback of an earlier test after it finished leaves the semaphore given */
+    xSemaphoreTake(*interrupt_sem, 0);
+
+    /* a stream transmits half the data and receives in the other half, an even size splits its circular buffer in
+       two halves */
+    if (test->stream_ms != 0) {
+
+        run.test = test;
+        loopback_route[rx_index] = &run;
+        loopback_route[tx_index] = &run;
+        *error_report = loopback_stream(&run, data, (size / 2) & ~1u, *interrupt_sem);
+        loopback_route[rx_index] = NULL;
+        loopback_route[tx_index] = NULL;
+        return;
+    }
+
+    run.pending = (test->rx_mode != LOOPBACK_POLL) + (test->tx_mode != LOOPBACK_POLL);
+    loopback_route[rx_index] = &run;
+    loopback_route[tx_index] = &run;
+
+    /* a blocking receive returns once the data is in, the transmit starts first then */
+    rx_first = test->rx_mode != LOOPBACK_POLL;
+    if (!rx_first) {
+        TEST_PHASE_MARK(&task->taskX_pack.pocket, TEST_PHASE_TX_START);
+    }
+
+    if (loopback_start(test, rx_first, data, size) != HAL_OK) {
+
+        *error_report = HAL_RETURN_ERROR;
+
+    } else {
+
+        if (rx_first) {
+            TEST_PHASE_MARK(&task->taskX_pack.pocket, TEST_PHASE_TX_START);
+        }
+
+        status = loopback_start(test, !rx_first, data, size);
+        if (status != HAL_OK) {
+
+            /* abort the side started, so its callback wont release the semaphore. a blocking call returns
+               HAL_TIMEOUT if the data did not come in time */
+            run.pending = 0;
+            loopback_abort(test, rx_first, *interrupt_sem);
+            *error_report = status == HAL_TIMEOUT ? OVER_TIME : HAL_RETURN_ERROR;
+
+        } else if (run.pending != 0) {
+
+            /* waite for the completion callbacks to release the semaphore, if to match time has passed report over
+               time error */
+            if (xSemaphoreTake(*interrupt_sem, pdMS_TO_TICKS(test->timeout)) == pdTRUE) {
+
+                TEST_PHASE_MARK(&task->taskX_pack.pocket, TEST_PHASE_TASK_WAKE);
+
+            } else if (*error_report == NO_ERROR) {
+
+                *error_report = OVER_TIME;
+            }
+
+            if (*error_report != NO_ERROR) {
+
+                run.pending = 0;
+                loopback_abort(test, 1, *interrupt_sem);
+                loopback_abort(test, 0, *interrupt_sem);
+            }
+        }
+    }
+
+    loopback_route[rx_index] = NULL;
+    loopback_route[tx_index] = NULL;
+}
+
+/**
+ * \brief           check a block of the data a stream received against the data it transmitted
+ * \note            called by the receive callbacks, before the dma writes the block again. the byte count stops the
+ *                  stream once reached
+ * \param[in]       run: stream test running
+ * \param[in]       offset: offset of the block in the transfer
+ * \param[in]       size: bytes of the block
+ */
+static void
+loopback_stream_check(loopback_run_t* run, uint16_t offset, uint16_t size) {
+
+    stream_stats_t* stats = &run->task->taskX_pack.pocket.stream; /* stream statistics replied */
+    uint32_t bit_errors = 0;                                      /* bit errors of the block */
+    BaseType_t woken = pdFALSE;                                   /* the test task was woken */
+
+    for (uint16_t i = offset; i < offset + size; i++) {
+        bit_errors += (uint32_t)__builtin_popcount(run->tx_data[i] ^ run->rx_data[i]);
+    }
+
+    stats->bytes += size;
+    stats->bit_errors += bit_errors;
+    stats->error_blocks += bit_errors != 0;
+    stats->stream_cycles = cycle_counter_read() - run->start_cycles;
+
+    if (run->streaming && run->test->stream_bytes != 0 && stats->bytes >= run->test->stream_bytes) {
+
+        run->streaming = 0;
+        xSemaphoreGiveFromISR(run->task->q, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+/**
+ * \brief           a transfer of a stream test completed, check the data received and start the re-armed sides
+ *                  again once both completed
+ * \note            a circular side completes each time its buffer wraps, the receive checks the second half then.
+ *                  the receive starts again first, so it takes the first byte transmitted. once the stream stopped
+ *                  the last completion releases the semaphore
+ * \param[in]       run: stream test running
+ * \param[in]       rx_done: the transfer received the data
+ */
+static void
+loopback_stream_complete(loopback_run_t* run, uint8_t rx_done) {
+
+    const loopback_test_t* test = run->test; /* stream test */
+    BaseType_t woken = pdFALSE;              /* the test task was woken */
+
+    if ((rx_done ? test->rx_mode : test->tx_mode) == LOOPBACK_CIRCULAR) {
+
+        if (rx_done) {
+            loopback_stream_check(run, run->size / 2, run->size - run->size / 2);
+        }
+        return;
+    }
+
+    if (rx_done) {
+        loopback_stream_check(run, 0, run->size);
+    }
+    if (run->round == 0 || --run->round != 0) {
+        return;
+    }
+
+    if (run->streaming) {
+
+        run->round = (test->rx_mode != LOOPBACK_CIRCULAR) + (test->tx_mode != LOOPBACK_CIRCULAR);
+        if ((test->rx_mode == LOOPBACK_CIRCULAR || loopback_start(test, 1, run->rx_data, run->size) == HAL_OK)
+            && (test->tx_mode == LOOPBACK_CIRCULAR || loopback_start(test, 0, run->tx_data, run->size) == HAL_OK)) {
+            return;
+        }
+
+        run->task->taskX_pack.pocket.error_report = HAL_RETURN_ERROR;
+        run->streaming = 0;
+    }
+
+    xSemaphoreGiveFromISR(run->task->q, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * \brief           a transfer of a loopback test completed, release the semaphore once the test has no transfer left
+ * \param[in]       instance: registers address of the peripheral
+ * \param[in]       rx_done: the transfer received the data
+ */
+static void
+loopback_complete(const void* instance, uint8_t rx_done) {
+
+    uintptr_t index = LOOPBACK_ROUTE_INDEX(instance); /* route table index of the peripheral */
+    loopback_run_t* run;                             /* test of the peripheral */
+    BaseType_t woken = pdFALSE;                      /* the test task was woken */
+
+    if (index >= LOOPBACK_ROUTE_SIZE || (run = loopback_route[index]) == NULL) {
+        return;
+    }
+    if (run->test != NULL) {
+
+        loopback_stream_complete(run, rx_done);
+        return;
+    }
+    if (run->pending == 0) {
+        return;
+    }
+
+    if (rx_done) {
+        TEST_PHASE_MARK(&run->task->taskX_pack.pocket, TEST_PHASE_RX_DONE);
+    }
+
+    if (--run->pending == 0) {
+
+        xSemaphoreGiveFromISR(run->task->q, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+/**
+ * \brief           an error interrupt of a loopback test, report it and release the semaphore
+ * \param[in]       instance: registers address of the peripheral
+ */
+static void
+loopback_error(const void* instance) {
+
+    uintptr_t index = LOOPBACK_ROUTE_INDEX(instance); /* route table index of the peripheral */
+    loopback_run_t* run;                             /* test of the peripheral */
+    BaseType_t woken = pdFALSE;                      /* the test task was woken */
+
+    if (index >= LOOPBACK_ROUTE_SIZE || (run = loopback_route[index]) == NULL
+        || (run->pending == 0 && !run->streaming)) {
+        return;
+    }
+
+    run->task->taskX_pack.pocket.error_report = ERROR_IT;
+    run->pending = 0;
+    run->streaming = 0;
+
+    xSemaphoreGiveFromISR(run->task->q, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * \brief           the first half of the circular receive of a stream test is in, check it
+ * \param[in]       instance: registers address of the peripheral
+ */
+static void
+loopback_half_complete(const void* instance) {
+
+    uintptr_t index = LOOPBACK_ROUTE_INDEX(instance); /* route table index of the peripheral */
+    loopback_run_t* run;                             /* test of the peripheral */
+
+    /* the hal calls the half callback of a dma receive not circular too, it is checked once complete */
+    if (index >= LOOPBACK_ROUTE_SIZE || (run = loopback_route[index]) == NULL || run->test == NULL
+        || run->test->rx_mode != LOOPBACK_CIRCULAR) {
+        return;
+    }
+
+    loopback_stream_check(run, 0, run->size / 2);
+}
+
+/**
+ * \brief           an abort of a loopback test completed, release the semaphore loopback_abort waits on
+ * \param[in]       instance: registers address of the peripheral
+ */
+static void
+loopback_abort_complete(const void* instance) {
+
+    uintptr_t index = LOOPBACK_ROUTE_INDEX(instance); /* route table index of the peripheral */
+    loopback_run_t* run;                             /* test of the peripheral */
+    BaseType_t woken = pdFALSE;                      /* the test task was woken */
+
+    if (index >= LOOPBACK_ROUTE_SIZE || (run = loopback_route[index]) == NULL) {
+        return;
+    }
+
+    xSemaphoreGiveFromISR(run->task->q, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/* peripheral isr callback function`s begin */
+
+void
+HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart) {
+
+    loopback_complete(huart->Instance, 0);
+}
+
+void
+HAL_UART_RxCpltCallback(UART_HandleTypeDef* huart) {
+
+    loopback_complete(huart->Instance, 1);
+}
+
+void
+HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef* huart) {
+
+    loopback_half_complete(huart->Instance);
+}
+
+void
+HAL_UART_ErrorCallback(UART_HandleTypeDef* huart) {
+
+    loopback_error(huart->Instance);
+}
+
+void
+HAL_UART_AbortCpltCallback(UART_HandleTypeDef* huart) {
+
+    loopback_abort_complete(huart->Instance);
+}
+
+void
+HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    loopback_complete(hspi->Instance, 0);
+}
+
+void
+HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    loopback_complete(hspi->Instance, 1);
+}
+
+void
+HAL_SPI_RxHalfCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    loopback_half_complete(hspi->Instance);
+}
+
+void
+HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    loopback_complete(hspi->Instance, 1);
+}
+
+void
+HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi) {
+
+    loopback_error(hspi->Instance);
+}
+
+void
+HAL_SPI_AbortCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    loopback_abort_complete(hspi->Instance);
+}
+
+void
+HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef* hi2c) {
+
+    loopback_complete(hi2c->Instance, 1);
+}
+
+void
+HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef* hi2c) {
+
+    loopback_complete(hi2c->Instance, 0);
+}
+
+void
+HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c) {
+
+    loopback_error(hi2c->Instance);
+}
+
+void
+HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef* hi2c) {
+
+    loopback_abort_complete(hi2c->Instance);
+}
+
+/* peripheral isr callback function end */
@@ -0,0 +1,60 @@
+/**
+ * \file            cc.h
+ * \brief           lwip compiler and platform settings of the host build inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef __CC_H__
+#define __CC_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+typedef int sys_prot_t;
+
+/* the host c library provides errno and struct timeval */
+#define LWIP_ERRNO_STDINCLUDE
+#define LWIP_TIMEVAL_PRIVATE 0
+
+#define PACK_STRUCT_BEGIN
+#define PACK_STRUCT_STRUCT   __attribute__((__packed__))
+#define PACK_STRUCT_END
+#define PACK_STRUCT_FIELD(x) x
+
+#define LWIP_PLATFORM_ASSERT(x)                                                                                        \
+    do {                                                                                                               \
+        printf("Assertion \"%s\" failed at line %d in %s\n", x, __LINE__, __FILE__);                                   \
+    } while (0)
+
+/* Define random number generator function */
+#define LWIP_RAND()          ((u32_t)rand())
+
+#endif /* __CC_H__ */
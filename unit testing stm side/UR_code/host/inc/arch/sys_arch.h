@@ -0,0 +1,59 @@
+/**
+ * \file            sys_arch.h
+ * \brief           lwip operating system layer types of the host build inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef __SYS_ARCH_H__
+#define __SYS_ARCH_H__
+
+#include "lwip/opt.h"
+
+#if (NO_SYS != 0)
+#error "NO_SYS need to be set to 0 to use threaded API"
+#endif
+
+/* cmsis rtos is included as on the board, the firmware tasks use its osDelay */
+#include "cmsis_os.h"
+#include "semphr.h"
+
+/*
+ * the board sys_arch.c passes the mailbox messages through cmsis rtos as 32 bit values, the host pointers are
+ * 64 bit. the host layer is built on the freertos queues directly, they copy whole pointers
+ */
+#define SYS_MBOX_NULL (QueueHandle_t)0
+#define SYS_SEM_NULL  (SemaphoreHandle_t)0
+
+typedef SemaphoreHandle_t sys_sem_t;
+typedef SemaphoreHandle_t sys_mutex_t;
+typedef QueueHandle_t     sys_mbox_t;
+typedef TaskHandle_t      sys_thread_t;
+
+#endif /* __SYS_ARCH_H__ */
@@ -0,0 +1,650 @@
+/**
+ * \file            host_hal.h
+ * \brief           loopback models of the stm32 hal peripherals of the host build inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef HOST_INC_HOST_HAL_H_
+#define HOST_INC_HOST_HAL_H_
+
+#include <stdint.h>
+
+/**
+ * \brief                     base of the peripheral registers, the host handles hold the board peripheral addresses
+ *                            so the code telling peripherals apart by their Instance runs unchanged
+ * \hideinitializer
+ */
+#define PERIPH_BASE               0x40000000UL
+
+/**
+ * \brief                     first address of the stm32f746 flash, the host maps its flash in ram at this address
+ * \hideinitializer
+ */
+#define FLASH_BASE                0x08000000UL
+
+/**
+ * \brief                     size of the stm32f746zg flash
+ * \hideinitializer
+ */
+#define HOST_FLASH_SIZE           0x100000UL
+
+/**
+ * \brief                     number of flash sectors
+ * \hideinitializer
+ */
+#define HOST_FLASH_SECTOR_NUM     8
+
+/**
+ * \brief                     words of the unique id
+ * \hideinitializer
+ */
+#define HOST_UID_SIZE             3
+
+/**
+ * \brief                     host isr task stack size
+ * \hideinitializer
+ */
+#define HOST_ISR_TASK_STACK_SIZE  configMINIMAL_STACK_SIZE * 2
+
+/**
+ * \brief                     clock of the APB1 bus, of the can bit timing
+ * \hideinitializer
+ */
+#define HOST_PCLK1_HZ             54000000UL
+
+/**
+ * \brief                     transmit mailboxes of a can
+ * \hideinitializer
+ */
+#define HOST_CAN_MAILBOX_NUM      3
+
+/**
+ * \brief                     frames a can receive fifo holds, a frame received into a full fifo is lost
+ * \hideinitializer
+ */
+#define HOST_CAN_FIFO_SIZE        3
+
+/**
+ * \brief                     bytes of data of a can frame
+ * \hideinitializer
+ */
+#define HOST_CAN_DATA_SIZE        8
+
+/**
+ * \brief           hal weak callbacks, the test code overrides the callbacks it uses
+ * \hideinitializer
+ */
+#define __weak                    __attribute__((weak))
+
+/* peripheral register blocks, never dereferenced on the host */
+typedef struct usart_type USART_TypeDef;
+typedef struct spi_type SPI_TypeDef;
+typedef struct i2c_type I2C_TypeDef;
+typedef struct adc_type ADC_TypeDef;
+typedef struct dac_type DAC_TypeDef;
+typedef struct dma_stream_type DMA_Stream_TypeDef;
+typedef struct can_type CAN_TypeDef;
+
+#define USART2                    ((USART_TypeDef*)(PERIPH_BASE + 0x4400UL))
+#define USART3                    ((USART_TypeDef*)(PERIPH_BASE + 0x4800UL))
+#define UART4                     ((USART_TypeDef*)(PERIPH_BASE + 0x4C00UL))
+#define UART5                     ((USART_TypeDef*)(PERIPH_BASE + 0x5000UL))
+#define UART7                     ((USART_TypeDef*)(PERIPH_BASE + 0x7800UL))
+#define UART8                     ((USART_TypeDef*)(PERIPH_BASE + 0x7C00UL))
+#define USART1                    ((USART_TypeDef*)(PERIPH_BASE + 0x11000UL))
+#define USART6                    ((USART_TypeDef*)(PERIPH_BASE + 0x11400UL))
+#define SPI2                      ((SPI_TypeDef*)(PERIPH_BASE + 0x3800UL))
+#define SPI3                      ((SPI_TypeDef*)(PERIPH_BASE + 0x3C00UL))
+#define SPI1                      ((SPI_TypeDef*)(PERIPH_BASE + 0x13000UL))
+#define SPI4                      ((SPI_TypeDef*)(PERIPH_BASE + 0x13400UL))
+#define SPI5                      ((SPI_TypeDef*)(PERIPH_BASE + 0x15000UL))
+#define I2C1                      ((I2C_TypeDef*)(PERIPH_BASE + 0x5400UL))
+#define I2C2                      ((I2C_TypeDef*)(PERIPH_BASE + 0x5800UL))
+#define I2C3                      ((I2C_TypeDef*)(PERIPH_BASE + 0x5C00UL))
+#define I2C4                      ((I2C_TypeDef*)(PERIPH_BASE + 0x6000UL))
+#define CAN1                      ((CAN_TypeDef*)(PERIPH_BASE + 0x6400UL))
+#define CAN2                      ((CAN_TypeDef*)(PERIPH_BASE + 0x6800UL))
+#define DAC                       ((DAC_TypeDef*)(PERIPH_BASE + 0x7400UL))
+#define ADC1                      ((ADC_TypeDef*)(PERIPH_BASE + 0x12000UL))
+#define ADC2                      ((ADC_TypeDef*)(PERIPH_BASE + 0x12100UL))
+#define ADC3                      ((ADC_TypeDef*)(PERIPH_BASE + 0x12200UL))
+
+/* dac and adc */
+#define DAC_CHANNEL_1             0x00000000U
+#define DAC_CHANNEL_2             0x00000010U
+#define DAC1_CHANNEL_1            DAC_CHANNEL_1
+#define DAC1_CHANNEL_2            DAC_CHANNEL_2
+#define DAC_ALIGN_12B_R           0x00000000U
+#define DAC_ALIGN_12B_L           0x00000004U
+#define DAC_ALIGN_8B_R            0x00000008U
+
+/* dma */
+#define DMA_NORMAL                0x00000000U
+#define DMA_CIRCULAR              0x00000100U
+
+/* can */
+#define DISABLE                   0U
+#define ENABLE                    1U
+#define CAN_MODE_NORMAL           0x00000000U
+#define CAN_SJW_1TQ               0x00000000U
+#define CAN_BTR_TS1_Pos           16U
+#define CAN_BTR_TS2_Pos           20U
+#define CAN_BS1_2TQ               (1U << CAN_BTR_TS1_Pos)
+#define CAN_BS2_2TQ               (1U << CAN_BTR_TS2_Pos)
+#define CAN_ID_STD                0x00000000U
+#define CAN_ID_EXT                0x00000004U
+#define CAN_RTR_DATA              0x00000000U
+#define CAN_RTR_REMOTE            0x00000002U
+#define CAN_RX_FIFO0              0x00000000U
+#define CAN_RX_FIFO1              0x00000001U
+#define CAN_TX_MAILBOX0           0x00000001U
+#define CAN_TX_MAILBOX1           0x00000002U
+#define CAN_TX_MAILBOX2           0x00000004U
+#define CAN_FILTERMODE_IDMASK     0x00000000U
+#define CAN_FILTERMODE_IDLIST     0x00000001U
+#define CAN_FILTERSCALE_16BIT     0x00000000U
+#define CAN_FILTERSCALE_32BIT     0x00000001U
+#define CAN_FILTER_FIFO0          0x00000000U
+#define CAN_FILTER_FIFO1          0x00000001U
+#define CAN_FILTER_DISABLE        0x00000000U
+#define CAN_FILTER_ENABLE         0x00000001U
+#define CAN_IT_TX_MAILBOX_EMPTY   0x00000001U
+#define CAN_IT_RX_FIFO0_MSG_PENDING 0x00000002U
+#define CAN_IT_BUSOFF             0x00000400U
+#define CAN_IT_LAST_ERROR_CODE    0x00000800U
+#define CAN_IT_ERROR              0x00008000U
+
+/* flash */
+#define FLASH_TYPEERASE_SECTORS   0x00000000U
+#define FLASH_TYPEERASE_MASSERASE 0x00000001U
+#define FLASH_TYPEPROGRAM_BYTE    0x00000000U
+#define FLASH_TYPEPROGRAM_HALFWORD 0x00000001U
+#define FLASH_TYPEPROGRAM_WORD    0x00000002U
+#define FLASH_TYPEPROGRAM_DOUBLEWORD 0x00000003U
+#define FLASH_VOLTAGE_RANGE_1     0x00000000U
+#define FLASH_VOLTAGE_RANGE_2     0x00000001U
+#define FLASH_VOLTAGE_RANGE_3     0x00000002U
+#define FLASH_VOLTAGE_RANGE_4     0x00000003U
+#define FLASH_SECTOR_0            0U
+#define FLASH_SECTOR_1            1U
+#define FLASH_SECTOR_2            2U
+#define FLASH_SECTOR_3            3U
+#define FLASH_SECTOR_4            4U
+#define FLASH_SECTOR_5            5U
+#define FLASH_SECTOR_6            6U
+#define FLASH_SECTOR_7            7U
+#define FLASH_FLAG_EOP            0x00000001U
+#define FLASH_FLAG_OPERR          0x00000002U
+#define FLASH_FLAG_WRPERR         0x00000010U
+#define FLASH_FLAG_PGAERR         0x00000020U
+#define FLASH_FLAG_PGPERR         0x00000040U
+#define FLASH_FLAG_ERSERR         0x00000080U
+
+/**
+ * \brief           the host flash has no status flags to clear
+ * \hideinitializer
+ */
+#define __HAL_FLASH_CLEAR_FLAG(flag) ((void)(flag))
+
+/**
+ * \brief           hal function return
+ */
+typedef enum {
+
+    HAL_OK = 0x00U,     /*!< the operation started or finished */
+    HAL_ERROR = 0x01U,  /*!< bad argument or peripheral state */
+    HAL_BUSY = 0x02U,   /*!< the peripheral is running another operation */
+    HAL_TIMEOUT = 0x03U /*!< the operation did not finish in time */
+
+} HAL_StatusTypeDef;
+
+/**
+ * \brief           host build errors, exit code of the host firmware
+ */
+typedef enum host_error {
+
+    HOST_OK,                 /*!< no error */
+    HOST_BAD_ARGUMENT,       /*!< bad command line argument */
+    HOST_FLASH_MAP_FAILED,   /*!< the flash could not be mapped at FLASH_BASE */
+    HOST_TASK_CREATE_FAILED, /*!< failed to create a host task */
+    HOST_TAP_OPEN_FAILED     /*!< failed to open the tap interface */
+
+} host_error_t;
+
+/**
+ * \brief           operation started on one direction of a host port
+ */
+typedef enum host_op {
+
+    HOST_OP_NONE,     /*!< the direction is idle */
+    HOST_OP_TRANSFER, /*!< uart or spi transmit or receive, by interrupt or dma */
+    HOST_OP_CIRCULAR, /*!< uart or spi transmit or receive by a DMA_CIRCULAR dma, runs until stopped */
+    HOST_OP_EXCHANGE, /*!< spi transmit and receive together, full duplex */
+    HOST_OP_MASTER,   /*!< i2c master transmit or receive */
+    HOST_OP_SLAVE     /*!< i2c slave transmit or receive */
+
+} host_op_t;
+
+/**
+ * \brief           peripheral kind of a host port, selects the hal callbacks the host isr task calls
+ */
+typedef enum host_port_type {
+
+    HOST_PORT_UART, /*!< HAL_UART_ callbacks */
+    HOST_PORT_SPI,  /*!< HAL_SPI_ callbacks */
+    HOST_PORT_I2C   /*!< HAL_I2C_ callbacks */
+
+} host_port_type_t;
+
+/**
+ * \brief           interrupts pending on a host port, like the nvic pending bits
+ */
+typedef enum host_irq {
+
+    HOST_IRQ_TX_DONE = 0x01,   /*!< transmit complete */
+    HOST_IRQ_RX_DONE = 0x02,   /*!< receive complete */
+    HOST_IRQ_TXRX_DONE = 0x04, /*!< full duplex transfer complete */
+    HOST_IRQ_ABORT = 0x08,     /*!< abort complete */
+    HOST_IRQ_RX_HALF = 0x10    /*!< first half of a circular receive complete */
+
+} host_irq_t;
+
+/**
+ * \brief           one end of a loopback wire between two peripherals of the host build
+ * \note            data moves when one end transmits and the other receives, whichever starts last.
+ *                  bytes transmitted past the end of the receive buffer are lost, like on the wire.
+ *                  a circular end moves half its buffer at a time, the host isr task moves the next half a tick
+ *                  later. it wraps to the start of its buffer at the end
+ */
+typedef struct host_port {
+
+    struct host_port* peer;  /*!< port at the other end of the wire */
+    void* handle;            /*!< handle owning the port, passed to its callbacks */
+    uint8_t type;            /*!< host_port_type_t */
+    const uint8_t* tx_start; /*!< data of the transmit started, a circular transmit wraps to it */
+    uint16_t tx_length;      /*!< bytes of the transmit started */
+    const uint8_t* tx_data;  /*!< data left to transmit */
+    uint16_t tx_size;        /*!< bytes left to transmit */
+    uint8_t tx_op;           /*!< host_op_t running on the transmit direction */
+    uint8_t* rx_start;       /*!< buffer of the receive started, a circular receive wraps to it */
+    uint16_t rx_length;      /*!< bytes of the receive started */
+    uint8_t* rx_data;        /*!< place of the next byte received */
+    uint16_t rx_size;        /*!< bytes left to receive */
+    uint8_t rx_op;           /*!< host_op_t running on the receive direction */
+    uint8_t tx_done_op;      /*!< host_op_t of the last transmit completed, i2c master or slave callbacks */
+    uint8_t rx_done_op;      /*!< host_op_t of the last receive completed, i2c master or slave callbacks */
+    uint8_t pending;         /*!< host_irq_t flags the host isr task handles next */
+    uint8_t poll;            /*!< host_irq_t flags a blocking hal call waits for, they raise no callback */
+
+} host_port_t;
+
+/**
+ * \brief           dma stream configuration, the host uses the mode
+ */
+typedef struct {
+
+    uint32_t Mode; /*!< DMA_NORMAL or DMA_CIRCULAR */
+
+} DMA_InitTypeDef;
+
+/**
+ * \brief           dma stream handle, the host transfers dma requests like interrupt requests
+ */
+typedef struct {
+
+    DMA_Stream_TypeDef* Instance; /*!< dma stream registers address */
+    DMA_InitTypeDef Init;         /*!< dma stream configuration, the host uses the mode */
+
+} DMA_HandleTypeDef;
+
+/**
+ * \brief           uart handle
+ */
+typedef struct {
+
+    USART_TypeDef* Instance;   /*!< uart registers address */
+    DMA_HandleTypeDef* hdmatx; /*!< dma stream of the transmit, NULL if the uart has none */
+    DMA_HandleTypeDef* hdmarx; /*!< dma stream of the receive, NULL if the uart has none */
+    host_port_t port;          /*!< loopback model of the uart */
+
+} UART_HandleTypeDef;
+
+/**
+ * \brief           spi handle
+ */
+typedef struct {
+
+    SPI_TypeDef* Instance;     /*!< spi registers address */
+    DMA_HandleTypeDef* hdmatx; /*!< dma stream of the transmit, NULL if the spi has none */
+    DMA_HandleTypeDef* hdmarx; /*!< dma stream of the receive, NULL if the spi has none */
+    host_port_t port;          /*!< loopback model of the spi */
+
+} SPI_HandleTypeDef;
+
+/**
+ * \brief           i2c handle
+ */
+typedef struct {
+
+    I2C_TypeDef* Instance; /*!< i2c registers address */
+    host_port_t port;      /*!< loopback model of the i2c */
+
+} I2C_HandleTypeDef;
+
+/**
+ * \brief           can bit timing and modes, the host uses the bit timing and the time triggered mode
+ */
+typedef struct {
+
+    uint32_t Prescaler;            /*!< clocks of a time quantum */
+    uint32_t Mode;                 /*!< CAN_MODE_NORMAL */
+    uint32_t SyncJumpWidth;        /*!< unused on the host */
+    uint32_t TimeSeg1;             /*!< CAN_BS1_ time quanta before the sample point */
+    uint32_t TimeSeg2;             /*!< CAN_BS2_ time quanta after the sample point */
+    uint32_t TimeTriggeredMode;    /*!< ENABLE to timestamp the frames received */
+    uint32_t AutoBusOff;           /*!< unused on the host */
+    uint32_t AutoWakeUp;           /*!< unused on the host */
+    uint32_t AutoRetransmission;   /*!< unused on the host, the wire loses no frame */
+    uint32_t ReceiveFifoLocked;    /*!< unused on the host, a frame received into a full fifo is lost */
+    uint32_t TransmitFifoPriority; /*!< unused on the host, the lowest id goes first */
+
+} CAN_InitTypeDef;
+
+/**
+ * \brief           header of a can frame transmitted
+ */
+typedef struct {
+
+    uint32_t StdId;              /*!< standard id */
+    uint32_t ExtId;              /*!< extended id */
+    uint32_t IDE;                /*!< CAN_ID_STD or CAN_ID_EXT */
+    uint32_t RTR;                /*!< CAN_RTR_DATA or CAN_RTR_REMOTE */
+    uint32_t DLC;                /*!< data bytes */
+    uint32_t TransmitGlobalTime; /*!< unused on the host */
+
+} CAN_TxHeaderTypeDef;
+
+/**
+ * \brief           header of a can frame received
+ */
+typedef struct {
+
+    uint32_t StdId;            /*!< standard id */
+    uint32_t ExtId;            /*!< extended id */
+    uint32_t IDE;              /*!< CAN_ID_STD or CAN_ID_EXT */
+    uint32_t RTR;              /*!< CAN_RTR_DATA or CAN_RTR_REMOTE */
+    uint32_t DLC;              /*!< data bytes */
+    uint32_t Timestamp;        /*!< can timer at the start of the frame in bit times, time triggered mode only */
+    uint32_t FilterMatchIndex; /*!< filter that accepted the frame */
+
+} CAN_RxHeaderTypeDef;
+
+/**
+ * \brief           can filter bank, the host accepts every frame once a filter is enabled
+ */
+typedef struct {
+
+    uint32_t FilterIdHigh;         /*!< unused on the host */
+    uint32_t FilterIdLow;          /*!< unused on the host */
+    uint32_t FilterMaskIdHigh;     /*!< unused on the host */
+    uint32_t FilterMaskIdLow;      /*!< unused on the host */
+    uint32_t FilterFIFOAssignment; /*!< CAN_FILTER_FIFO0, the host has fifo 0 only */
+    uint32_t FilterBank;           /*!< filter bank */
+    uint32_t FilterMode;           /*!< unused on the host */
+    uint32_t FilterScale;          /*!< unused on the host */
+    uint32_t FilterActivation;     /*!< CAN_FILTER_ENABLE */
+    uint32_t SlaveStartFilterBank; /*!< unused on the host */
+
+} CAN_FilterTypeDef;
+
+/**
+ * \brief           a can frame in a transmit mailbox or a receive fifo
+ */
+typedef struct host_can_frame {
+
+    uint32_t id;                       /*!< 29 bit arbitration id, a standard id in the high 11 bits */
+    uint8_t ext;                       /*!< extended id */
+    uint8_t dlc;                       /*!< data bytes */
+    uint8_t data[HOST_CAN_DATA_SIZE];  /*!< frame data */
+    uint16_t timestamp;                /*!< can timer of the receiver at the start of the frame */
+
+} host_can_frame_t;
+
+/**
+ * \brief           can model, the two cans of the board are wired to one bus
+ * \note            the host isr task sends the mailbox frame with the lowest id, one frame at a time. the bus
+ *                  time runs in bit times, a frame starts when the bus is free and not before the host clock
+ */
+typedef struct host_can {
+
+    struct can_handle* peer;                        /*!< can at the other end of the bus */
+    uint8_t started;                                /*!< the can takes part in the bus */
+    uint8_t filtered;                               /*!< a filter is enabled, the can receives the frames */
+    uint32_t its;                                   /*!< CAN_IT_ notifications active */
+    uint8_t mailbox_used;                           /*!< CAN_TX_MAILBOX flags of the mailboxes holding a frame */
+    host_can_frame_t mailbox[HOST_CAN_MAILBOX_NUM]; /*!< transmit mailboxes */
+    host_can_frame_t fifo[HOST_CAN_FIFO_SIZE];      /*!< receive fifo 0 */
+    uint8_t fifo_first;                             /*!< oldest frame of the fifo */
+    uint8_t fifo_num;                               /*!< frames in the fifo */
+
+} host_can_t;
+
+/**
+ * \brief           can handle
+ */
+typedef struct can_handle {
+
+    CAN_TypeDef* Instance; /*!< can registers address */
+    CAN_InitTypeDef Init;  /*!< bit timing and modes */
+    uint32_t ErrorCode;    /*!< no error is raised on the host */
+    host_can_t can;        /*!< model of the can */
+
+} CAN_HandleTypeDef;
+
+/**
+ * \brief           dac handle
+ */
+typedef struct {
+
+    DAC_TypeDef* Instance; /*!< dac registers address */
+    uint8_t started[2];    /*!< channel output enabled */
+    uint32_t code[2];      /*!< 12 bit code on the channel output */
+
+} DAC_HandleTypeDef;
+
+/**
+ * \brief           adc handle, the adc input is wired to dac channel 1
+ */
+typedef struct {
+
+    ADC_TypeDef* Instance; /*!< adc registers address */
+    uint8_t started;       /*!< conversion started */
+    uint8_t converted;     /*!< conversion finished, HAL_ADC_GetValue may read it */
+    uint32_t value;        /*!< code converted */
+
+} ADC_HandleTypeDef;
+
+/**
+ * \brief           flash erase request
+ */
+typedef struct {
+
+    uint32_t TypeErase;    /*!< FLASH_TYPEERASE_SECTORS or FLASH_TYPEERASE_MASSERASE */
+    uint32_t Banks;        /*!< unused, the stm32f746 flash has one bank */
+    uint32_t Sector;       /*!< first sector erased */
+    uint32_t NbSectors;    /*!< number of sectors erased */
+    uint32_t VoltageRange; /*!< unused on the host */
+
+} FLASH_EraseInitTypeDef;
+
+/**
+ * \brief           flash procedure running
+ */
+typedef enum host_flash_procedure {
+
+    HOST_FLASH_NONE,   /*!< the flash is idle */
+    HOST_FLASH_ERASE,  /*!< sectors are erased */
+    HOST_FLASH_PROGRAM /*!< a word is programmed */
+
+} host_flash_procedure_t;
+
+/**
+ * \brief           flash model, ram mapped at FLASH_BASE so the code reading the flash by address runs unchanged
+ * \note            programming only clears bits, like the flash cells. a sector must be erased to program it again
+ */
+typedef struct host_flash {
+
+    uint8_t* memory;     /*!< flash content, mapped at FLASH_BASE */
+    uint8_t locked;      /*!< the flash control register is locked, erase and program are refused */
+    uint8_t procedure;   /*!< host_flash_procedure_t running */
+    uint32_t sector;     /*!< next sector to erase */
+    uint32_t sector_num; /*!< sectors left to erase */
+    uint32_t address;    /*!< address programmed */
+    uint8_t pending;     /*!< end of operation interrupt pending */
+
+} host_flash_t;
+
+/**
+ * \brief           two ports wired together on the board
+ */
+typedef struct host_wire {
+
+    host_port_t* port_a; /*!< one end of the wire */
+    host_port_t* port_b; /*!< the other end of the wire */
+
+} host_wire_t;
+
+/* host build */
+uint8_t host_hal_init(const uint32_t* uid);
+
+/* uart */
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_DMAStop(UART_HandleTypeDef* huart);
+HAL_StatusTypeDef HAL_UART_Abort_IT(UART_HandleTypeDef* huart);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef* huart);
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef* huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart);
+void HAL_UART_AbortCpltCallback(UART_HandleTypeDef* huart);
+
+/* spi */
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size,
+                                          uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_IT(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Receive_IT(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_IT(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData,
+                                              uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_DMAStop(SPI_HandleTypeDef* hspi);
+HAL_StatusTypeDef HAL_SPI_Abort_IT(SPI_HandleTypeDef* hspi);
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi);
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi);
+void HAL_SPI_RxHalfCpltCallback(SPI_HandleTypeDef* hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi);
+void HAL_SPI_AbortCpltCallback(SPI_HandleTypeDef* hspi);
+
+/* i2c */
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef* hi2c, uint16_t DevAddress, uint8_t* pData, uint16_t Size,
+                                         uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Slave_Transmit(I2C_HandleTypeDef* hi2c, uint8_t* pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef* hi2c, uint16_t DevAddress, uint8_t* pData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef* hi2c, uint16_t DevAddress, uint8_t* pData,
+                                            uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef* hi2c, uint16_t DevAddress, uint8_t* pData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Slave_Transmit_IT(I2C_HandleTypeDef* hi2c, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Slave_Transmit_DMA(I2C_HandleTypeDef* hi2c, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Slave_Receive_IT(I2C_HandleTypeDef* hi2c, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef* hi2c, uint16_t DevAddress);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef* hi2c);
+
+/* dma */
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma);
+
+/* can */
+HAL_StatusTypeDef HAL_CAN_Init(CAN_HandleTypeDef* hcan);
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef* hcan, const CAN_FilterTypeDef* sFilterConfig);
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef* hcan);
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef* hcan, uint32_t ActiveITs);
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef* hcan, const CAN_TxHeaderTypeDef* pHeader,
+                                       const uint8_t aData[], uint32_t* pTxMailbox);
+HAL_StatusTypeDef HAL_CAN_AbortTxRequest(CAN_HandleTypeDef* hcan, uint32_t TxMailboxes);
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(const CAN_HandleTypeDef* hcan);
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef* hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef* pHeader,
+                                       uint8_t aData[]);
+uint32_t HAL_CAN_GetRxFifoFillLevel(const CAN_HandleTypeDef* hcan, uint32_t RxFifo);
+HAL_StatusTypeDef HAL_CAN_ResetError(CAN_HandleTypeDef* hcan);
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef* hcan);
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef* hcan);
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef* hcan);
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan);
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef* hcan);
+
+/* dac and adc */
+HAL_StatusTypeDef HAL_DAC_Start(DAC_HandleTypeDef* hdac, uint32_t Channel);
+HAL_StatusTypeDef HAL_DAC_Stop(DAC_HandleTypeDef* hdac, uint32_t Channel);
+HAL_StatusTypeDef HAL_DAC_SetValue(DAC_HandleTypeDef* hdac, uint32_t Channel, uint32_t Alignment, uint32_t Data);
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc, uint32_t Timeout);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef* hadc);
+
+/* flash */
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef* pEraseInit);
+HAL_StatusTypeDef HAL_FLASH_Program_IT(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+void HAL_FLASH_EndOfOperationCallback(uint32_t ReturnValue);
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue);
+
+/* system */
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_GetUIDw0(void);
+uint32_t HAL_GetUIDw1(void);
+uint32_t HAL_GetUIDw2(void);
+
+#endif /* HOST_INC_HOST_HAL_H_ */
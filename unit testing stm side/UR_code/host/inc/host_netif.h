@@ -0,0 +1,78 @@
+/**
+ * \file            host_netif.h
+ * \brief           lwip network interface of the host build on a tap interface inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef HOST_INC_HOST_NETIF_H_
+#define HOST_INC_HOST_NETIF_H_
+
+#include "lwip/netif.h"
+
+/**
+ * \brief                     size of the tap interface name
+ * \hideinitializer
+ */
+#define HOST_TAP_NAME_SIZE        16
+
+/**
+ * \brief                     tap interface the host firmware answers on by default
+ * \hideinitializer
+ */
+#define HOST_TAP_NAME             "ur0"
+
+/**
+ * \brief                     longest time the netif input task waits in poll before it checks the tap again, in ms
+ * \hideinitializer
+ */
+#define HOST_NETIF_POLL_MS        10
+
+/**
+ * \brief                     netif input task stack size
+ * \hideinitializer
+ */
+#define HOST_NETIF_TASK_STACK_SIZE configMINIMAL_STACK_SIZE * 2
+
+/**
+ * \brief            network settings of the host firmware, set from the command line
+ */
+typedef struct host_netif_setting {
+
+    char tap_name[HOST_TAP_NAME_SIZE]; /*!< tap interface the card answers on */
+    uint8_t ip[4];                     /*!< card ip address, the pc side of the tap is .1 of its /24 network */
+    int tap_fd;                        /*!< opened tap, -1 if not opened */
+
+} host_netif_setting_t;
+
+extern host_netif_setting_t host_netif_setting;
+
+err_t host_netif_init(struct netif* netif);
+
+#endif /* HOST_INC_HOST_NETIF_H_ */
@@ -0,0 +1,51 @@
+/**
+ * \file            host_tap.h
+ * \brief           tap interface the host build exchanges ethernet frames with the pc on inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef HOST_INC_HOST_TAP_H_
+#define HOST_INC_HOST_TAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \brief                     longest ethernet frame read from or written to the tap, with a vlan tag
+ * \hideinitializer
+ */
+#define HOST_FRAME_SIZE           1518
+
+int host_tap_open(const char* name, const uint8_t* pc_ip);
+int host_tap_wait(int tap_fd, int timeout_ms);
+int host_tap_read(int tap_fd, uint8_t* frame, size_t size);
+int host_tap_write(int tap_fd, const uint8_t* frame, size_t size);
+
+#endif /* HOST_INC_HOST_TAP_H_ */
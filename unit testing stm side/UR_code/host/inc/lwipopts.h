@@ -0,0 +1,73 @@
+/**
+ * \file            lwipopts.h
+ * \brief           lwip settings of the host build inc file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef __LWIPOPTS__H__
+#define __LWIPOPTS__H__
+
+/* as the board, LWIP/Target/lwipopts.h. the host computes the checksums the board ethernet mac does in hardware,
+   the thread stacks hold at least a posix thread stack, and the sockets api the firmware does not use is left out */
+#define WITH_RTOS                 1
+#define LWIP_SOCKET               0
+#define MEMP_NUM_UDP_PCB          16
+#define MEM_ALIGNMENT             4
+#define MEM_SIZE                  10000
+#define MEMP_NUM_RAW_PCB          10
+#define LWIP_ETHERNET             1
+#define LWIP_DNS_SECURE           7
+#define TCP_SND_QUEUELEN          9
+#define TCP_SNDLOWAT              1071
+#define TCP_SNDQUEUELOWAT         5
+#define TCP_WND_UPDATE_THRESHOLD  536
+#define LWIP_NETIF_LINK_CALLBACK  1
+#define TCPIP_THREAD_STACKSIZE    configMINIMAL_STACK_SIZE * 2
+#define TCPIP_THREAD_PRIO         osPriorityNormal
+#define TCPIP_MBOX_SIZE           6
+#define SLIPIF_THREAD_STACKSIZE   configMINIMAL_STACK_SIZE * 2
+#define SLIPIF_THREAD_PRIO        3
+#define DEFAULT_THREAD_STACKSIZE  configMINIMAL_STACK_SIZE * 2
+#define DEFAULT_THREAD_PRIO       3
+#define DEFAULT_UDP_RECVMBOX_SIZE 6
+#define DEFAULT_TCP_RECVMBOX_SIZE 6
+#define DEFAULT_ACCEPTMBOX_SIZE   6
+#define RECV_BUFSIZE_DEFAULT      2000000000
+#define LWIP_STATS                0
+#define CHECKSUM_GEN_IP           1
+#define CHECKSUM_GEN_UDP          1
+#define CHECKSUM_GEN_TCP          1
+#define CHECKSUM_GEN_ICMP         1
+#define CHECKSUM_CHECK_IP         1
+#define CHECKSUM_CHECK_UDP        1
+#define CHECKSUM_CHECK_TCP        1
+#define CHECKSUM_CHECK_ICMP       1
+
+#endif /*__LWIPOPTS__H__ */
@@ -0,0 +1,1504 @@
+/**
+ * \file            host_hal.c
+ * \brief           loopback models of the stm32 hal peripherals of the host build src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include <sys/mman.h>
+#include <time.h>
+#include "main_ur.h"
+#include "can_test.h"
+#include "dac_adc_test.h"
+#include "i2c_test.h"
+#include "spi_test.h"
+#include "uart_test.h"
+
+/* dma streams, on the board defined and linked to their peripherals by the cube generated code */
+DMA_HandleTypeDef hdma_usart1_rx;
+DMA_HandleTypeDef hdma_usart1_tx;
+DMA_HandleTypeDef hdma_uart4_rx;
+DMA_HandleTypeDef hdma_uart4_tx;
+DMA_HandleTypeDef hdma_uart5_rx;
+DMA_HandleTypeDef hdma_uart5_tx;
+DMA_HandleTypeDef hdma_usart6_rx;
+DMA_HandleTypeDef hdma_usart6_tx;
+DMA_HandleTypeDef hdma_uart8_rx;
+DMA_HandleTypeDef hdma_spi1_rx;
+DMA_HandleTypeDef hdma_spi1_tx;
+DMA_HandleTypeDef hdma_spi2_rx;
+DMA_HandleTypeDef hdma_spi4_rx;
+DMA_HandleTypeDef hdma_spi4_tx;
+
+/* peripheral handles, on the board defined by the cube generated code */
+UART_HandleTypeDef huart1 = {.Instance = USART1,
+                             .hdmatx = &hdma_usart1_tx,
+                             .hdmarx = &hdma_usart1_rx,
+                             .port = {.handle = &huart1, .type = HOST_PORT_UART}};
+UART_HandleTypeDef huart2 = {.Instance = USART2, .port = {.handle = &huart2, .type = HOST_PORT_UART}};
+UART_HandleTypeDef huart4 = {.Instance = UART4,
+                             .hdmatx = &hdma_uart4_tx,
+                             .hdmarx = &hdma_uart4_rx,
+                             .port = {.handle = &huart4, .type = HOST_PORT_UART}};
+UART_HandleTypeDef huart5 = {.Instance = UART5,
+                             .hdmatx = &hdma_uart5_tx,
+                             .hdmarx = &hdma_uart5_rx,
+                             .port = {.handle = &huart5, .type = HOST_PORT_UART}};
+UART_HandleTypeDef huart3 = {.Instance = USART3, .port = {.handle = &huart3, .type = HOST_PORT_UART}};
+UART_HandleTypeDef huart6 = {.Instance = USART6,
+                             .hdmatx = &hdma_usart6_tx,
+                             .hdmarx = &hdma_usart6_rx,
+                             .port = {.handle = &huart6, .type = HOST_PORT_UART}};
+UART_HandleTypeDef huart7 = {.Instance = UART7, .port = {.handle = &huart7, .type = HOST_PORT_UART}};
+UART_HandleTypeDef huart8 = {.Instance = UART8,
+                             .hdmarx = &hdma_uart8_rx,
+                             .port = {.handle = &huart8, .type = HOST_PORT_UART}};
+SPI_HandleTypeDef hspi1 = {.Instance = SPI1,
+                           .hdmatx = &hdma_spi1_tx,
+                           .hdmarx = &hdma_spi1_rx,
+                           .port = {.handle = &hspi1, .type = HOST_PORT_SPI}};
+SPI_HandleTypeDef hspi2 = {.Instance = SPI2,
+                           .hdmarx = &hdma_spi2_rx,
+                           .port = {.handle = &hspi2, .type = HOST_PORT_SPI}};
+SPI_HandleTypeDef hspi3 = {.Instance = SPI3, .port = {.handle = &hspi3, .type = HOST_PORT_SPI}};
+SPI_HandleTypeDef hspi4 = {.Instance = SPI4,
+                           .hdmatx = &hdma_spi4_tx,
+                           .hdmarx = &hdma_spi4_rx,
+                           .port = {.handle = &hspi4, .type = HOST_PORT_SPI}};
+SPI_HandleTypeDef hspi5 = {.Instance = SPI5, .port = {.handle = &hspi5, .type = HOST_PORT_SPI}};
+I2C_HandleTypeDef hi2c1 = {.Instance = I2C1, .port = {.handle = &hi2c1, .type = HOST_PORT_I2C}};
+I2C_HandleTypeDef hi2c2 = {.Instance = I2C2, .port = {.handle = &hi2c2, .type = HOST_PORT_I2C}};
+I2C_HandleTypeDef hi2c3 = {.Instance = I2C3, .port = {.handle = &hi2c3, .type = HOST_PORT_I2C}};
+I2C_HandleTypeDef hi2c4 = {.Instance = I2C4, .port = {.handle = &hi2c4, .type = HOST_PORT_I2C}};
+ADC_HandleTypeDef hadc1 = {.Instance = ADC1};
+ADC_HandleTypeDef hadc2 = {.Instance = ADC2};
+ADC_HandleTypeDef hadc3 = {.Instance = ADC3};
+DAC_HandleTypeDef hdac = {.Instance = DAC};
+CAN_HandleTypeDef hcan1 = {.Instance = CAN1,
+                           .Init = {.Prescaler = 16, .TimeSeg1 = CAN_BS1_2TQ, .TimeSeg2 = CAN_BS2_2TQ},
+                           .can = {.peer = &hcan2}};
+CAN_HandleTypeDef hcan2 = {.Instance = CAN2,
+                           .Init = {.Prescaler = 16, .TimeSeg1 = CAN_BS1_2TQ, .TimeSeg2 = CAN_BS2_2TQ},
+                           .can = {.peer = &hcan1}};
+
+/**
+ * \brief           peripherals wired together on the test board, each wire is a loopback of the host build
+ * \note            the spi4 slave is wired to the spi3 and spi5 masters, a port on two wires answers the port that
+ *                  started a transfer last
+ */
+static const host_wire_t host_wire_list[] = {
+
+    {&huart1.port, &huart2.port},
+    {&huart4.port, &huart5.port},
+    {&hspi1.port, &hspi2.port},
+    {&hi2c1.port, &hi2c2.port},
+    {&huart7.port, &huart8.port},
+    {&huart3.port, &huart6.port},
+    {&hspi3.port, &hspi4.port},
+    {&hspi5.port, &hspi4.port},
+    {&hi2c3.port, &hi2c4.port},
+};
+
+/**
+ * \brief           number of wires
+ * \hideinitializer
+ */
+#define HOST_WIRE_NUM (sizeof(host_wire_list) / sizeof(host_wire_list[0]))
+
+/**
+ * \brief           bytes of each flash sector of the stm32f746zg
+ */
+static const uint32_t host_flash_sector_size[HOST_FLASH_SECTOR_NUM] = {0x8000,  0x8000,  0x8000,  0x8000,
+                                                                       0x20000, 0x40000, 0x40000, 0x40000};
+
+/**
+ * \brief           flash model
+ */
+static host_flash_t host_flash = {.locked = 1};
+
+/**
+ * \brief           card unique id, HAL_GetUIDw0 to HAL_GetUIDw2
+ */
+static uint32_t host_uid[HOST_UID_SIZE];
+
+/**
+ * \brief           task running the hal callbacks, in place of the peripheral interrupts
+ */
+static TaskHandle_t host_isr_handle;
+
+/**
+ * \brief           bit time the can bus is free from, the frames of both cans go one after the other on it
+ */
+static uint64_t host_can_bus_end;
+
+/**
+ * \brief           copy of the data one end of a full duplex transfer sends, while the other end overwrites it
+ */
+static uint8_t host_exchange_buffer[UINT16_MAX];
+
+/**
+ * \brief           check a transmit and a receive make a transfer
+ * \param[in]       tx_op: host_op_t of the transmitting end
+ * \param[in]       rx_op: host_op_t of the receiving end
+ * \param[out]      return: 1 if the data moves, 0 otherwise
+ */
+static uint8_t
+host_op_match(uint8_t tx_op, uint8_t rx_op) {
+
+    return ((tx_op == HOST_OP_TRANSFER || tx_op == HOST_OP_CIRCULAR)
+            && (rx_op == HOST_OP_TRANSFER || rx_op == HOST_OP_CIRCULAR))
+           || (tx_op == HOST_OP_MASTER && rx_op == HOST_OP_SLAVE)
+           || (tx_op == HOST_OP_SLAVE && rx_op == HOST_OP_MASTER);
+}
+
+/**
+ * \brief           bytes a circular end moves before its next half transfer
+ * \param[in]       left: bytes left to the end of its buffer
+ * \param[in]       length: bytes of its buffer
+ * \param[out]      return: bytes to the half or the end of its buffer
+ */
+static uint16_t
+host_port_half(uint16_t left, uint16_t length) {
+
+    uint16_t second = length - length / 2; /* bytes of the second half of the buffer */
+
+    return left > second ? left - second : left;
+}
+
+/**
+ * \brief           move the data one end of a wire transmits into the buffer the other end receives in
+ * \note            called in a critical section. the transmit completes, bytes past the end of the receive buffer
+ *                  are lost. the receive completes once its buffer is full. with a circular end the data moves up
+ *                  to its next half transfer, and the circular end starts its buffer again once it completes
+ * \param[in]       tx: transmitting end
+ * \param[in]       rx: receiving end
+ */
+static void
+host_port_move(host_port_t* tx, host_port_t* rx) {
+
+    uint16_t size; /* bytes moved */
+    uint16_t sent; /* bytes the transmit sent */
+
+    if (!host_op_match(tx->tx_op, rx->rx_op)) {
+        return;
+    }
+
+    size = tx->tx_size < rx->rx_size ? tx->tx_size : rx->rx_size;
+    sent = tx->tx_size;
+
+    if (tx->tx_op == HOST_OP_CIRCULAR || rx->rx_op == HOST_OP_CIRCULAR) {
+
+        if (tx->tx_op == HOST_OP_CIRCULAR && host_port_half(tx->tx_size, tx->tx_length) < size) {
+            size = host_port_half(tx->tx_size, tx->tx_length);
+        }
+        if (rx->rx_op == HOST_OP_CIRCULAR && host_port_half(rx->rx_size, rx->rx_length) < size) {
+            size = host_port_half(rx->rx_size, rx->rx_length);
+        }
+        sent = size;
+    }
+
+    memmove(rx->rx_data, tx->tx_data, size);
+    rx->rx_data += size;
+    rx->rx_size -= size;
+    tx->tx_data += sent;
+    tx->tx_size -= sent;
+
+    if (tx->tx_size == 0) {
+
+        tx->tx_done_op = tx->tx_op;
+        tx->pending |= HOST_IRQ_TX_DONE;
+        if (tx->tx_op == HOST_OP_CIRCULAR) {
+            tx->tx_data = tx->tx_start;
+            tx->tx_size = tx->tx_length;
+        } else {
+            tx->tx_op = HOST_OP_NONE;
+        }
+    }
+
+    if (rx->rx_op == HOST_OP_CIRCULAR && rx->rx_size == rx->rx_length - rx->rx_length / 2) {
+        rx->pending |= HOST_IRQ_RX_HALF;
+    }
+    if (rx->rx_size == 0) {
+
+        rx->rx_done_op = rx->rx_op;
+        rx->pending |= HOST_IRQ_RX_DONE;
+        if (rx->rx_op == HOST_OP_CIRCULAR) {
+            rx->rx_data = rx->rx_start;
+            rx->rx_size = rx->rx_length;
+        } else {
+            rx->rx_op = HOST_OP_NONE;
+        }
+    }
+}
+
+/**
+ * \brief           check the data of a wire moves on the next pass of the host isr task
+ * \note            called in a critical section
+ * \param[in]       port: one end of the wire
+ * \param[out]      return: 1 if a transfer of the wire is ready to move or has interrupts pending, 0 otherwise
+ */
+static uint8_t
+host_port_busy(const host_port_t* port) {
+
+    const host_port_t* peer = port->peer; /* other end of the wire */
+
+    return host_op_match(port->tx_op, peer->rx_op) || host_op_match(peer->tx_op, port->rx_op)
+           || (port->tx_op == HOST_OP_EXCHANGE && peer->tx_op == HOST_OP_EXCHANGE)
+           || (port->pending & ~port->poll) != 0 || (peer->pending & ~peer->poll) != 0;
+}
+
+/**
+ * \brief           swap the data of a full duplex transfer, once both ends of the wire started it
+ * \note            called in a critical section
+ * \param[in]       port: one end of the wire
+ */
+static void
+host_port_exchange(host_port_t* port) {
+
+    host_port_t* peer = port->peer; /* other end of the wire */
+    uint16_t size;                  /* bytes each end sends */
+
+    if (port->tx_op != HOST_OP_EXCHANGE || peer->tx_op != HOST_OP_EXCHANGE) {
+        return;
+    }
+
+    size = port->tx_size < peer->tx_size ? port->tx_size : peer->tx_size;
+    memcpy(host_exchange_buffer, port->tx_data, size);
+    memmove(port->rx_data, peer->tx_data, size);
+    memcpy(peer->rx_data, host_exchange_buffer, size);
+
+    port->tx_op = port->rx_op = HOST_OP_NONE;
+    peer->tx_op = peer->rx_op = HOST_OP_NONE;
+    port->pending |= HOST_IRQ_TXRX_DONE;
+    peer->pending |= HOST_IRQ_TXRX_DONE;
+}
+
+/**
+ * \brief           start a transfer on one end of a wire, and move the data if the other end is ready for it
+ * \param[in]       port: end of the wire starting the transfer
+ * \param[in]       tx_data: data transmitted, NULL if the transfer does not transmit
+ * \param[in]       rx_data: receive buffer, NULL if the transfer does not receive
+ * \param[in]       size: bytes transmitted and received
+ * \param[in]       op: host_op_t of the transfer
+ * \param[out]      return: HAL_OK, HAL_BUSY if the direction is running a transfer, HAL_ERROR on bad arguments
+ */
+static HAL_StatusTypeDef
+host_port_start(host_port_t* port, const uint8_t* tx_data, uint8_t* rx_data, uint16_t size, uint8_t op) {
+
+    uint8_t pending; /* interrupts pending on the wire after the transfer started */
+
+    if (size == 0 || (tx_data == NULL && rx_data == NULL)) {
+        return HAL_ERROR;
+    }
+
+    taskENTER_CRITICAL();
+
+    /* a uart transmits and receives at once, a spi or i2c runs one transfer at a time */
+    if ((tx_data != NULL && port->tx_op != HOST_OP_NONE) || (rx_data != NULL && port->rx_op != HOST_OP_NONE)
+        || (port->type != HOST_PORT_UART && (port->tx_op != HOST_OP_NONE || port->rx_op != HOST_OP_NONE))) {
+
+        taskEXIT_CRITICAL();
+        return HAL_BUSY;
+    }
+
+    if (tx_data != NULL) {
+        port->tx_start = port->tx_data = tx_data;
+        port->tx_length = port->tx_size = size;
+        port->tx_op = op;
+    }
+    if (rx_data != NULL) {
+        port->rx_start = port->rx_data = rx_data;
+        port->rx_length = port->rx_size = size;
+        port->rx_op = op;
+    }
+
+    /* the other end of the wire answers this port, until a port on another of its wires starts */
+    port->peer->peer = port;
+
+    /* a transfer started by a callback moves on the next pass of the host isr task, so a stream re-arming its
+       transfers in the callbacks does not keep the host isr task running */
+    if (xTaskGetCurrentTaskHandle() == host_isr_handle) {
+
+        taskEXIT_CRITICAL();
+        return HAL_OK;
+    }
+
+    host_port_exchange(port);
+    host_port_move(port, port->peer);
+    host_port_move(port->peer, port);
+
+    pending = port->pending | port->peer->pending;
+
+    taskEXIT_CRITICAL();
+
+    /* raise the interrupts of the transfer */
+    if (pending != 0) {
+        xTaskNotifyGive(host_isr_handle);
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * \brief           run a transfer on one end of a wire and waite for it, like a blocking hal call
+ * \note            polls every tick, the other end of the wire may be started by an interrupt transfer
+ * \param[in]       port: end of the wire running the transfer
+ * \param[in]       tx_data: data transmitted, NULL if the transfer does not transmit
+ * \param[in]       rx_data: receive buffer, NULL if the transfer does not receive
+ * \param[in]       size: bytes transmitted and received
+ * \param[in]       op: host_op_t of the transfer
+ * \param[in]       timeout: longest wait in ms
+ * \param[out]      return: HAL_OK, HAL_TIMEOUT if the transfer did not finish in time, host_port_start errors
+ */
+static HAL_StatusTypeDef
+host_port_poll(host_port_t* port, const uint8_t* tx_data, uint8_t* rx_data, uint16_t size, uint8_t op,
+               uint32_t timeout) {
+
+    TickType_t start = xTaskGetTickCount(); /* tick the transfer started */
+    HAL_StatusTypeDef status;               /* transfer start return check */
+    uint8_t done;                           /* host_irq_t flag of the transfer completing */
+
+    if (tx_data != NULL && rx_data != NULL) {
+        done = HOST_IRQ_TXRX_DONE;
+    } else {
+        done = tx_data != NULL ? HOST_IRQ_TX_DONE : HOST_IRQ_RX_DONE;
+    }
+
+    taskENTER_CRITICAL();
+    port->poll = done;
+    taskEXIT_CRITICAL();
+
+    status = host_port_start(port, tx_data, rx_data, size, op);
+
+    while (status == HAL_OK) {
+
+        taskENTER_CRITICAL();
+        if (port->pending & done) {
+
+            port->pending &= ~done;
+            port->poll = 0;
+            taskEXIT_CRITICAL();
+            return HAL_OK;
+        }
+        taskEXIT_CRITICAL();
+
+        if (xTaskGetTickCount() - start >= pdMS_TO_TICKS(timeout)) {
+            status = HAL_TIMEOUT;
+            break;
+        }
+        vTaskDelay(1);
+    }
+
+    /* the blocking hal calls stop the transfer they time out on */
+    taskENTER_CRITICAL();
+    if (status == HAL_TIMEOUT) {
+        if (tx_data != NULL) {
+            port->tx_op = HOST_OP_NONE;
+        }
+        if (rx_data != NULL) {
+            port->rx_op = HOST_OP_NONE;
+        }
+    }
+    port->poll = 0;
+    taskEXIT_CRITICAL();
+
+    return status;
+}
+
+/**
+ * \brief           stop the transfers of one end of a wire, the abort complete callback follows
+ * \param[in]       port: end of the wire aborted
+ * \param[out]      return: HAL_OK
+ */
+static HAL_StatusTypeDef
+host_port_abort(host_port_t* port) {
+
+    taskENTER_CRITICAL();
+
+    port->tx_op = HOST_OP_NONE;
+    port->rx_op = HOST_OP_NONE;
+    port->pending |= HOST_IRQ_ABORT;
+
+    taskEXIT_CRITICAL();
+
+    xTaskNotifyGive(host_isr_handle);
+
+    return HAL_OK;
+}
+
+/**
+ * \brief           start a dma transfer on one end of a wire, a DMA_CIRCULAR dma stream runs it until stopped
+ * \param[in]       port: end of the wire starting the transfer
+ * \param[in]       tx_data: data transmitted, NULL if the transfer does not transmit
+ * \param[in]       rx_data: receive buffer, NULL if the transfer does not receive
+ * \param[in]       size: bytes transmitted or received
+ * \param[in]       hdma: dma stream of the direction, NULL if the peripheral has none
+ * \param[out]      return: host_port_start return
+ */
+static HAL_StatusTypeDef
+host_port_dma(host_port_t* port, const uint8_t* tx_data, uint8_t* rx_data, uint16_t size,
+              const DMA_HandleTypeDef* hdma) {
+
+    uint8_t op = hdma != NULL && hdma->Init.Mode == DMA_CIRCULAR ? HOST_OP_CIRCULAR : HOST_OP_TRANSFER;
+
+    return host_port_start(port, tx_data, rx_data, size, op);
+}
+
+/**
+ * \brief           stop the dma transfers of one end of a wire, no callback follows
+ * \param[in]       port: end of the wire stopped
+ * \param[out]      return: HAL_OK
+ */
+static HAL_StatusTypeDef
+host_port_stop(host_port_t* port) {
+
+    taskENTER_CRITICAL();
+
+    port->tx_op = HOST_OP_NONE;
+    port->rx_op = HOST_OP_NONE;
+
+    taskEXIT_CRITICAL();
+
+    return HAL_OK;
+}
+
+/**
+ * \brief           call the hal callbacks of the interrupts pending on a port
+ * \param[in]       port: port of the interrupts
+ * \param[in]       pending: host_irq_t flags
+ */
+static void
+host_port_irq(host_port_t* port, uint8_t pending) {
+
+    switch (port->type) {
+
+        case HOST_PORT_UART:
+
+            if (pending & HOST_IRQ_TX_DONE) {
+                HAL_UART_TxCpltCallback(port->handle);
+            }
+            if (pending & HOST_IRQ_RX_HALF) {
+                HAL_UART_RxHalfCpltCallback(port->handle);
+            }
+            if (pending & HOST_IRQ_RX_DONE) {
+                HAL_UART_RxCpltCallback(port->handle);
+            }
+            if (pending & HOST_IRQ_ABORT) {
+                HAL_UART_AbortCpltCallback(port->handle);
+            }
+            break;
+
+        case HOST_PORT_SPI:
+
+            if (pending & HOST_IRQ_TX_DONE) {
+                HAL_SPI_TxCpltCallback(port->handle);
+            }
+            if (pending & HOST_IRQ_RX_HALF) {
+                HAL_SPI_RxHalfCpltCallback(port->handle);
+            }
+            if (pending & HOST_IRQ_RX_DONE) {
+                HAL_SPI_RxCpltCallback(port->handle);
+            }
+            if (pending & HOST_IRQ_TXRX_DONE) {
+                HAL_SPI_TxRxCpltCallback(port->handle);
+            }
+            if (pending & HOST_IRQ_ABORT) {
+                HAL_SPI_AbortCpltCallback(port->handle);
+            }
+            break;
+
+        case HOST_PORT_I2C:
+
+            if (pending & HOST_IRQ_TX_DONE) {
+                if (port->tx_done_op == HOST_OP_MASTER) {
+                    HAL_I2C_MasterTxCpltCallback(port->handle);
+                } else {
+                    HAL_I2C_SlaveTxCpltCallback(port->handle);
+                }
+            }
+            if (pending & HOST_IRQ_RX_DONE) {
+                if (port->rx_done_op == HOST_OP_MASTER) {
+                    HAL_I2C_MasterRxCpltCallback(port->handle);
+                } else {
+                    HAL_I2C_SlaveRxCpltCallback(port->handle);
+                }
+            }
+            if (pending & HOST_IRQ_ABORT) {
+                HAL_I2C_AbortCpltCallback(port->handle);
+            }
+            break;
+
+        default: break;
+    }
+}
+
+/**
+ * \brief           run the flash procedure pending, and call its end of operation callbacks
+ * \note            an erase calls the callback with each sector erased, and with 0xFFFFFFFF after the last
+ */
+static void
+host_flash_irq(void) {
+
+    uint32_t offset; /* offset of the sector erased in the flash */
+
+    if (!host_flash.pending) {
+        return;
+    }
+    host_flash.pending = 0;
+
+    if (host_flash.procedure == HOST_FLASH_PROGRAM) {
+
+        host_flash.procedure = HOST_FLASH_NONE;
+        HAL_FLASH_EndOfOperationCallback(host_flash.address);
+        return;
+    }
+
+    while (host_flash.procedure == HOST_FLASH_ERASE) {
+
+        offset = 0;
+        for (uint32_t sector = 0; sector < host_flash.sector; sector++) {
+            offset += host_flash_sector_size[sector];
+        }
+        memset(host_flash.memory + offset, 0xFF, host_flash_sector_size[host_flash.sector]);
+
+        host_flash.sector_num--;
+        if (host_flash.sector_num == 0) {
+
+            host_flash.procedure = HOST_FLASH_NONE;
+            HAL_FLASH_EndOfOperationCallback(0xFFFFFFFF);
+        } else {
+
+            HAL_FLASH_EndOfOperationCallback(host_flash.sector);
+            host_flash.sector++;
+        }
+    }
+}
+
+/**
+ * \brief           bus bits per second of a can, from its bit timing
+ * \param[in]       hcan: can handle
+ * \param[out]      return: bits per second
+ */
+static uint32_t
+host_can_bitrate(const CAN_HandleTypeDef* hcan) {
+
+    uint32_t quanta; /* time quanta of a bit */
+
+    quanta = 1 + ((hcan->Init.TimeSeg1 >> CAN_BTR_TS1_Pos) + 1) + ((hcan->Init.TimeSeg2 >> CAN_BTR_TS2_Pos) + 1);
+
+    return HOST_PCLK1_HZ / (hcan->Init.Prescaler * quanta);
+}
+
+/**
+ * \brief           bits a frame takes on the bus, with the stuff bits its transmitter adds
+ * \note            the bits up to the crc are stuffed, the CAN_FRAME_TAIL_BITS after it are not
+ * \param[in]       frame: frame transmitted
+ * \param[out]      return: bits of the frame and the interframe space
+ */
+static uint32_t
+host_can_frame_bits(const host_can_frame_t* frame) {
+
+    uint64_t field = 0; /* frame bits up to the data, most significant first */
+    uint8_t field_num;  /* bits in field */
+    uint16_t crc = 0;   /* crc of the bits up to the crc */
+    uint32_t bits = 0;  /* bits counted */
+    uint8_t last = 2;   /* level of the last bit on the bus */
+    uint8_t run = 0;    /* bits of that level in a row */
+    uint8_t level;      /* level of the bit counted */
+    uint16_t total;     /* bits stuffed */
+
+    /* start of frame, id, rtr or srr and ide, reserved bits and dlc */
+    if (frame->ext) {
+        field = ((uint64_t)(frame->id >> 18) << 27) | (3ULL << 25) | ((uint64_t)(frame->id & 0x3FFFF) << 7);
+        field_num = 39;
+    } else {
+        field = (uint64_t)frame->id << 7;
+        field_num = 19;
+    }
+    field |= frame->dlc;
+
+    total = field_num + frame->dlc * 8 + 15;
+    for (uint16_t bit = 0; bit < total; bit++) {
+
+        if (bit < field_num) {
+            level = (field >> (field_num - 1 - bit)) & 1;
+        } else if (bit < field_num + frame->dlc * 8) {
+            level = (frame->data[(bit - field_num) / 8] >> (7 - (bit - field_num) % 8)) & 1;
+        } else {
+            level = (crc >> (14 - (bit - field_num - frame->dlc * 8))) & 1;
+        }
+
+        if (bit < field_num + frame->dlc * 8) {
+            crc = ((crc << 1) ^ ((level ^ (crc >> 14)) & 1 ? CAN_CRC_POLYNOMIAL : 0)) & 0x7FFF;
+        }
+
+        /* after CAN_STUFF_RUN equal bits a bit of the other level is stuffed, it begins the next run */
+        bits++;
+        run = level == last ? run + 1 : 1;
+        last = level;
+        if (run == CAN_STUFF_RUN) {
+            bits++;
+            last = !level;
+            run = 1;
+        }
+    }
+
+    return bits + CAN_FRAME_TAIL_BITS;
+}
+
+/**
+ * \brief           send the frames in the transmit mailboxes of a can on the bus, and call their callbacks
+ * \note            the mailbox with the lowest id goes first. a frame starts once the bus is free, and not before
+ *                  the host clock, so the frames queued together follow each other. the peer receives a frame
+ *                  once it is started with a filter enabled, a frame received into a full fifo is lost
+ * \param[in]       hcan: can transmitting
+ */
+static void
+host_can_irq(CAN_HandleTypeDef* hcan) {
+
+    CAN_HandleTypeDef* peer = hcan->can.peer; /* can at the other end of the bus */
+    host_can_frame_t frame;                   /* frame sent */
+    struct timespec now;                      /* host clock */
+    uint64_t start;                           /* bit time the frame starts */
+    uint8_t mailbox;                          /* mailbox of the frame */
+    uint8_t received;                         /* the peer received the frame */
+    uint32_t its;                             /* notifications of the can */
+    uint32_t peer_its;                        /* notifications of the peer */
+
+    for (;;) {
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        taskENTER_CRITICAL();
+
+        mailbox = HOST_CAN_MAILBOX_NUM;
+        for (uint8_t i = 0; i < HOST_CAN_MAILBOX_NUM; i++) {
+            if ((hcan->can.mailbox_used & (1U << i))
+                && (mailbox == HOST_CAN_MAILBOX_NUM || hcan->can.mailbox[i].id < hcan->can.mailbox[mailbox].id)) {
+                mailbox = i;
+            }
+        }
+        if (mailbox == HOST_CAN_MAILBOX_NUM) {
+            taskEXIT_CRITICAL();
+            return;
+        }
+
+        frame = hcan->can.mailbox[mailbox];
+        hcan->can.mailbox_used &= ~(1U << mailbox);
+
+        start = ((uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec) * host_can_bitrate(hcan) / 1000000000ULL;
+        if (start < host_can_bus_end) {
+            start = host_can_bus_end;
+        }
+        host_can_bus_end = start + host_can_frame_bits(&frame);
+
+        received = peer->can.started && peer->can.filtered && peer->can.fifo_num < HOST_CAN_FIFO_SIZE;
+        if (received) {
+            frame.timestamp = start & 0xFFFF;
+            peer->can.fifo[(peer->can.fifo_first + peer->can.fifo_num) % HOST_CAN_FIFO_SIZE] = frame;
+            peer->can.fifo_num++;
+        }
+        its = hcan->can.its;
+        peer_its = peer->can.its;
+
+        taskEXIT_CRITICAL();
+
+        if (its & CAN_IT_TX_MAILBOX_EMPTY) {
+            switch (mailbox) {
+                case 0: HAL_CAN_TxMailbox0CompleteCallback(hcan); break;
+                case 1: HAL_CAN_TxMailbox1CompleteCallback(hcan); break;
+                default: HAL_CAN_TxMailbox2CompleteCallback(hcan); break;
+            }
+        }
+        if (received && (peer_its & CAN_IT_RX_FIFO0_MSG_PENDING)) {
+            HAL_CAN_RxFifo0MsgPendingCallback(peer);
+        }
+    }
+}
+
+/**
+ * \brief           host isr task, calls the hal callbacks of the pending interrupts, like the peripheral interrupts
+ *                  on the board
+ * \note            the callbacks run in a task, the FromISR freertos calls they make are valid from a task too.
+ *                  each pass moves the transfers ready on each wire, half a circular buffer at a time. while a wire
+ *                  has data to move the next pass runs a tick later, the lower priority tasks run in between
+ * \param[in]       arg: NULL
+ */
+static void
+host_isr_task(void* arg) {
+
+    uint8_t pending;  /* interrupts pending on a port */
+    uint8_t busy = 0; /* a wire has data to move or interrupts pending */
+
+    (void)arg;
+
+    for (;;) {
+
+        ulTaskNotifyTake(pdTRUE, busy ? 1 : portMAX_DELAY);
+        busy = 0;
+
+        for (uint8_t wire = 0; wire < HOST_WIRE_NUM; wire++) {
+
+            host_port_t* const end_list[] = {host_wire_list[wire].port_a, host_wire_list[wire].port_b};
+
+            /* the transfers started by the callbacks and the next half of the circular transfers. a port on two
+               wires moves on the wire of the port it answers */
+            taskENTER_CRITICAL();
+            if (end_list[0]->peer == end_list[1] && end_list[1]->peer == end_list[0]) {
+
+                host_port_exchange(end_list[0]);
+                host_port_move(end_list[0], end_list[1]);
+                host_port_move(end_list[1], end_list[0]);
+            }
+            taskEXIT_CRITICAL();
+
+            for (uint8_t end = 0; end < 2; end++) {
+
+                /* a blocking hal call takes its own completion */
+                taskENTER_CRITICAL();
+                pending = end_list[end]->pending & ~end_list[end]->poll;
+                end_list[end]->pending &= end_list[end]->poll;
+                taskEXIT_CRITICAL();
+
+                if (pending != 0) {
+                    host_port_irq(end_list[end], pending);
+                }
+            }
+        }
+
+        /* the callbacks may start transfers on any wire */
+        taskENTER_CRITICAL();
+        for (uint8_t wire = 0; wire < HOST_WIRE_NUM; wire++) {
+            busy |= host_wire_list[wire].port_a->peer == host_wire_list[wire].port_b
+                    && host_wire_list[wire].port_b->peer == host_wire_list[wire].port_a
+                    && host_port_busy(host_wire_list[wire].port_a);
+        }
+        taskEXIT_CRITICAL();
+
+        host_can_irq(&hcan1);
+        host_can_irq(&hcan2);
+        host_flash_irq();
+    }
+}
+
+/**
+ * \brief           wire the loopback ports, map the flash and create the host isr task. called before the
+ *                  scheduler starts
+ * \param[in]       uid: HOST_UID_SIZE words of the card unique id
+ * \param[out]      return: host_error_t
+ */
+uint8_t
+host_hal_init(const uint32_t* uid) {
+
+    void* memory; /* flash mapping */
+
+    memcpy(host_uid, uid, sizeof(host_uid));
+
+    for (uint8_t wire = 0; wire < HOST_WIRE_NUM; wire++) {
+
+        host_wire_list[wire].port_a->peer = host_wire_list[wire].port_b;
+        host_wire_list[wire].port_b->peer = host_wire_list[wire].port_a;
+    }
+
+    /* the flash is erased when the card leaves the factory */
+    memory = mmap((void*)FLASH_BASE, HOST_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return HOST_FLASH_MAP_FAILED;
+    }
+    if (memory != (void*)FLASH_BASE) {
+        munmap(memory, HOST_FLASH_SIZE);
+        return HOST_FLASH_MAP_FAILED;
+    }
+    host_flash.memory = memory;
+    memset(host_flash.memory, 0xFF, HOST_FLASH_SIZE);
+
+    if (xTaskCreate(host_isr_task, "host_isr", HOST_ISR_TASK_STACK_SIZE, NULL, configMAX_PRIORITIES - 1,
+                    &host_isr_handle)
+        != pdPASS) {
+        return HOST_TASK_CREATE_FAILED;
+    }
+
+    return HOST_OK;
+}
+
+/* uart */
+
+HAL_StatusTypeDef
+HAL_UART_Transmit(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size, uint32_t Timeout) {
+
+    return host_port_poll(&huart->port, pData, NULL, Size, HOST_OP_TRANSFER, Timeout);
+}
+
+HAL_StatusTypeDef
+HAL_UART_Receive(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size, uint32_t Timeout) {
+
+    return host_port_poll(&huart->port, NULL, pData, Size, HOST_OP_TRANSFER, Timeout);
+}
+
+HAL_StatusTypeDef
+HAL_UART_Transmit_IT(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size) {
+
+    return host_port_start(&huart->port, pData, NULL, Size, HOST_OP_TRANSFER);
+}
+
+HAL_StatusTypeDef
+HAL_UART_Receive_IT(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size) {
+
+    return host_port_start(&huart->port, NULL, pData, Size, HOST_OP_TRANSFER);
+}
+
+HAL_StatusTypeDef
+HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart, const uint8_t* pData, uint16_t Size) {
+
+    return host_port_dma(&huart->port, pData, NULL, Size, huart->hdmatx);
+}
+
+HAL_StatusTypeDef
+HAL_UART_Receive_DMA(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size) {
+
+    return host_port_dma(&huart->port, NULL, pData, Size, huart->hdmarx);
+}
+
+HAL_StatusTypeDef
+HAL_UART_DMAStop(UART_HandleTypeDef* huart) {
+
+    return host_port_stop(&huart->port);
+}
+
+HAL_StatusTypeDef
+HAL_UART_Abort_IT(UART_HandleTypeDef* huart) {
+
+    return host_port_abort(&huart->port);
+}
+
+__weak void
+HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart) {
+
+    (void)huart;
+}
+
+__weak void
+HAL_UART_RxCpltCallback(UART_HandleTypeDef* huart) {
+
+    (void)huart;
+}
+
+__weak void
+HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef* huart) {
+
+    (void)huart;
+}
+
+__weak void
+HAL_UART_ErrorCallback(UART_HandleTypeDef* huart) {
+
+    (void)huart;
+}
+
+__weak void
+HAL_UART_AbortCpltCallback(UART_HandleTypeDef* huart) {
+
+    (void)huart;
+}
+
+/* spi */
+
+HAL_StatusTypeDef
+HAL_SPI_Transmit(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, uint32_t Timeout) {
+
+    return host_port_poll(&hspi->port, pData, NULL, Size, HOST_OP_TRANSFER, Timeout);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_Receive(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, uint32_t Timeout) {
+
+    return host_port_poll(&hspi->port, NULL, pData, Size, HOST_OP_TRANSFER, Timeout);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_TransmitReceive(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size, uint32_t Timeout) {
+
+    if (pTxData == NULL || pRxData == NULL) {
+        return HAL_ERROR;
+    }
+
+    return host_port_poll(&hspi->port, pTxData, pRxData, Size, HOST_OP_EXCHANGE, Timeout);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_Transmit_IT(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size) {
+
+    return host_port_start(&hspi->port, pData, NULL, Size, HOST_OP_TRANSFER);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_Receive_IT(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size) {
+
+    return host_port_start(&hspi->port, NULL, pData, Size, HOST_OP_TRANSFER);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_TransmitReceive_IT(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size) {
+
+    if (pTxData == NULL || pRxData == NULL) {
+        return HAL_ERROR;
+    }
+
+    return host_port_start(&hspi->port, pTxData, pRxData, Size, HOST_OP_EXCHANGE);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size) {
+
+    return host_port_dma(&hspi->port, pData, NULL, Size, hspi->hdmatx);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_Receive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size) {
+
+    return host_port_dma(&hspi->port, NULL, pData, Size, hspi->hdmarx);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size) {
+
+    return HAL_SPI_TransmitReceive_IT(hspi, pTxData, pRxData, Size);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_DMAStop(SPI_HandleTypeDef* hspi) {
+
+    return host_port_stop(&hspi->port);
+}
+
+HAL_StatusTypeDef
+HAL_SPI_Abort_IT(SPI_HandleTypeDef* hspi) {
+
+    return host_port_abort(&hspi->port);
+}
+
+__weak void
+HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    (void)hspi;
+}
+
+__weak void
+HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    (void)hspi;
+}
+
+__weak void
+HAL_SPI_RxHalfCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    (void)hspi;
+}
+
+__weak void
+HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    (void)hspi;
+}
+
+__weak void
+HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi) {
+
+    (void)hspi;
+}
+
+__weak void
+HAL_SPI_AbortCpltCallback(SPI_HandleTypeDef* hspi) {
+
+    (void)hspi;
+}
+
+/* i2c, the device address is not checked, each wire has one slave */
+
+HAL_StatusTypeDef
+HAL_I2C_Master_Receive(I2C_HandleTypeDef* hi2c, uint16_t DevAddress, uint8_t* pData, uint16_t Size, uint32_t Timeout) {
+
+    (void)DevAddress;
+    return host_port_poll(&hi2c->port, NULL, pData, Size, HOST_OP_MASTER, Timeout);
+}
+
+HAL_StatusTypeDef
+HAL_I2C_Slave_Transmit(I2C_HandleTypeDef* hi2c, uint8_t* pData, uint16_t Size, uint32_t Timeout) {
+
+    return host_port_poll(&hi2c->port, pData, NULL, Size, HOST_OP_SLAVE, Timeout);
+}
+
+HAL_StatusTypeDef
+HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef* hi2c, uint16_t DevAddress, uint8_t* pData, uint16_t Size) {
+
+    (void)DevAddress;
+    return host_port_start(&hi2c->port, pData, NULL, Size, HOST_OP_MASTER);
+}
+
+HAL_StatusTypeDef
+HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef* hi2c, uint16_t DevAddress, uint8_t* pData, uint16_t Size) {
+
+    (void)DevAddress;
+    return host_port_start(&hi2c->port, NULL, pData, Size, HOST_OP_MASTER);
+}
+
+HAL_StatusTypeDef
+HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef* hi2c, uint16_t DevAddress, uint8_t* pData, uint16_t Size) {
+
+    (void)DevAddress;
+    return host_port_start(&hi2c->port, NULL, pData, Size, HOST_OP_MASTER);
+}
+
+HAL_StatusTypeDef
+HAL_I2C_Slave_Transmit_IT(I2C_HandleTypeDef* hi2c, uint8_t* pData, uint16_t Size) {
+
+    return host_port_start(&hi2c->port, pData, NULL, Size, HOST_OP_SLAVE);
+}
+
+HAL_StatusTypeDef
+HAL_I2C_Slave_Transmit_DMA(I2C_HandleTypeDef* hi2c, uint8_t* pData, uint16_t Size) {
+
+    return host_port_start(&hi2c->port, pData, NULL, Size, HOST_OP_SLAVE);
+}
+
+HAL_StatusTypeDef
+HAL_I2C_Slave_Receive_IT(I2C_HandleTypeDef* hi2c, uint8_t* pData, uint16_t Size) {
+
+    return host_port_start(&hi2c->port, NULL, pData, Size, HOST_OP_SLAVE);
+}
+
+HAL_StatusTypeDef
+HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef* hi2c, uint16_t DevAddress) {
+
+    (void)DevAddress;
+    return host_port_abort(&hi2c->port);
+}
+
+__weak void
+HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef* hi2c) {
+
+    (void)hi2c;
+}
+
+__weak void
+HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef* hi2c) {
+
+    (void)hi2c;
+}
+
+__weak void
+HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef* hi2c) {
+
+    (void)hi2c;
+}
+
+__weak void
+HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef* hi2c) {
+
+    (void)hi2c;
+}
+
+__weak void
+HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c) {
+
+    (void)hi2c;
+}
+
+__weak void
+HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef* hi2c) {
+
+    (void)hi2c;
+}
+
+/* dma */
+
+HAL_StatusTypeDef
+HAL_DMA_Init(DMA_HandleTypeDef* hdma) {
+
+    return hdma == NULL ? HAL_ERROR : HAL_OK;
+}
+
+/* dac and adc, the adc input is wired to dac channel 1 */
+
+HAL_StatusTypeDef
+HAL_DAC_Start(DAC_HandleTypeDef* hdac, uint32_t Channel) {
+
+    hdac->started[Channel == DAC_CHANNEL_2] = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_DAC_Stop(DAC_HandleTypeDef* hdac, uint32_t Channel) {
+
+    hdac->started[Channel == DAC_CHANNEL_2] = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_DAC_SetValue(DAC_HandleTypeDef* hdac, uint32_t Channel, uint32_t Alignment, uint32_t Data) {
+
+    uint32_t code; /* 12 bit code of the output */
+
+    switch (Alignment) {
+
+        case DAC_ALIGN_12B_R: code = Data & 0xFFF; break;
+
+        case DAC_ALIGN_12B_L: code = (Data >> 4) & 0xFFF; break;
+
+        case DAC_ALIGN_8B_R: code = (Data & 0xFF) << 4; break;
+
+        default: return HAL_ERROR;
+    }
+
+    hdac->code[Channel == DAC_CHANNEL_2] = code;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_ADC_Start(ADC_HandleTypeDef* hadc) {
+
+    /* a single conversion, it finishes at once */
+    hadc->started = 1;
+    hadc->converted = 1;
+    hadc->value = hdac.started[0] ? hdac.code[0] : 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_ADC_Stop(ADC_HandleTypeDef* hadc) {
+
+    hadc->started = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc, uint32_t Timeout) {
+
+    (void)Timeout;
+
+    if (!hadc->started) {
+        return HAL_ERROR;
+    }
+    if (!hadc->converted) {
+        return HAL_TIMEOUT;
+    }
+    return HAL_OK;
+}
+
+uint32_t
+HAL_ADC_GetValue(ADC_HandleTypeDef* hadc) {
+
+    /* reading the data register clears the end of conversion */
+    hadc->converted = 0;
+    return hadc->value;
+}
+
+/* can, can1 and can2 are wired to one bus */
+
+HAL_StatusTypeDef
+HAL_CAN_Init(CAN_HandleTypeDef* hcan) {
+
+    taskENTER_CRITICAL();
+    hcan->can.started = 0;
+    hcan->can.mailbox_used = 0;
+    hcan->can.fifo_num = 0;
+    hcan->ErrorCode = 0;
+    taskEXIT_CRITICAL();
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_CAN_ConfigFilter(CAN_HandleTypeDef* hcan, const CAN_FilterTypeDef* sFilterConfig) {
+
+    if (sFilterConfig->FilterFIFOAssignment != CAN_FILTER_FIFO0) {
+        return HAL_ERROR;
+    }
+    hcan->can.filtered = sFilterConfig->FilterActivation == CAN_FILTER_ENABLE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_CAN_Start(CAN_HandleTypeDef* hcan) {
+
+    hcan->can.started = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_CAN_ActivateNotification(CAN_HandleTypeDef* hcan, uint32_t ActiveITs) {
+
+    taskENTER_CRITICAL();
+    hcan->can.its |= ActiveITs;
+    taskEXIT_CRITICAL();
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_CAN_AddTxMessage(CAN_HandleTypeDef* hcan, const CAN_TxHeaderTypeDef* pHeader, const uint8_t aData[],
+                     uint32_t* pTxMailbox) {
+
+    host_can_frame_t* frame; /* mailbox filled */
+    uint8_t mailbox;         /* free mailbox */
+
+    if (!hcan->can.started || pHeader->DLC > HOST_CAN_DATA_SIZE) {
+        return HAL_ERROR;
+    }
+
+    taskENTER_CRITICAL();
+
+    for (mailbox = 0; mailbox < HOST_CAN_MAILBOX_NUM && (hcan->can.mailbox_used & (1U << mailbox)); mailbox++) {}
+    if (mailbox == HOST_CAN_MAILBOX_NUM) {
+        taskEXIT_CRITICAL();
+        return HAL_ERROR;
+    }
+
+    frame = &hcan->can.mailbox[mailbox];
+    frame->ext = pHeader->IDE == CAN_ID_EXT;
+    frame->id = frame->ext ? pHeader->ExtId & 0x1FFFFFFF : pHeader->StdId & 0x7FF;
+    frame->dlc = pHeader->RTR == CAN_RTR_DATA ? pHeader->DLC : 0;
+    memcpy(frame->data, aData, frame->dlc);
+    hcan->can.mailbox_used |= 1U << mailbox;
+    *pTxMailbox = 1U << mailbox;
+
+    taskEXIT_CRITICAL();
+
+    xTaskNotifyGive(host_isr_handle);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_CAN_AbortTxRequest(CAN_HandleTypeDef* hcan, uint32_t TxMailboxes) {
+
+    taskENTER_CRITICAL();
+    hcan->can.mailbox_used &= ~TxMailboxes;
+    taskEXIT_CRITICAL();
+
+    return HAL_OK;
+}
+
+uint32_t
+HAL_CAN_GetTxMailboxesFreeLevel(const CAN_HandleTypeDef* hcan) {
+
+    uint32_t free_level = 0; /* mailboxes free */
+
+    for (uint8_t mailbox = 0; mailbox < HOST_CAN_MAILBOX_NUM; mailbox++) {
+        free_level += !(hcan->can.mailbox_used & (1U << mailbox));
+    }
+    return free_level;
+}
+
+HAL_StatusTypeDef
+HAL_CAN_GetRxMessage(CAN_HandleTypeDef* hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef* pHeader, uint8_t aData[]) {
+
+    host_can_frame_t frame; /* oldest frame of the fifo */
+
+    taskENTER_CRITICAL();
+
+    if (RxFifo != CAN_RX_FIFO0 || hcan->can.fifo_num == 0) {
+        taskEXIT_CRITICAL();
+        return HAL_ERROR;
+    }
+    frame = hcan->can.fifo[hcan->can.fifo_first];
+    hcan->can.fifo_first = (hcan->can.fifo_first + 1) % HOST_CAN_FIFO_SIZE;
+    hcan->can.fifo_num--;
+
+    taskEXIT_CRITICAL();
+
+    pHeader->IDE = frame.ext ? CAN_ID_EXT : CAN_ID_STD;
+    pHeader->StdId = frame.ext ? 0 : frame.id;
+    pHeader->ExtId = frame.ext ? frame.id : 0;
+    pHeader->RTR = CAN_RTR_DATA;
+    pHeader->DLC = frame.dlc;
+    pHeader->Timestamp = hcan->Init.TimeTriggeredMode == ENABLE ? frame.timestamp : 0;
+    pHeader->FilterMatchIndex = 0;
+    memcpy(aData, frame.data, frame.dlc);
+
+    return HAL_OK;
+}
+
+uint32_t
+HAL_CAN_GetRxFifoFillLevel(const CAN_HandleTypeDef* hcan, uint32_t RxFifo) {
+
+    return RxFifo == CAN_RX_FIFO0 ? hcan->can.fifo_num : 0;
+}
+
+HAL_StatusTypeDef
+HAL_CAN_ResetError(CAN_HandleTypeDef* hcan) {
+
+    hcan->ErrorCode = 0;
+    return HAL_OK;
+}
+
+__weak void
+HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef* hcan) {
+
+    (void)hcan;
+}
+
+__weak void
+HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef* hcan) {
+
+    (void)hcan;
+}
+
+__weak void
+HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef* hcan) {
+
+    (void)hcan;
+}
+
+__weak void
+HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan) {
+
+    (void)hcan;
+}
+
+__weak void
+HAL_CAN_ErrorCallback(CAN_HandleTypeDef* hcan) {
+
+    (void)hcan;
+}
+
+/* flash */
+
+HAL_StatusTypeDef
+HAL_FLASH_Unlock(void) {
+
+    host_flash.locked = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_FLASH_Lock(void) {
+
+    host_flash.locked = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef* pEraseInit) {
+
+    if (host_flash.locked) {
+        return HAL_ERROR;
+    }
+    if (host_flash.procedure != HOST_FLASH_NONE) {
+        return HAL_BUSY;
+    }
+
+    if (pEraseInit->TypeErase == FLASH_TYPEERASE_MASSERASE) {
+
+        host_flash.sector = FLASH_SECTOR_0;
+        host_flash.sector_num = HOST_FLASH_SECTOR_NUM;
+    } else {
+
+        if (pEraseInit->NbSectors == 0 || pEraseInit->Sector >= HOST_FLASH_SECTOR_NUM
+            || pEraseInit->NbSectors > HOST_FLASH_SECTOR_NUM - pEraseInit->Sector) {
+            return HAL_ERROR;
+        }
+        host_flash.sector = pEraseInit->Sector;
+        host_flash.sector_num = pEraseInit->NbSectors;
+    }
+
+    host_flash.procedure = HOST_FLASH_ERASE;
+    host_flash.pending = 1;
+    xTaskNotifyGive(host_isr_handle);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_FLASH_Program_IT(uint32_t TypeProgram, uint32_t Address, uint64_t Data) {
+
+    uint8_t size; /* bytes programmed */
+
+    if (host_flash.locked || TypeProgram > FLASH_TYPEPROGRAM_DOUBLEWORD) {
+        return HAL_ERROR;
+    }
+    if (host_flash.procedure != HOST_FLASH_NONE) {
+        return HAL_BUSY;
+    }
+
+    size = (uint8_t)(1 << TypeProgram);
+    if (Address < FLASH_BASE || Address - FLASH_BASE > HOST_FLASH_SIZE - size || Address % size != 0) {
+        return HAL_ERROR;
+    }
+
+    /* programming clears the bits that are 0 in the data, little endian like the cortex-m7 */
+    for (uint8_t i = 0; i < size; i++) {
+        host_flash.memory[Address - FLASH_BASE + i] &= (uint8_t)(Data >> (8 * i));
+    }
+
+    host_flash.procedure = HOST_FLASH_PROGRAM;
+    host_flash.address = Address;
+    host_flash.pending = 1;
+    xTaskNotifyGive(host_isr_handle);
+
+    return HAL_OK;
+}
+
+__weak void
+HAL_FLASH_EndOfOperationCallback(uint32_t ReturnValue) {
+
+    (void)ReturnValue;
+}
+
+__weak void
+HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue) {
+
+    (void)ReturnValue;
+}
+
+/* system */
+
+uint32_t
+HAL_RCC_GetPCLK1Freq(void) {
+
+    return HOST_PCLK1_HZ;
+}
+
+uint32_t
+HAL_GetUIDw0(void) {
+
+    return host_uid[0];
+}
+
+uint32_t
+HAL_GetUIDw1(void) {
+
+    return host_uid[1];
+}
+
+uint32_t
+HAL_GetUIDw2(void) {
+
+    return host_uid[2];
+}
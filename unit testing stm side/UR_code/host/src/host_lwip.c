@@ -0,0 +1,72 @@
+/**
+ * \file            host_lwip.c
+ * \brief           host build stand in of the cube generated lwip.c src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include "lwip.h"
+#include "host_hal.h"
+#include "host_netif.h"
+#include "lwip/init.h"
+
+/**
+ * \brief           network interface of the card
+ */
+struct netif gnetif;
+
+/**
+ * \brief           start lwip and add the host netif, with the addresses the board gets from MX_LWIP_Init.
+ *                  the card ip address is set from the command line, the gateway is .1 of its /24 network
+ */
+void
+MX_LWIP_Init(void) {
+
+    ip4_addr_t ipaddr;  /* card ip address */
+    ip4_addr_t netmask; /* card network mask */
+    ip4_addr_t gw;      /* gateway, the pc side of the tap */
+
+    /* Initilialize the LwIP stack with RTOS */
+    tcpip_init(NULL, NULL);
+
+    IP4_ADDR(&ipaddr, host_netif_setting.ip[0], host_netif_setting.ip[1], host_netif_setting.ip[2],
+             host_netif_setting.ip[3]);
+    IP4_ADDR(&netmask, 255, 255, 255, 0);
+    IP4_ADDR(&gw, host_netif_setting.ip[0], host_netif_setting.ip[1], host_netif_setting.ip[2], 1);
+
+    /* add the network interface with RTOS, the board can not run without it */
+    if (netif_add(&gnetif, &ipaddr, &netmask, &gw, NULL, &host_netif_init, &tcpip_input) == NULL) {
+
+        printf("host netif was not added\n");
+        exit(HOST_TAP_OPEN_FAILED);
+    }
+
+    netif_set_default(&gnetif);
+    netif_set_up(&gnetif);
+}
@@ -0,0 +1,124 @@
+/**
+ * \file            host_main.c
+ * \brief           host build of the card firmware, runs UR_code on the freertos posix port src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include "main_ur.h"
+#include "host_netif.h"
+#include "host_tap.h"
+
+/**
+ * \brief           print the command line options
+ * \param[in]       name: program name
+ */
+static void
+host_print_usage(const char* name) {
+
+    printf("usage: %s [-i tap] [-a card ip] [-u uid0:uid1:uid2]\n"
+           "  -i  tap interface the card answers on, default " HOST_TAP_NAME "\n"
+           "  -a  card ip address, default 192.168.8.2. the pc side of the tap gets .1 of its /24 network\n"
+           "  -u  card unique id words, default the words of \"HOST\"\n",
+           name);
+}
+
+/**
+ * \brief           host firmware main function. opens the tap, starts the hal models and runs the firmware
+ *                  ur_main, that does not return
+ * \param[in]       argc: argument count
+ * \param[in]       argv: argument vector
+ * \param[out]      return: host_error_t
+ */
+int
+main(int argc, char* argv[]) {
+
+    uint32_t uid[HOST_UID_SIZE] = {0x54534F48, 0, 0}; /* card unique id */
+    uint8_t pc_ip[4];                                 /* pc side of the tap */
+    uint8_t check;                                    /* return error check */
+    int option;                                       /* current command line option */
+
+    while ((option = getopt(argc, argv, "i:a:u:h")) != -1) {
+
+        switch (option) {
+
+            case 'i':
+                if (strlen(optarg) >= sizeof(host_netif_setting.tap_name)) {
+                    host_print_usage(argv[0]);
+                    return HOST_BAD_ARGUMENT;
+                }
+                strcpy(host_netif_setting.tap_name, optarg);
+                break;
+
+            case 'a':
+                if (sscanf(optarg, "%" SCNu8 ".%" SCNu8 ".%" SCNu8 ".%" SCNu8, &host_netif_setting.ip[0],
+                           &host_netif_setting.ip[1], &host_netif_setting.ip[2], &host_netif_setting.ip[3])
+                    != 4) {
+                    host_print_usage(argv[0]);
+                    return HOST_BAD_ARGUMENT;
+                }
+                break;
+
+            case 'u':
+                if (sscanf(optarg, "%" SCNu32 ":%" SCNu32 ":%" SCNu32, &uid[0], &uid[1], &uid[2]) != HOST_UID_SIZE) {
+                    host_print_usage(argv[0]);
+                    return HOST_BAD_ARGUMENT;
+                }
+                break;
+
+            default: host_print_usage(argv[0]); return option == 'h' ? HOST_OK : HOST_BAD_ARGUMENT;
+        }
+    }
+
+    memcpy(pc_ip, host_netif_setting.ip, sizeof(pc_ip));
+    pc_ip[3] = 1;
+
+    host_netif_setting.tap_fd = host_tap_open(host_netif_setting.tap_name, pc_ip);
+    if (host_netif_setting.tap_fd < 0) {
+        return HOST_TAP_OPEN_FAILED;
+    }
+
+    check = host_hal_init(uid);
+    if (check != HOST_OK) {
+        printf("host hal init failed %u\n", (unsigned int)check);
+        return check;
+    }
+
+    printf("host card UID %" PRIu32 "  ::  %" PRIu32 "  ::  %" PRIu32 " on %s, card %u.%u.%u.%u pc %u.%u.%u.%u\n",
+           uid[0], uid[1], uid[2], host_netif_setting.tap_name, host_netif_setting.ip[0], host_netif_setting.ip[1],
+           host_netif_setting.ip[2], host_netif_setting.ip[3], pc_ip[0], pc_ip[1], pc_ip[2], pc_ip[3]);
+    fflush(stdout);
+
+    /* creates the firmware tasks and starts the scheduler */
+    ur_main();
+
+    return HOST_OK;
+}
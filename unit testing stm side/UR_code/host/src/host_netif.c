@@ -0,0 +1,135 @@
+/**
+ * \file            host_netif.c
+ * \brief           lwip network interface of the host build on a tap interface src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include "host_netif.h"
+#include "main_ur.h"
+#include "host_tap.h"
+#include "netif/ethernet.h"
+
+/**
+ * \brief           network settings of the host firmware
+ */
+host_netif_setting_t host_netif_setting = {.tap_name = HOST_TAP_NAME, .ip = {192, 168, 8, 2}, .tap_fd = -1};
+
+/**
+ * \brief           write a frame lwip sends to the tap
+ * \param[in]       netif: host netif
+ * \param[in]       p: frame, a pbuf chain
+ * \param[out]      return: ERR_OK, ERR_IF if the frame was not written
+ */
+static err_t
+host_netif_output(struct netif* netif, struct pbuf* p) {
+
+    uint8_t frame[HOST_FRAME_SIZE]; /* frame copied out of the pbuf chain, the firmware sends from several tasks */
+    u16_t len;                      /* bytes of the frame */
+
+    (void)netif;
+
+    len = pbuf_copy_partial(p, frame, sizeof(frame), 0);
+    if (host_tap_write(host_netif_setting.tap_fd, frame, len) != len) {
+        return ERR_IF;
+    }
+
+    return ERR_OK;
+}
+
+/**
+ * \brief           netif input task, hands the frames read from the tap to the tcpip thread
+ * \note            waits for frames in poll, as the board ethernet input task waits for the receive interrupt.
+ *                  it runs at the idle priority, the tick preempts it for the tasks the waiting made ready
+ * \param[in]       arg: host netif
+ */
+static void
+host_netif_input_task(void* arg) {
+
+    struct netif* netif = arg;      /* host netif */
+    uint8_t frame[HOST_FRAME_SIZE]; /* frame read */
+    struct pbuf* p;                 /* frame handed to lwip */
+    int len;                        /* bytes of the frame */
+
+    for (;;) {
+
+        if (host_tap_wait(host_netif_setting.tap_fd, HOST_NETIF_POLL_MS) <= 0) {
+            continue;
+        }
+
+        len = host_tap_read(host_netif_setting.tap_fd, frame, sizeof(frame));
+        if (len <= 0) {
+            continue;
+        }
+
+        /* the frame is dropped when the pool is empty, like the board drops it when its rx buffers are full */
+        p = pbuf_alloc(PBUF_RAW, (u16_t)len, PBUF_POOL);
+        if (p == NULL) {
+            continue;
+        }
+        pbuf_take(p, frame, (u16_t)len);
+
+        if (netif->input(p, netif) != ERR_OK) {
+            pbuf_free(p);
+        }
+    }
+}
+
+/**
+ * \brief           initialize the host netif, called by netif_add. the tap is opened by the host main
+ * \param[in]       netif: host netif
+ * \param[out]      return: ERR_OK, ERR_IF if the tap is not open, ERR_MEM if the input task was not created
+ */
+err_t
+host_netif_init(struct netif* netif) {
+
+    if (host_netif_setting.tap_fd < 0) {
+        return ERR_IF;
+    }
+
+    netif->name[0] = 'u';
+    netif->name[1] = 'r';
+    netif->output = etharp_output;
+    netif->linkoutput = host_netif_output;
+    netif->mtu = 1500;
+    netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+    /* locally administered mac address, made of the card ip address */
+    netif->hwaddr_len = ETH_HWADDR_LEN;
+    netif->hwaddr[0] = 0x02;
+    netif->hwaddr[1] = 0x00;
+    memcpy(&netif->hwaddr[2], host_netif_setting.ip, sizeof(host_netif_setting.ip));
+
+    if (xTaskCreate(host_netif_input_task, "host_netif", HOST_NETIF_TASK_STACK_SIZE, netif, tskIDLE_PRIORITY, NULL)
+        != pdPASS) {
+        return ERR_MEM;
+    }
+
+    return ERR_OK;
+}
@@ -0,0 +1,347 @@
+/**
+ * \file            host_sys_arch.c
+ * \brief           lwip operating system layer of the host build src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include "lwip/sys.h"
+#include "lwip/stats.h"
+#include "task.h"
+
+/**
+ * \brief           mutex of sys_arch_protect
+ */
+static SemaphoreHandle_t host_sys_mutex;
+
+/**
+ * \brief           create the mutex of sys_arch_protect, called by lwip_init
+ */
+void
+sys_init(void) {
+
+    host_sys_mutex = xSemaphoreCreateMutex();
+    LWIP_ASSERT("sys_init: mutex was not created", host_sys_mutex != NULL);
+}
+
+/**
+ * \brief           time since the scheduler started, in ms. the board has it in ethernetif.c
+ * \param[out]      return: time in ms
+ */
+u32_t
+sys_now(void) {
+
+    return (u32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**
+ * \brief           create a mailbox
+ * \param[out]      mbox: mailbox created
+ * \param[in]       size: number of messages the mailbox holds
+ * \param[out]      return: ERR_OK, ERR_MEM if the mailbox was not created
+ */
+err_t
+sys_mbox_new(sys_mbox_t* mbox, int size) {
+
+    *mbox = xQueueCreate((UBaseType_t)size, sizeof(void*));
+    if (*mbox == NULL) {
+        SYS_STATS_INC(mbox.err);
+        return ERR_MEM;
+    }
+
+    SYS_STATS_INC_USED(mbox);
+    return ERR_OK;
+}
+
+/**
+ * \brief           delete a mailbox
+ * \param[in]       mbox: mailbox
+ */
+void
+sys_mbox_free(sys_mbox_t* mbox) {
+
+    vQueueDelete(*mbox);
+    SYS_STATS_DEC(mbox.used);
+}
+
+/**
+ * \brief           post a message, waits while the mailbox is full
+ * \param[in]       mbox: mailbox
+ * \param[in]       msg: message
+ */
+void
+sys_mbox_post(sys_mbox_t* mbox, void* msg) {
+
+    while (xQueueSendToBack(*mbox, &msg, portMAX_DELAY) != pdTRUE) {}
+}
+
+/**
+ * \brief           post a message if the mailbox is not full
+ * \param[in]       mbox: mailbox
+ * \param[in]       msg: message
+ * \param[out]      return: ERR_OK, ERR_MEM if the mailbox is full
+ */
+err_t
+sys_mbox_trypost(sys_mbox_t* mbox, void* msg) {
+
+    if (xQueueSendToBack(*mbox, &msg, 0) != pdTRUE) {
+        SYS_STATS_INC(mbox.err);
+        return ERR_MEM;
+    }
+
+    return ERR_OK;
+}
+
+/**
+ * \brief           post a message from an interrupt if the mailbox is not full
+ * \param[in]       mbox: mailbox
+ * \param[in]       msg: message
+ * \param[out]      return: ERR_OK, ERR_MEM if the mailbox is full
+ */
+err_t
+sys_mbox_trypost_fromisr(sys_mbox_t* mbox, void* msg) {
+
+    BaseType_t woken = pdFALSE; /* a task waiting on the mailbox was woken */
+
+    if (xQueueSendToBackFromISR(*mbox, &msg, &woken) != pdTRUE) {
+        SYS_STATS_INC(mbox.err);
+        return ERR_MEM;
+    }
+
+    portYIELD_FROM_ISR(woken);
+    return ERR_OK;
+}
+
+/**
+ * \brief           fetch a message, waits for one up to the timeout
+ * \param[in]       mbox: mailbox
+ * \param[out]      msg: message fetched, may be NULL to drop it
+ * \param[in]       timeout: longest wait in ms, 0 waits forever
+ * \param[out]      return: time waited in ms, SYS_ARCH_TIMEOUT if no message came
+ */
+u32_t
+sys_arch_mbox_fetch(sys_mbox_t* mbox, void** msg, u32_t timeout) {
+
+    void* dummy;                                                        /* message dropped */
+    TickType_t start = xTaskGetTickCount();                             /* tick the wait started */
+    TickType_t wait = timeout ? pdMS_TO_TICKS(timeout) : portMAX_DELAY; /* ticks to wait */
+
+    if (msg == NULL) {
+        msg = &dummy;
+    }
+
+    if (xQueueReceive(*mbox, msg, wait) != pdTRUE) {
+        *msg = NULL;
+        return SYS_ARCH_TIMEOUT;
+    }
+
+    return (u32_t)((xTaskGetTickCount() - start) * portTICK_PERIOD_MS);
+}
+
+/**
+ * \brief           fetch a message if there is one
+ * \param[in]       mbox: mailbox
+ * \param[out]      msg: message fetched, may be NULL to drop it
+ * \param[out]      return: 0, SYS_MBOX_EMPTY if the mailbox is empty
+ */
+u32_t
+sys_arch_mbox_tryfetch(sys_mbox_t* mbox, void** msg) {
+
+    void* dummy; /* message dropped */
+
+    if (msg == NULL) {
+        msg = &dummy;
+    }
+
+    if (xQueueReceive(*mbox, msg, 0) != pdTRUE) {
+        *msg = NULL;
+        return SYS_MBOX_EMPTY;
+    }
+
+    return 0;
+}
+
+int
+sys_mbox_valid(sys_mbox_t* mbox) {
+
+    return *mbox != SYS_MBOX_NULL;
+}
+
+void
+sys_mbox_set_invalid(sys_mbox_t* mbox) {
+
+    *mbox = SYS_MBOX_NULL;
+}
+
+/**
+ * \brief           create a semaphore
+ * \param[out]      sem: semaphore created
+ * \param[in]       count: initial count, 0 or 1
+ * \param[out]      return: ERR_OK, ERR_MEM if the semaphore was not created
+ */
+err_t
+sys_sem_new(sys_sem_t* sem, u8_t count) {
+
+    *sem = xSemaphoreCreateBinary();
+    if (*sem == NULL) {
+        SYS_STATS_INC(sem.err);
+        return ERR_MEM;
+    }
+
+    if (count) {
+        xSemaphoreGive(*sem);
+    }
+
+    SYS_STATS_INC_USED(sem);
+    return ERR_OK;
+}
+
+/**
+ * \brief           take a semaphore, waits for it up to the timeout
+ * \param[in]       sem: semaphore
+ * \param[in]       timeout: longest wait in ms, 0 waits forever
+ * \param[out]      return: time waited in ms, SYS_ARCH_TIMEOUT if the semaphore was not given
+ */
+u32_t
+sys_arch_sem_wait(sys_sem_t* sem, u32_t timeout) {
+
+    TickType_t start = xTaskGetTickCount();                             /* tick the wait started */
+    TickType_t wait = timeout ? pdMS_TO_TICKS(timeout) : portMAX_DELAY; /* ticks to wait */
+
+    if (xSemaphoreTake(*sem, wait) != pdTRUE) {
+        return SYS_ARCH_TIMEOUT;
+    }
+
+    return (u32_t)((xTaskGetTickCount() - start) * portTICK_PERIOD_MS);
+}
+
+void
+sys_sem_signal(sys_sem_t* sem) {
+
+    xSemaphoreGive(*sem);
+}
+
+void
+sys_sem_free(sys_sem_t* sem) {
+
+    vSemaphoreDelete(*sem);
+    SYS_STATS_DEC(sem.used);
+}
+
+int
+sys_sem_valid(sys_sem_t* sem) {
+
+    return *sem != SYS_SEM_NULL;
+}
+
+void
+sys_sem_set_invalid(sys_sem_t* sem) {
+
+    *sem = SYS_SEM_NULL;
+}
+
+/**
+ * \brief           create a mutex
+ * \param[out]      mutex: mutex created
+ * \param[out]      return: ERR_OK, ERR_MEM if the mutex was not created
+ */
+err_t
+sys_mutex_new(sys_mutex_t* mutex) {
+
+    *mutex = xSemaphoreCreateMutex();
+    if (*mutex == NULL) {
+        SYS_STATS_INC(mutex.err);
+        return ERR_MEM;
+    }
+
+    SYS_STATS_INC_USED(mutex);
+    return ERR_OK;
+}
+
+void
+sys_mutex_free(sys_mutex_t* mutex) {
+
+    vSemaphoreDelete(*mutex);
+    SYS_STATS_DEC(mutex.used);
+}
+
+void
+sys_mutex_lock(sys_mutex_t* mutex) {
+
+    xSemaphoreTake(*mutex, portMAX_DELAY);
+}
+
+void
+sys_mutex_unlock(sys_mutex_t* mutex) {
+
+    xSemaphoreGive(*mutex);
+}
+
+/**
+ * \brief           create an lwip thread
+ * \note            the lwipopts priorities are cmsis rtos priorities, as on the board
+ * \param[in]       name: thread name
+ * \param[in]       thread: thread function
+ * \param[in]       arg: thread function argument
+ * \param[in]       stacksize: stack size in words
+ * \param[in]       prio: cmsis rtos priority
+ * \param[out]      return: thread created
+ */
+sys_thread_t
+sys_thread_new(const char* name, lwip_thread_fn thread, void* arg, int stacksize, int prio) {
+
+    TaskHandle_t task = NULL; /* thread created */
+
+    xTaskCreate(thread, name, (configSTACK_DEPTH_TYPE)stacksize, arg, (UBaseType_t)(prio - osPriorityIdle), &task);
+    LWIP_ASSERT("sys_thread_new: task was not created", task != NULL);
+
+    return task;
+}
+
+/**
+ * \brief           enter an lwip critical section, a mutex as on the board
+ * \param[out]      return: protection level, not used
+ */
+sys_prot_t
+sys_arch_protect(void) {
+
+    xSemaphoreTake(host_sys_mutex, portMAX_DELAY);
+    return (sys_prot_t)1;
+}
+
+/**
+ * \brief           leave an lwip critical section
+ * \param[in]       pval: protection level, not used
+ */
+void
+sys_arch_unprotect(sys_prot_t pval) {
+
+    (void)pval;
+    xSemaphoreGive(host_sys_mutex);
+}
@@ -0,0 +1,178 @@
+/**
+ * \file            host_tap.c
+ * \brief           tap interface the host build exchanges ethernet frames with the pc on src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include "host_tap.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/if_tun.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * \brief           set an ipv4 address of an interface
+ * \param[in]       sock_fd: any AF_INET socket
+ * \param[in]       ifr: interface request holding the interface name
+ * \param[in]       request: SIOCSIFADDR or SIOCSIFNETMASK
+ * \param[in]       addr: 4 bytes ipv4 address
+ * \param[out]      return: ioctl return
+ */
+static int
+host_tap_set_addr(int sock_fd, struct ifreq* ifr, unsigned long request, const uint8_t* addr) {
+
+    struct sockaddr_in sin; /* address set */
+
+    memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+    memcpy(&sin.sin_addr, addr, sizeof(sin.sin_addr));
+    memcpy(&ifr->ifr_addr, &sin, sizeof(sin));
+
+    return ioctl(sock_fd, request, ifr);
+}
+
+/**
+ * \brief           open a tap interface, give its pc side an address and bring it up
+ * \note            a tap made before with "ip tuntap add" keeps the address and state it was given, when the host
+ *                  firmware is not allowed to set them
+ * \param[in]       name: tap interface name
+ * \param[in]       pc_ip: 4 bytes ipv4 address of the pc side of the tap, on a /24 network
+ * \param[out]      return: tap file descriptor, -1 on an error
+ */
+int
+host_tap_open(const char* name, const uint8_t* pc_ip) {
+
+    const uint8_t netmask[4] = {255, 255, 255, 0}; /* /24 network of the tap */
+    struct ifreq ifr;                              /* interface request */
+    int tap_fd;                                    /* tap file descriptor */
+    int sock_fd;                                   /* socket for the interface address requests */
+
+    tap_fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (tap_fd < 0) {
+        perror("open /dev/net/tun");
+        return -1;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+    strncpy(ifr.ifr_name, name, IFNAMSIZ - 1);
+
+    if (ioctl(tap_fd, TUNSETIFF, &ifr) < 0) {
+        perror("tap TUNSETIFF");
+        close(tap_fd);
+        return -1;
+    }
+
+    sock_fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (sock_fd < 0) {
+        perror("tap socket");
+        close(tap_fd);
+        return -1;
+    }
+
+    if (host_tap_set_addr(sock_fd, &ifr, SIOCSIFADDR, pc_ip) < 0
+        || host_tap_set_addr(sock_fd, &ifr, SIOCSIFNETMASK, netmask) < 0 || ioctl(sock_fd, SIOCGIFFLAGS, &ifr) < 0) {
+
+        printf("tap %s address not set (%s), using the tap as it is\n", ifr.ifr_name, strerror(errno));
+    } else {
+
+        ifr.ifr_flags |= IFF_UP | IFF_RUNNING;
+        if (ioctl(sock_fd, SIOCSIFFLAGS, &ifr) < 0) {
+            printf("tap %s not brought up (%s)\n", ifr.ifr_name, strerror(errno));
+        }
+    }
+
+    close(sock_fd);
+    return tap_fd;
+}
+
+/**
+ * \brief           wait for a frame on the tap
+ * \param[in]       tap_fd: tap file descriptor
+ * \param[in]       timeout_ms: longest wait
+ * \param[out]      return: 1 if a frame is ready, 0 on timeout or a signal, -1 on an error
+ */
+int
+host_tap_wait(int tap_fd, int timeout_ms) {
+
+    struct pollfd tap_poll = {.fd = tap_fd, .events = POLLIN}; /* tap polled */
+    int check;                                                 /* return error check */
+
+    check = poll(&tap_poll, 1, timeout_ms);
+    if (check < 0 && errno == EINTR) {
+        return 0;
+    }
+    return check;
+}
+
+/**
+ * \brief           read a frame from the tap
+ * \param[in]       tap_fd: tap file descriptor
+ * \param[out]      frame: frame read
+ * \param[in]       size: size of frame
+ * \param[out]      return: bytes of the frame, 0 if no frame is ready, -1 on an error
+ */
+int
+host_tap_read(int tap_fd, uint8_t* frame, size_t size) {
+
+    ssize_t len; /* bytes read */
+
+    len = read(tap_fd, frame, size);
+    if (len < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return 0;
+    }
+    return (int)len;
+}
+
+/**
+ * \brief           write a frame to the tap
+ * \param[in]       tap_fd: tap file descriptor
+ * \param[in]       frame: frame written
+ * \param[in]       size: bytes of the frame
+ * \param[out]      return: bytes written, -1 on an error
+ */
+int
+host_tap_write(int tap_fd, const uint8_t* frame, size_t size) {
+
+    ssize_t len; /* bytes written */
+
+    do {
+        len = write(tap_fd, frame, size);
+    } while (len < 0 && errno == EINTR);
+
+    return (int)len;
+}
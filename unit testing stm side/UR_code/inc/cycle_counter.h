@@ -0,0 +1,59 @@
+/**
+ * \file            cycle_counter.h
+ * \brief           core cycle counter, timing the tests on the card include file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#ifndef INC_CYCLE_COUNTER_H_
+#define INC_CYCLE_COUNTER_H_
+
+#include <stdint.h>
+
+/**
+ * \brief           clock of the stub cycle counter, when build with CYCLE_COUNTER_STUB
+ * \hideinitializer
+ */
+#define CYCLE_COUNTER_STUB_HZ 216000000
+
+/**
+ * \brief           clock of the host build cycle counter, it counts ns, when build with UR_HOST
+ * \hideinitializer
+ */
+#define CYCLE_COUNTER_HOST_HZ 1000000000
+
+#ifdef CYCLE_COUNTER_STUB
+extern volatile uint32_t cycle_counter_stub;
+#endif
+
+void cycle_counter_init(void);
+uint32_t cycle_counter_read(void);
+uint32_t cycle_counter_clock_hz(void);
+
+#endif /* INC_CYCLE_COUNTER_H_ */
@@ -36,15 +36,18 @@
 
 #include "main.h"
 //#include "stm32f7xx_hal.h"
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "FreeRTOS.h"
 #include "inet.h"
 #include "lwip.h"
+#include "queue.h"
 #include "semphr.h"
 #include "task.h"
 #include "udp.h"
+#include "cycle_counter.h"
 
 void app_data_init_task(void* arg);
 
@@ -68,10 +71,16 @@ err_t send_packet(struct udp_pcb* pcb, const void* payload, u16_t payload_len, c
 #define TEST_NAME_SIZE           100
 
 /**
- * \brief    test data buff size      
+ * \brief    biggest test data size, a test request still fits in one ethernet mtu
  * \hideinitializer
  */
-#define MAX_BUF_LEN              100
+#define MAX_BUF_LEN              1400
+
+/**
+ * \brief    smallest test data size
+ * \hideinitializer
+ */
+#define MIN_BUF_LEN              1
 
 /**
  * \brief          test's first port increment for each task 
@@ -91,6 +100,12 @@ err_t send_packet(struct udp_pcb* pcb, const void* payload, u16_t payload_len, c
  */
 #define TEST_RUNNING             1
 
+/**
+ * \brief           number of test requests queued for a testing task while it runs a test
+ * \hideinitializer
+ */
+#define TEST_REQUEST_QUEUE_SIZE  4
+
 /**
  * \brief                    app initialisation task port
  * \hideinitializer
@@ -115,6 +130,12 @@ err_t send_packet(struct udp_pcb* pcb, const void* payload, u16_t payload_len, c
  */
 #define ID_SIZE                  3
 
+/**
+ * \brief                     size of the firmware build string of the card hello
+ * \hideinitializer
+ */
+#define FIRMWARE_BUILD_SIZE      32
+
 /**
  * \brief                     request board uniq id
  * \hideinitializer
@@ -133,6 +154,66 @@ err_t send_packet(struct udp_pcb* pcb, const void* payload, u16_t payload_len, c
  */
 #define LIST_MEMBER_REQUEST      2
 
+/**
+ * \brief                      request as many test list members as fit in one datagram, from list_index on
+ * \hideinitializer
+ */
+#define LIST_BULK_REQUEST        3
+
+/**
+ * \brief                      test list members sent in one LIST_BULK_REQUEST reply,
+ *                             as many as fit in an ethernet mtu (1472 bytes of udp payload)
+ * \hideinitializer
+ */
+#define LIST_BULK_MAX_MEMBERS    14
+
+/**
+ * \brief                      request card id, list sizes, protocol version and capabilities in one reply
+ * \hideinitializer
+ */
+#define HELLO_REQUEST            4
+
+/**
+ * \brief                      version of the unit test protocol, sent in the hello reply.
+ *                             incremented on every change of the protocol structs
+ * \hideinitializer
+ */
+#define PROTOCOL_VERSION         8
+
+/**
+ * \brief                      firmware build sent in the hello reply, the pc results history tells the builds apart
+ *                             by it. give the compiler -DFIRMWARE_BUILD=\"<version control revision>\", the build
+ *                             time is sent otherwise. up to FIRMWARE_BUILD_SIZE characters are sent
+ * \hideinitializer
+ */
+#ifndef FIRMWARE_BUILD
+#define FIRMWARE_BUILD           __DATE__ " " __TIME__
+#endif
+
+/**
+ * \brief                      hello feature, the card answers LIST_BULK_REQUEST
+ * \hideinitializer
+ */
+#define FEATURE_LIST_BULK        0x01
+
+/**
+ * \brief                      hello feature, the card sends back the test request sequence number
+ * \hideinitializer
+ */
+#define FEATURE_SEQUENCE         0x02
+
+/**
+ * \brief                      hello feature, the card queues test requests sent while a test is running
+ * \hideinitializer
+ */
+#define FEATURE_REQUEST_QUEUE    0x04
+
+/**
+ * \brief                      hello feature, the card times the tests with its cycle counter
+ * \hideinitializer
+ */
+#define FEATURE_CYCLE_COUNT      0x08
+
 /**
  * \brief                      sizeof error message
  * \hideinitializer
@@ -162,6 +243,46 @@ err_t send_packet(struct udp_pcb* pcb, const void* payload, u16_t payload_len, c
  * \hideinitializer
  */
 #define ADC_CRITERIA             1
+
+/**
+ * \brief                     dac to adc linearity sweep evaluation criteria, the test data is a sweep_request_t
+ *                            followed by the sums of the adc codes the card converted
+ * \hideinitializer
+ */
+#define LINEARITY_CRITERIA       2
+
+/**
+ * \brief                     frame bus evaluation criteria, the test data is compared like a COMMUNICATION_CRITERIA
+ *                            test and the reply carries the bus statistics of the frames that moved it
+ * \hideinitializer
+ */
+#define BUS_CRITERIA             3
+
+/**
+ * \brief                     stream evaluation criteria, the card streams the test data over its peripheral pair for
+ *                            the stream time of the test, checks it as it comes in and replies the stream statistics
+ * \hideinitializer
+ */
+#define STREAM_CRITERIA          4
+
+/**
+ * \brief                     most adc samples the card sums at each dac code of a sweep, the sum fits 16 bits
+ * \hideinitializer
+ */
+#define SWEEP_MAX_AVERAGE        16
+
+/**
+ * \brief                     bytes of one analog sample in the test data of an ADC_CRITERIA test,
+ *                            a little endian dac code sent and the adc code sent back in its place
+ * \hideinitializer
+ */
+#define ADC_SAMPLE_SIZE          2
+
+/**
+ * \brief                     biggest 12 bit dac and adc code
+ * \hideinitializer
+ */
+#define ADC_CODE_MAX             4095
 /**
  * \brief                     app_data_init_task stack size
  * \hideinitializer
@@ -206,7 +327,8 @@ typedef enum error_report {
     NO_ERROR,         /*!< report stm do not see e problem with test */
     HAL_RETURN_ERROR, /*!< report cimsis peripheral function return error */
     ERROR_IT,         /*!< report error interrupt has jump   */
-    OVER_TIME         /*!< report waited to long for peripheral to resume action */
+    OVER_TIME,        /*!< report waited to long for peripheral to resume action */
+    MISMATCH          /*!< report the card found the data received different from the data sent */
 
 } error_report_t;
 
@@ -219,8 +341,55 @@ typedef enum main_error_report {
     SEMAPHORE_CREATE_FAILED,        /*!< failed to create a semaphore  */
     TASK_CREATE_FAILED,             /*!< faild to create a task  */
     UDP_SEND_FAILED,                /*!< failed to send udp package  */
+    QUEUE_CREATE_FAILED,            /*!< failed to create a queue  */
 } main_error_report_t;
 
+/**
+ * \brief           phases of a test the card may time, relative to the start of the test function
+ */
+typedef enum test_phase {
+
+    TEST_PHASE_TX_START,  /*!< the test started the peripheral transfer */
+    TEST_PHASE_RX_DONE,   /*!< the receive complete interrupt */
+    TEST_PHASE_TASK_WAKE, /*!< the test task woke up after the interrupt */
+    TEST_PHASE_NUM        /*!< number of phases */
+
+} test_phase_t;
+
+/**
+ * \brief           statistics of the frames that moved the test data of a BUS_CRITERIA test, 0 for other tests
+ */
+#pragma pack(push, 1)
+
+typedef struct bus_stats {
+
+    uint16_t frames;      /*!< frames received */
+    uint32_t bus_bits;    /*!< bits the frames took on the bus, with the stuff bits and the interframe space */
+    uint32_t bus_time;    /*!< bit times from the start of the first frame to the end of the last frame */
+    uint32_t bitrate;     /*!< bus bits per second */
+    uint32_t latency_sum; /*!< sum of the card cycles from queuing each frame to receiving it */
+    uint32_t latency_max; /*!< most card cycles from queuing a frame to receiving it */
+
+} bus_stats_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           statistics of the data streamed by a STREAM_CRITERIA test, 0 for other tests
+ */
+#pragma pack(push, 1)
+
+typedef struct stream_stats {
+
+    uint32_t bytes;         /*!< bytes received and checked */
+    uint32_t bit_errors;    /*!< bits received different from the bits sent */
+    uint32_t error_blocks;  /*!< blocks checked with a bit error, a block is half the circular buffer or a transfer */
+    uint32_t stream_cycles; /*!< card cycles from the stream start to the last block checked */
+
+} stream_stats_t;
+
+#pragma pack(pop)
+
 /**
  * \brief           unit testing testing communication protocol struct
  */
@@ -228,19 +397,61 @@ typedef enum main_error_report {
 
 typedef struct uint_tasting_package {
 
-    uint32_t id[ID_SIZE];      /*!< holds stm mcu uniq id */
-    uint8_t request;           /*!< holds app request what test in a task belong to a particular port to run. */
-    uint8_t data[MAX_BUF_LEN]; /*!< data for testing */
-    uint8_t error_report;      /*!< stm32 fill this variable with report about transmission errors */
+    uint32_t id[ID_SIZE];                  /*!< holds stm mcu uniq id */
+    uint8_t request;                       /*!< holds app request what test in a task belong to a particular port
+                                                to run. */
+    uint16_t sequence;                     /*!< app request number, sent back by the card to match the reply */
+    uint8_t error_report;                  /*!< stm32 fill this variable with report about transmission errors */
+    uint16_t data_len;                     /*!< number of data bytes used, only they are sent */
+    uint32_t test_cycles;                  /*!< card cycles the test function ran, filled by the card */
+    uint32_t phase_cycles[TEST_PHASE_NUM]; /*!< card cycles from the test start to each phase the test marked,
+                                                0 if not marked */
+    bus_stats_t bus;                       /*!< bus statistics of a BUS_CRITERIA test, filled by the card */
+    stream_stats_t stream;                 /*!< stream statistics of a STREAM_CRITERIA test, filled by the card */
+    uint8_t data[MAX_BUF_LEN];             /*!< data for testing */
 
 } unit_tasting_package_t;
 
 #pragma pack(pop)
 
+/**
+ * \brief           first bytes of the test data of a LINEARITY_CRITERIA test, one chunk of a dac sweep
+ * \note            the card sets the dac to each code of the chunk, and sums "average" samples of each of the
+ *                  adc_num adcs. the sums follow the header as uint16_t, code after code and adc after adc
+ */
+#pragma pack(push, 1)
+
+typedef struct sweep_request {
+
+    uint16_t first_code; /*!< first dac code of the chunk */
+    uint16_t step;       /*!< dac codes between the codes of the chunk */
+    uint16_t code_num;   /*!< number of dac codes of the chunk */
+    uint8_t average;     /*!< adc samples summed at each dac code, up to SWEEP_MAX_AVERAGE */
+    uint8_t adc_num;     /*!< adcs converting each dac code */
+
+} sweep_request_t;
+
+#pragma pack(pop)
+
+/**
+ * \brief           mark a phase of the running test with the cycle counter, from the test function or its isr
+ * \param[in]       pocket: the test request being run, "&stm_test_list_array[task].taskX_pack.pocket"
+ * \param[in]       phase: test_phase_t value
+ * \hideinitializer
+ */
+#define TEST_PHASE_MARK(pocket, phase) ((pocket)->phase_cycles[(phase)] = cycle_counter_read())
+
+/**
+ * \brief          size of a test request without its data, the datagram size is this plus data_len
+ * \hideinitializer
+ */
+#define TEST_PACKAGE_HEADER_SIZE offsetof(unit_tasting_package_t, data)
+
 /**
  * \brief           holds udp pocket send to the port of the task  
- * \note            each task have a struct like this and the udp receive callback according to the 
- *                  destination port fill the struct of the port task 
+ * \note            the udp receive callback copies each pocket, according to the destination port,
+ *                  to the request queue of the port task. the pbuf is freed at once, so queued requests
+ *                  do not hold the ethernet receive buffers
  *                      
  */
 typedef struct task_package {
@@ -248,7 +459,7 @@ typedef struct task_package {
     ip_addr_t dst_ip_addr; /*!< ip address of sender */
     u16_t dst_port;        /*!< port of sender */
 
-    struct pbuf* p; /*!< sender received pocket */
+    unit_tasting_package_t pocket; /*!< sender received pocket */
 
 } task_package_t;
 
@@ -262,7 +473,8 @@ typedef struct test_func {
     void (*task_ptr)(uint8_t*, uint16_t, SemaphoreHandle_t*, uint8_t,
                      uint8_t*);            /*!< holds thread test function address written by the developer */
     SemaphoreHandle_t q;                   /*!< hold thread semaphore */
-    task_package_t taskX_pack;             /*!< except sender package */
+    QueueHandle_t request_queue;           /*!< test requests waiting for the task, filled by udp_receive_callback */
+    task_package_t taskX_pack;             /*!< except sender package, the test request being run */
     uint8_t test_complete_flag;            /*!< signal flag if test has finish execution  */
     struct udp_pcb* pcb_and_port_for_test; /*!< udp pcb with a port number for the specific task  */
 
@@ -281,10 +493,27 @@ typedef struct linux_app_test_setting {
     uint8_t results_evaluation_criteria; /*!< how to masseur the test successes */
     uint8_t pulling_or_it;               /*!< telling pc if test is in pulling mode(run separately)
                                           or it mode(run simultaneously) for accurate timing */
+    uint16_t payload_size;               /*!< test data size, MIN_BUF_LEN up to MAX_BUF_LEN */
 } linux_app_test_setting_t;
 
 #pragma pack(pop)
 
+/**
+ * \brief           reply to LIST_BULK_REQUEST, a chunk of the test list
+ * \note            only member_num members are sent, bigger lists are read chunk after chunk
+ */
+#pragma pack(push, 1)
+
+typedef struct list_bulk_reply {
+
+    uint16_t first_index;                                        /*!< list index of the first member sent */
+    uint8_t member_num;                                          /*!< number of members sent */
+    linux_app_test_setting_t member_list[LIST_BULK_MAX_MEMBERS]; /*!< test list members */
+
+} list_bulk_reply_t;
+
+#pragma pack(pop)
+
 /**
  * \brief           unit test system. app test initialisation communication  protocol struct
  * \note            app get from the card, card information and tests information
@@ -315,6 +544,30 @@ typedef struct card_name_and_id {
 
 #pragma pack(pop)
 
+/**
+ * \brief            reply to HELLO_REQUEST. everything the app needs before testing, in one round trip
+ */
+#pragma pack(push, 1)
+
+typedef struct card_hello {
+
+    card_name_and_id_t card;                  /*!< card name and uniq id */
+    uint16_t protocol_version;                /*!< PROTOCOL_VERSION of the card */
+    uint16_t pc_test_list_size;               /*!< number of tests */
+    uint16_t test_list_size;                  /*!< number of testing tasks */
+    uint16_t min_payload_size;                /*!< smallest test data size the card tests */
+    uint16_t max_payload_size;                /*!< biggest test data size the card tests */
+    uint8_t request_queue_size;               /*!< test requests the card queues for each task while a test is
+                                                   running */
+    uint32_t features;                        /*!< FEATURE_ flags of the card */
+    uint32_t cycle_clock_hz;                  /*!< clock of the card cycle counter, test_cycles / cycle_clock_hz is
+                                                   the time */
+    char firmware_build[FIRMWARE_BUILD_SIZE]; /*!< firmware build of the card, may not end with '\0' */
+
+} card_hello_t;
+
+#pragma pack(pop)
+
 void testing_thread(void const* arg);
 
 #endif /* INC_MAIN_UR_H_ */
@@ -0,0 +1,149 @@
+/**
+ * \file            cycle_counter.c
+ * \brief           core cycle counter, timing the tests on the card src file
+ */
+
+/*
+ * Copyright (c) 10/17/2026 Uri Fridman
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of library_name.
+ *
+ * Author:          Uri Fridman <optional_email@example.com>
+ */
+
+#include "cycle_counter.h"
+
+#ifdef CYCLE_COUNTER_STUB
+
+/**
+ * \brief           stub cycle counter value, set by host tests in place of the DWT cycle counter
+ */
+volatile uint32_t cycle_counter_stub;
+
+/**
+ * \brief           start the stub cycle counter from 0
+ */
+void
+cycle_counter_init(void) {
+
+    cycle_counter_stub = 0;
+}
+
+/**
+ * \brief           read the stub cycle counter
+ * \param[out]      return: stub counter value
+ */
+uint32_t
+cycle_counter_read(void) {
+
+    return cycle_counter_stub;
+}
+
+/**
+ * \brief           clock the stub cycle counter counts in
+ * \param[out]      return: clock in hz
+ */
+uint32_t
+cycle_counter_clock_hz(void) {
+
+    return CYCLE_COUNTER_STUB_HZ;
+}
+
+#elif defined(UR_HOST)
+
+#include <time.h>
+
+/**
+ * \brief           host build cycle counter, the monotonic clock in ns
+ */
+void
+cycle_counter_init(void) {
+
+    /* the monotonic clock runs from the host boot, nothing to start */
+}
+
+/**
+ * \brief           read the host cycle counter
+ * \param[out]      return: monotonic clock in ns, wrapping every 2^32 ns, about 4.3 s
+ */
+uint32_t
+cycle_counter_read(void) {
+
+    struct timespec now; /* monotonic clock */
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec);
+}
+
+/**
+ * \brief           clock the host cycle counter counts in
+ * \param[out]      return: clock in hz
+ */
+uint32_t
+cycle_counter_clock_hz(void) {
+
+    return CYCLE_COUNTER_HOST_HZ;
+}
+
+#else
+
+#include "main.h"
+
+/**
+ * \brief           enable the cortex-m7 DWT cycle counter and start it from 0
+ * \note            the counter counts core clock cycles and wraps every 2^32 cycles, about 19 s at 216 MHz
+ */
+void
+cycle_counter_init(void) {
+
+    /* enable trace, the DWT unit is powered only with trace enabled */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    /* unlock the DWT registers, cortex-m7 locks them after reset */
+    DWT->LAR = 0xC5ACCE55;
+
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * \brief           read the DWT cycle counter
+ * \param[out]      return: core clock cycles since cycle_counter_init, wrapping
+ */
+uint32_t
+cycle_counter_read(void) {
+
+    return DWT->CYCCNT;
+}
+
+/**
+ * \brief           clock the DWT cycle counter counts in
+ * \param[out]      return: core clock in hz
+ */
+uint32_t
+cycle_counter_clock_hz(void) {
+
+    return SystemCoreClock;
+}
+
+#endif /* CYCLE_COUNTER_STUB, UR_HOST */
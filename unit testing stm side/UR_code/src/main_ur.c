@@ -69,6 +69,9 @@ ur_main() {
 
     BaseType_t err;
 
+    /* start the cycle counter timing the tests */
+    cycle_counter_init();
+
     /* creating semaphores for each testing task  */
     for (int i = 0; i < test_list_size; i++) {
 
@@ -79,6 +82,16 @@ ur_main() {
         }
     }
 
+    /* creating test request queues for each testing task  */
+    for (int i = 0; i < test_list_size; i++) {
+
+        stm_test_list_array[i].request_queue = xQueueCreate(TEST_REQUEST_QUEUE_SIZE, sizeof(task_package_t));
+
+        if (stm_test_list_array[i].request_queue == NULL) {
+            exit(QUEUE_CREATE_FAILED);
+        }
+    }
+
     /* creating semaphore for "app_data_init_task" */
     app_init_sem = xSemaphoreCreateBinary();
 
@@ -45,8 +45,9 @@
 void
 udp_receive_callback(void* arg, struct udp_pcb* upcb, struct pbuf* p, const ip_addr_t* addr, u16_t port) {
 
-    unit_tasting_package_t* payload_cast; /* for casting the payload to "unit_tasting_package_t" */
-    uint16_t tast_type;                   /* destination port  */
+    static task_package_t request; /* test request copied from the pocket, static to spare the tcpip thread stack */
+    uint16_t tast_type;            /* destination port  */
+    u16_t request_len;             /* size of the received test request */
 
     /* check if pocket is sent to "app_data_init_task"  and if so directing the payload to task */
     if (upcb->local_port == APP_INIT_PORT) {
@@ -66,35 +67,38 @@ udp_receive_callback(void* arg, struct udp_pcb* upcb, struct pbuf* p, const ip_a
         return;
     } else {
 
-        payload_cast = p->payload; /* cast the payload to  unit_tasting_package_t pointer */
         tast_type = upcb->local_port
                     - SERVER_OFFSET_PORT; /* compute and store the task receiving the pocket by the dentation port */
 
-        /* check if the id sent matches the card id */
-        if (memcmp(payload_cast->id, this_card_name_and_id.id, ID_SIZE * sizeof(uint32_t)) != 0) {
-
+        /* check the pocket size and the task */
+        if (p->tot_len < TEST_PACKAGE_HEADER_SIZE || p->tot_len > sizeof(unit_tasting_package_t)
+            || tast_type >= test_list_size) {
+            /* Drop the packet */
             pbuf_free(p);
             return;
         }
 
-        /* Check if we finished with the last packet */
-        if (p->len > sizeof(unit_tasting_package_t) || stm_test_list_array[tast_type].test_complete_flag == TEST_RUNNING
-            || tast_type >= test_list_size) {
-            /* Drop the packet */
-            pbuf_free(p);
+        /* copy the pocket, a test request may wait in the queue while the task runs a test */
+        request_len = p->tot_len;
+        pbuf_copy_partial(p, &request.pocket, request_len, 0);
+        pbuf_free(p);
+
+        /* check the data length sent matches the pocket size */
+        if (request.pocket.data_len < MIN_BUF_LEN || request_len != TEST_PACKAGE_HEADER_SIZE + request.pocket.data_len) {
             return;
         }
 
-        /* Store the sender information in data structors belonging to the receiving task */
-        ip_addr_copy(stm_test_list_array[tast_type].taskX_pack.dst_ip_addr, *addr);
-        stm_test_list_array[tast_type].taskX_pack.dst_port = port;
-        stm_test_list_array[tast_type].taskX_pack.p = p;
+        /* check if the id sent matches the card id */
+        if (memcmp(request.pocket.id, this_card_name_and_id.id, ID_SIZE * sizeof(uint32_t)) != 0) {
+            return;
+        }
 
-        /* set the tasks test_complete_flag to test running */
-        stm_test_list_array[tast_type].test_complete_flag = TEST_RUNNING;
+        /* Store the sender information with the request */
+        ip_addr_copy(request.dst_ip_addr, *addr);
+        request.dst_port = port;
 
-        /* start the task */
-        xSemaphoreGive(stm_test_list_array[tast_type].q);
+        /* queue the request and start the task if it is waiting. the request is dropped if the queue is full */
+        xQueueSend(stm_test_list_array[tast_type].request_queue, &request, 0);
     }
 }
 
@@ -61,7 +61,9 @@ begin_task(void const* arg) {
 void
 app_data_init_task(void* arg) {
 
-    err_t check; /* error return check */
+    err_t check;                         /* error return check */
+    static list_bulk_reply_t bulk_reply; /* test list chunk sent on LIST_BULK_REQUEST, static to spare task stack */
+    static card_hello_t hello;           /* card information and capabilities sent on HELLO_REQUEST */
 
     for (;;) {
 
@@ -83,6 +85,31 @@ app_data_init_task(void* arg) {
 
             continue;
         }
+
+        /* if the sender asking for card name, uniq id, list sizes and capabilities in one reply */
+        if (app_commend.type == HELLO_REQUEST) {
+
+            hello.card = this_card_name_and_id;
+            hello.protocol_version = PROTOCOL_VERSION;
+            hello.pc_test_list_size = pc_test_list_size;
+            hello.test_list_size = test_list_size;
+            hello.min_payload_size = MIN_BUF_LEN;
+            hello.max_payload_size = MAX_BUF_LEN;
+            hello.request_queue_size = TEST_REQUEST_QUEUE_SIZE;
+            hello.features = FEATURE_LIST_BULK | FEATURE_SEQUENCE | FEATURE_REQUEST_QUEUE | FEATURE_CYCLE_COUNT;
+            hello.cycle_clock_hz = cycle_counter_clock_hz();
+            strncpy(hello.firmware_build, FIRMWARE_BUILD, sizeof(hello.firmware_build));
+
+            check = send_packet(app_port, &hello, sizeof(hello), &app_sender_ip, app_sender_port);
+
+            if (check != ERR_OK) {
+
+                exit(UDP_SEND_FAILED);
+            }
+
+            continue;
+        }
+
         /* check if the id sent matches the card id */
         if (memcmp(app_commend.id, this_card_name_and_id.id, ID_SIZE * sizeof(uint32_t)) != 0) {
 
@@ -117,6 +144,34 @@ app_data_init_task(void* arg) {
                     exit(UDP_SEND_FAILED);
                 }
                 break;
+
+                /* if requesting a chunk of the test list */
+            case LIST_BULK_REQUEST:
+
+                bulk_reply.first_index = app_commend.list_index;
+                bulk_reply.member_num = 0;
+
+                /* copy as many test list members as fit in one datagram, starting from the requested member */
+                while (bulk_reply.member_num < LIST_BULK_MAX_MEMBERS
+                       && app_commend.list_index + bulk_reply.member_num < pc_test_list_size) {
+
+                    memcpy(&bulk_reply.member_list[bulk_reply.member_num],
+                           &pc_test_list_array[app_commend.list_index + bulk_reply.member_num],
+                           sizeof(linux_app_test_setting_t));
+                    bulk_reply.member_num++;
+                }
+
+                /* send only the members copied */
+                check = send_packet(app_port, &bulk_reply,
+                                    offsetof(list_bulk_reply_t, member_list)
+                                        + bulk_reply.member_num * sizeof(linux_app_test_setting_t),
+                                    &app_sender_ip, app_sender_port);
+
+                if (check != ERR_OK) {
+
+                    exit(UDP_SEND_FAILED);
+                }
+                break;
         }
     }
 }
@@ -134,34 +189,50 @@ testing_thread(void const* arg) {
 
     err_t check;                                    /* error return check */
     test_func_t* thread_packeg = (test_func_t*)arg; /* for casting arg into a test_func_t pointer */
-    unit_tasting_package_t* uint_test_cast; /* for casting the received payload address to unit_tasting_package_t */
-    uint8_t* data;                          /* will point to data for testing */
+    unit_tasting_package_t* uint_test_cast;         /* the test request being run */
+    uint32_t start_cycles;                          /* cycle counter at the start of the test function */
 
     for (;;) {
 
-        /* semaphore will be released and received pocket will be directed from  udp_receive_callback when a pocket is sent to the udp_pcb port belonging to that task*/
-        if (xSemaphoreTake(thread_packeg->q, portMAX_DELAY) == pdFALSE) {
+        /* udp_receive_callback queues the pockets sent to the udp_pcb port belonging to that task.
+           requests sent while a test is running waite in the queue, so the task runs them one after the other */
+        if (xQueueReceive(thread_packeg->request_queue, &thread_packeg->taskX_pack, portMAX_DELAY) == pdFALSE) {
             continue;
         }
 
-        uint_test_cast = thread_packeg->taskX_pack.p->payload;
-        data = uint_test_cast->data;
-        /* peripheral   tx to rx call the developer written, test function */
-        thread_packeg->task_ptr(data, MAX_BUF_LEN, &thread_packeg->q, uint_test_cast->request,
-                                &uint_test_cast->error_report);
+        thread_packeg->test_complete_flag = TEST_RUNNING;
+
+        uint_test_cast = &thread_packeg->taskX_pack.pocket;
+        memset(uint_test_cast->phase_cycles, 0, sizeof(uint_test_cast->phase_cycles));
+        memset(&uint_test_cast->bus, 0, sizeof(uint_test_cast->bus));
+        memset(&uint_test_cast->stream, 0, sizeof(uint_test_cast->stream));
+
+        /* peripheral   tx to rx call the developer written, test function, with the data length of the request.
+           the cycle counter times the test function alone, without the network and the request queue */
+        start_cycles = cycle_counter_read();
+        thread_packeg->task_ptr(uint_test_cast->data, uint_test_cast->data_len, &thread_packeg->q,
+                                uint_test_cast->request, &uint_test_cast->error_report);
+        uint_test_cast->test_cycles = cycle_counter_read() - start_cycles;
+
+        /* phases marked by the test hold the cycle counter, send them relative to the start of the test */
+        for (uint8_t i = 0; i < TEST_PHASE_NUM; i++) {
+
+            if (uint_test_cast->phase_cycles[i] != 0) {
+                uint_test_cast->phase_cycles[i] -= start_cycles;
+            }
+        }
 
-        /* send back the data to pc after being tested */
-        check = udp_sendto(thread_packeg->pcb_and_port_for_test, thread_packeg->taskX_pack.p,
-                           &thread_packeg->taskX_pack.dst_ip_addr, thread_packeg->taskX_pack.dst_port);
+        /* send back the data to pc after being tested, the sequence number is sent back unchanged */
+        check = send_packet(thread_packeg->pcb_and_port_for_test, uint_test_cast,
+                            TEST_PACKAGE_HEADER_SIZE + uint_test_cast->data_len,
+                            &thread_packeg->taskX_pack.dst_ip_addr, thread_packeg->taskX_pack.dst_port);
 
         if (check != ERR_OK) {
 
             exit(UDP_SEND_FAILED);
         }
-        /* free pbuf received ofter being sent */
-        pbuf_free(thread_packeg->taskX_pack.p);
 
-        /* indicate to  udp_receive_callback that task is finished  */
+        /* indicate that task is finished  */
         thread_packeg->test_complete_flag = TEST_COMPLETE;
     }
 }